@@ -0,0 +1,96 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures CRC-64/NVME throughput of the byte-at-a-time table loop, the
+// slice-by-8 tables and the kernel utils::Crc64Nvme dispatches to on this
+// CPU, over one buffer of random bytes. Runs offline.
+//
+// Usage: Crc64Benchmark [buffer-bytes] [iterations]
+
+#include <miniocpp/utils.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+// Bytewise is the single-table loop utils::Crc64Nvme used before it was
+// vectorized.
+uint64_t Bytewise(const char* data, size_t len) {
+  static const std::array<uint64_t, 256> table = []() {
+    std::array<uint64_t, 256> t{};
+    for (uint64_t i = 0; i < 256; ++i) {
+      uint64_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0x9a6c9329ac4bc9b5ULL : crc >> 1;
+      }
+      t[i] = crc;
+    }
+    return t;
+  }();
+  uint64_t crc = ~0ULL;
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < len; ++i) {
+    crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t size = 64 * 1024 * 1024;
+  size_t iterations = 10;
+  if (argc > 1) size = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) iterations = std::strtoul(argv[2], nullptr, 10);
+
+  std::string buf(size, '\0');
+  std::mt19937_64 rng(42);
+  for (auto& c : buf) c = static_cast<char>(rng());
+
+  using Clock = std::chrono::steady_clock;
+  uint64_t expected = Bytewise(buf.data(), buf.size());
+  auto run = [&](const std::string& name,
+                 const std::function<uint64_t(const char*, size_t)>& crc) {
+    uint64_t value = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      value = crc(buf.data(), buf.size());
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << name << ": "
+              << static_cast<double>(size * iterations) / secs / 1e9
+              << " GB/s" << (value == expected ? "" : " (MISMATCH)")
+              << std::endl;
+    return value == expected;
+  };
+
+  bool ok = run("bytewise", Bytewise);
+  ok &= run("slice-by-8", [](const char* data, size_t len) {
+    return minio::utils::Crc64NvmePortable(data, len);
+  });
+  ok &= run(minio::utils::Crc64NvmeKernel(), [](const char* data, size_t len) {
+    return minio::utils::Crc64Nvme(data, len);
+  });
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
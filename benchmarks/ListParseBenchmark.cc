@@ -0,0 +1,206 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures items per second and heap bytes per item held by a parsed
+// ListObjectsV2 page, comparing a pugixml DOM queried by XPath into a list of
+// Response-derived items, as ListObjectsResponse::ParseXML did before, with
+// the current streaming parse into a vector of views over the page. Runs
+// offline. Built without pugixml, only the streaming parse is measured.
+//
+// Usage: ListParseBenchmark [keys-per-page] [iterations]
+
+#include <miniocpp/response.h>
+#include <miniocpp/utils.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+#ifdef MINIO_CPP_HAS_PUGIXML
+#include <pugixml.hpp>
+#endif
+
+namespace {
+
+std::atomic<size_t> live_bytes{0};
+
+// Allocate prefixes each block with its size so that live_bytes can be kept.
+void* Allocate(size_t size) {
+  auto block = static_cast<size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+  if (block == nullptr) return nullptr;
+  *block = size;
+  live_bytes += size;
+  return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void Deallocate(void* ptr) {
+  if (ptr == nullptr) return;
+  auto block = reinterpret_cast<size_t*>(static_cast<char*>(ptr) -
+                                         sizeof(std::max_align_t));
+  live_bytes -= *block;
+  std::free(block);
+}
+
+#ifdef MINIO_CPP_HAS_PUGIXML
+// OldItem is the list entry as it was before it became a plain value.
+struct OldItem : public minio::s3::Response {
+  std::string_view etag;
+  std::string_view name;
+  minio::utils::UtcTime last_modified;
+  std::string_view owner_id;
+  std::string_view owner_name;
+  size_t size = 0;
+  std::string_view storage_class;
+  bool is_latest = false;
+  std::string_view version_id;
+  std::map<std::string, std::string> user_metadata;
+  bool is_prefix = false;
+  bool is_delete_marker = false;
+  std::string_view encoding_type;
+};
+
+struct OldPage {
+  std::shared_ptr<pugi::xml_document> doc;
+  std::list<std::string> owned;
+  std::list<OldItem> contents;
+};
+
+// ParseDom is the Contents part of the former XPath based parse.
+OldPage ParseDom(const std::string& data) {
+  OldPage page;
+  page.doc = std::make_shared<pugi::xml_document>();
+  page.doc->load_buffer(data.data(), data.size());
+  auto root = page.doc->select_node("/ListBucketResult");
+  for (auto content : root.node().select_nodes("Contents")) {
+    OldItem item;
+    auto text = content.node().select_node("ETag/text()");
+    page.owned.emplace_back(minio::utils::Trim(text.node().value(), '"'));
+    item.etag = page.owned.back();
+    text = content.node().select_node("Key/text()");
+    item.name = text.node().value();
+    text = content.node().select_node("LastModified/text()");
+    std::string value = text.node().value();
+    item.last_modified = minio::utils::UtcTime::FromISO8601UTC(value.c_str());
+    text = content.node().select_node("Owner/ID/text()");
+    item.owner_id = text.node().value();
+    text = content.node().select_node("Owner/DisplayName/text()");
+    item.owner_name = text.node().value();
+    text = content.node().select_node("Size/text()");
+    value = text.node().value();
+    if (!value.empty()) item.size = static_cast<size_t>(std::stoull(value));
+    text = content.node().select_node("StorageClass/text()");
+    item.storage_class = text.node().value();
+    page.contents.push_back(item);
+  }
+  return page;
+}
+#endif
+
+std::string MakePage(size_t keys) {
+  std::string page =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ListBucketResult "
+      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\"><Name>bucket</Name>"
+      "<Prefix></Prefix><KeyCount>" +
+      std::to_string(keys) + "</KeyCount><MaxKeys>" + std::to_string(keys) +
+      "</MaxKeys><Delimiter></Delimiter><IsTruncated>true</IsTruncated>";
+  for (size_t i = 0; i < keys; ++i) {
+    page += "<Contents><Key>logs/2024/01/02/host-" + std::to_string(i % 97) +
+            "/part-" + std::to_string(i) +
+            ".json.gz</Key><LastModified>2024-01-02T03:04:05.678Z"
+            "</LastModified><ETag>&quot;d41d8cd98f00b204e9800998ecf8427e"
+            "&quot;</ETag><Size>" +
+            std::to_string(i * 1031) +
+            "</Size><Owner><ID>02d6176db174dc93cb1b899f7c6078f08654445fe8cf"
+            "1b6ce98d8855f66bdbf4</ID><DisplayName>minio</DisplayName>"
+            "</Owner><StorageClass>STANDARD</StorageClass></Contents>";
+  }
+  page += "<NextContinuationToken>token</NextContinuationToken>"
+          "</ListBucketResult>";
+  return page;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  if (void* ptr = Allocate(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { Deallocate(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { Deallocate(ptr); }
+
+int main(int argc, char* argv[]) {
+  size_t keys = 1000;
+  size_t iterations = 200;
+  if (argc > 1) keys = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) iterations = std::strtoul(argv[2], nullptr, 10);
+
+  const std::string data = MakePage(keys);
+  using Clock = std::chrono::steady_clock;
+  auto report = [&](const char* name, Clock::duration elapsed, size_t items,
+                    size_t bytes) {
+    double secs = std::chrono::duration<double>(elapsed).count();
+    std::cout << name << ": "
+              << static_cast<double>(items * iterations) / secs
+              << " items/s, "
+              << static_cast<double>(bytes) / static_cast<double>(items)
+              << " bytes/item" << std::endl;
+  };
+
+#ifdef MINIO_CPP_HAS_PUGIXML
+  {
+    pugi::set_memory_management_functions(Allocate, Deallocate);
+    size_t items = 0;
+    size_t bytes = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      size_t before = live_bytes;
+      OldPage page = ParseDom(data);
+      items = page.contents.size();
+      bytes = live_bytes - before;
+    }
+    report("DOM and XPath", Clock::now() - start, items, bytes);
+  }
+#endif
+
+  {
+    size_t items = 0;
+    size_t bytes = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+      size_t before = live_bytes;
+      auto page = minio::s3::ListObjectsResponse::ParseXML(data, false);
+      if (!page) {
+        std::cerr << page.error().String() << std::endl;
+        return EXIT_FAILURE;
+      }
+      items = page->contents.size();
+      bytes = live_bytes - before;
+    }
+    report("streaming", Clock::now() - start, items, bytes);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures presigned URLs per second of GetPresignedObjectUrl() called per
+// object against one GetPresignedObjectUrls() batch. Runs offline: the region
+// is fixed on the base URL, so no request reaches the endpoint.
+//
+// Usage: PresignBenchmark [object-count]
+
+#include <miniocpp/client.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+  size_t count = 100000;
+  if (argc > 1) count = std::strtoul(argv[1], nullptr, 10);
+
+  minio::s3::BaseUrl base_url("localhost:9000", false, "us-east-1");
+  minio::creds::StaticProvider provider("minioadmin", "minioadmin");
+  minio::s3::Client client(base_url, &provider);
+
+  std::vector<std::string> names;
+  names.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    names.push_back("prefix/object-" + std::to_string(i));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  auto report = [count](const char* name, Clock::duration elapsed) {
+    double secs = std::chrono::duration<double>(elapsed).count();
+    std::cout << name << ": " << count << " URLs in " << secs << "s, "
+              << static_cast<double>(count) / secs << " URLs/s" << std::endl;
+  };
+
+  auto start = Clock::now();
+  for (const auto& name : names) {
+    minio::s3::GetPresignedObjectUrlArgs args;
+    args.bucket = "my-bucket";
+    args.object = name;
+    args.method = minio::http::Method::kGet;
+    auto resp = client.GetPresignedObjectUrl(args);
+    if (!resp) {
+      std::cerr << "GetPresignedObjectUrl: " << resp.error() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  report("GetPresignedObjectUrl", Clock::now() - start);
+
+  minio::s3::GetPresignedObjectUrlsArgs args;
+  args.bucket = "my-bucket";
+  for (const auto& name : names) args.objects.emplace_back(name);
+  std::vector<std::string> urls;
+
+  start = Clock::now();
+  if (minio::error::Error err = client.GetPresignedObjectUrls(args, urls)) {
+    std::cerr << "GetPresignedObjectUrls: " << err << std::endl;
+    return EXIT_FAILURE;
+  }
+  report("GetPresignedObjectUrls", Clock::now() - start);
+
+  // A second batch into the same vector reuses its strings.
+  start = Clock::now();
+  if (minio::error::Error err = client.GetPresignedObjectUrls(args, urls)) {
+    std::cerr << "GetPresignedObjectUrls: " << err << std::endl;
+    return EXIT_FAILURE;
+  }
+  report("GetPresignedObjectUrls (reused)", Clock::now() - start);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures SHA-256 throughput over the chunks of an aws-chunked body: a
+// fresh digest context per chunk, utils::Sha256Hash with its per-thread
+// context, and utils::Sha256HashAll spreading the chunks of a batch over an
+// executor. Chunks are 64 KiB by default; small ones show the per-call setup
+// cost. Runs offline.
+//
+// Usage: Sha256Benchmark [buffer-bytes] [iterations] [threads] [chunk-bytes]
+
+#include <miniocpp/executor.h>
+#include <miniocpp/utils.h>
+#include <openssl/evp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr size_t kBatch = 16;
+
+// FreshContext is utils::Sha256Hash as it was before contexts were reused.
+std::string FreshContext(std::string_view data) {
+  EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+  EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr);
+  EVP_DigestUpdate(ctx, data.data(), data.size());
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int length = 0;
+  EVP_DigestFinal_ex(ctx, digest, &length);
+  EVP_MD_CTX_destroy(ctx);
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string hash;
+  for (unsigned int i = 0; i < length; ++i) {
+    hash += kHex[digest[i] >> 4];
+    hash += kHex[digest[i] & 0xf];
+  }
+  return hash;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t size = 64 * 1024 * 1024;
+  size_t iterations = 5;
+  unsigned int threads = minio::utils::Executor::DefaultMaxThreads();
+  size_t chunk_size = 64 * 1024;
+  if (argc > 1) size = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) iterations = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3) {
+    threads = static_cast<unsigned int>(std::strtoul(argv[3], nullptr, 10));
+  }
+  if (argc > 4) {
+    chunk_size = std::max<size_t>(1, std::strtoul(argv[4], nullptr, 10));
+  }
+
+  std::string buf(size, '\0');
+  std::mt19937_64 rng(42);
+  for (auto& c : buf) c = static_cast<char>(rng());
+  std::vector<std::string_view> chunks;
+  for (size_t offset = 0; offset < size; offset += chunk_size) {
+    chunks.emplace_back(buf.data() + offset,
+                        std::min(chunk_size, size - offset));
+  }
+
+  using Clock = std::chrono::steady_clock;
+  std::vector<std::string> expected;
+  for (auto chunk : chunks) expected.push_back(FreshContext(chunk));
+  auto run = [&](const std::string& name,
+                 const std::function<std::vector<std::string>()>& hash) {
+    std::vector<std::string> hashes;
+    auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) hashes = hash();
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << name << ": "
+              << static_cast<double>(size * iterations) / secs / 1e9
+              << " GB/s" << (hashes == expected ? "" : " (MISMATCH)")
+              << std::endl;
+    return hashes == expected;
+  };
+
+  bool ok = run("fresh context", [&chunks]() {
+    std::vector<std::string> hashes;
+    for (auto chunk : chunks) hashes.push_back(FreshContext(chunk));
+    return hashes;
+  });
+  ok &= run("per-thread context", [&chunks]() {
+    std::vector<std::string> hashes;
+    for (auto chunk : chunks) hashes.push_back(minio::utils::Sha256Hash(chunk));
+    return hashes;
+  });
+  minio::utils::Executor executor(threads);
+  ok &= run("executor batches of " + std::to_string(kBatch), [&]() {
+    std::vector<std::string> hashes;
+    for (size_t i = 0; i < chunks.size(); i += kBatch) {
+      std::vector<std::string_view> batch(
+          chunks.begin() + static_cast<std::ptrdiff_t>(i),
+          chunks.begin() +
+              static_cast<std::ptrdiff_t>(std::min(i + kBatch, chunks.size())));
+      for (auto& hash : minio::utils::Sha256HashAll(batch, &executor)) {
+        hashes.push_back(std::move(hash));
+      }
+    }
+    return hashes;
+  });
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,173 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Measures requests per second and latency percentiles of small GETs against
+// a loopback HTTP server, comparing the default transport (a thread per
+// in-flight request on pooled cpp-httplib clients) with EventLoopTransport
+// (all requests driven by loop threads). Runs offline.
+//
+// Usage: TransportBenchmark [request-count] [concurrency] [body-bytes]
+//                           [loop-threads]
+
+#include <httplib.h>
+#include <miniocpp/http.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+void Report(const char* name, std::vector<double>& latencies, size_t errors,
+            Clock::duration elapsed) {
+  double secs = std::chrono::duration<double>(elapsed).count();
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) {
+    if (latencies.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * (latencies.size() - 1));
+    return latencies[index] * 1000;
+  };
+  std::cout << name << ": " << latencies.size() << " requests in " << secs
+            << "s, " << static_cast<double>(latencies.size()) / secs
+            << " req/s, p50 " << percentile(0.50) << "ms, p99 "
+            << percentile(0.99) << "ms, " << errors << " errors" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t count = 20000;
+  size_t concurrency = 64;
+  size_t body_size = 4096;
+  unsigned int loop_threads = 1;
+  if (argc > 1) count = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2) concurrency = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3) body_size = std::strtoul(argv[3], nullptr, 10);
+  if (argc > 4) {
+    loop_threads =
+        static_cast<unsigned int>(std::strtoul(argv[4], nullptr, 10));
+  }
+  concurrency = std::max<size_t>(1, std::min(concurrency, count));
+
+  const std::string body(body_size, 'x');
+  httplib::Server server;
+  server.new_task_queue = [concurrency]() {
+    return new httplib::ThreadPool(concurrency + 8);
+  };
+  server.Get("/bucket/object",
+             [&body](const httplib::Request&, httplib::Response& res) {
+               res.set_content(body, "application/octet-stream");
+             });
+  int port = server.bind_to_any_port("127.0.0.1");
+  if (port < 0) {
+    std::cerr << "unable to bind loopback server" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::thread listener([&server]() { server.listen_after_bind(); });
+  server.wait_until_ready();
+
+  minio::http::Url url;
+  url.host = "127.0.0.1";
+  url.port = static_cast<unsigned int>(port);
+  url.path = "/bucket/object";
+
+  // Default transport: one blocking caller thread per in-flight request.
+  {
+    auto pool = std::make_shared<minio::http::ConnectionPool>(concurrency);
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> errors{0};
+    std::mutex mutex;
+    std::vector<double> latencies;
+    latencies.reserve(count);
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < concurrency; ++i) {
+      threads.emplace_back([&]() {
+        std::vector<double> local;
+        while (next++ < count) {
+          minio::http::Request request(minio::http::Method::kGet, url);
+          request.pool = pool;
+          auto begin = Clock::now();
+          minio::http::Response response = request.Execute();
+          local.push_back(
+              std::chrono::duration<double>(Clock::now() - begin).count());
+          if (!response || response.body.size() != body_size) errors++;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        latencies.insert(latencies.end(), local.begin(), local.end());
+      });
+    }
+    for (auto& thread : threads) thread.join();
+    Report("cpp-httplib", latencies, errors, Clock::now() - start);
+  }
+
+  // Event loop transport: concurrency requests kept in flight by completion
+  // callbacks submitting the next one.
+  {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> errors{0};
+    std::mutex mutex;
+    std::vector<double> latencies;
+    latencies.reserve(count);
+    std::promise<void> finished;
+    // Declared last so its loop threads are joined before the state above
+    // goes away.
+    minio::http::EventLoopTransport transport(loop_threads);
+
+    std::function<void()> submit = [&]() {
+      if (next++ >= count) return;
+      auto begin = Clock::now();
+      transport.Submit(minio::http::Request(minio::http::Method::kGet, url),
+                       [&, begin](minio::http::Response response) {
+                         double latency = std::chrono::duration<double>(
+                                              Clock::now() - begin)
+                                              .count();
+                         if (!response || response.body.size() != body_size) {
+                           errors++;
+                         }
+                         {
+                           std::lock_guard<std::mutex> lock(mutex);
+                           latencies.push_back(latency);
+                         }
+                         submit();
+                         if (++done == count) finished.set_value();
+                       });
+    };
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < concurrency; ++i) submit();
+    finished.get_future().wait();
+    Report("event loop", latencies, errors, Clock::now() - start);
+  }
+
+  server.stop();
+  listener.join();
+  return EXIT_SUCCESS;
+}
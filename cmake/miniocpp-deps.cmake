@@ -129,25 +129,10 @@ else()
   endif()
 endif()
 
-find_package(pugixml CONFIG QUIET)
-if (pugixml_FOUND)
-  set(MINIO_CPP_PUGIXML_TARGET pugixml)
-else()
-  if (PkgConfig_FOUND)
-    pkg_check_modules(MINIO_CPP_PUGIXML QUIET IMPORTED_TARGET pugixml)
-  endif()
-  if (NOT MINIO_CPP_PUGIXML_FOUND)
-    message(FATAL_ERROR
-      "pugixml: neither a CMake package (pugixml) nor pkg-config (pugixml.pc) was found")
-  endif()
-  set(MINIO_CPP_PUGIXML_TARGET PkgConfig::MINIO_CPP_PUGIXML)
-endif()
-
 set(MINIO_CPP_DEPS_LINK_LIBS
   ${MINIO_CPP_HTTPLIB_TARGET}
   ${MINIO_CPP_INIH_TARGET}
   nlohmann_json::nlohmann_json
-  ${MINIO_CPP_PUGIXML_TARGET}
   OpenSSL::SSL
   OpenSSL::Crypto
   ZLIB::ZLIB
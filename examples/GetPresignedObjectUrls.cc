@@ -0,0 +1,54 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <miniocpp/client.h>
+
+int main() {
+  // Create S3 base URL.
+  minio::s3::BaseUrl base_url("play.min.io");
+
+  // Create credential provider.
+  minio::creds::StaticProvider provider(
+      "Q3AM3UQ867SPQQA43P2F", "zuf+tfteSlswRu7BJ86wekitnifILbZam1KYY3TG");
+
+  // Create S3 client.
+  minio::s3::Client client(base_url, &provider);
+
+  // Create get presigned object urls arguments.
+  minio::s3::GetPresignedObjectUrlsArgs args;
+  args.bucket = "my-bucket";
+  args.objects.emplace_back("my-object", minio::http::Method::kGet);
+  args.objects.emplace_back("my-other-object", minio::http::Method::kPut);
+  args.expiry_seconds = 60 * 60 * 24;  // 1 day.
+
+  // Call get presigned object urls.
+  std::vector<std::string> urls;
+  minio::error::Error err = client.GetPresignedObjectUrls(args, urls);
+
+  // Handle response.
+  if (err) {
+    std::cout << "unable to get presigned object urls; " << err.String()
+              << std::endl;
+  } else {
+    for (size_t i = 0; i < urls.size(); ++i) {
+      std::cout << "presigned URL for " << args.objects[i].name << ": "
+                << urls[i] << std::endl;
+    }
+  }
+
+  return 0;
+}
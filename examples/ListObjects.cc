@@ -36,6 +36,10 @@ int main() {
   auto result = client.ListObjects(args);
   for (; result; result++) {
     auto item = *result;
+    if (!item.error.empty()) {
+      std::cout << "unable to list objects; " << item.error << std::endl;
+      break;
+    }
     std::cout << "Name: " << item.name << std::endl;
     std::cout << "Version ID: " << item.version_id << std::endl;
     std::cout << "ETag: " << item.etag << std::endl;
@@ -0,0 +1,74 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <miniocpp/client.h>
+
+int main() {
+  // Create S3 base URLs of the source and destination clusters.
+  minio::s3::BaseUrl src_base_url("play.min.io");
+  minio::s3::BaseUrl dst_base_url("minio.example.com");
+
+  // Create credential providers.
+  minio::creds::StaticProvider src_provider(
+      "Q3AM3UQ867SPQQA43P2F", "zuf+tfteSlswRu7BJ86wekitnifILbZam1KYY3TG");
+  minio::creds::StaticProvider dst_provider("YOUR-ACCESSKEYID",
+                                            "YOUR-SECRETACCESSKEY");
+
+  // Create S3 clients.
+  minio::s3::Client src_client(src_base_url, &src_provider);
+  minio::s3::Client dst_client(dst_base_url, &dst_provider);
+
+  // Create transfer object arguments.
+  minio::s3::TransferObjectArgs args;
+  args.bucket = "my-bucket";
+  args.object = "my-object";
+  args.source.bucket = "my-src-bucket";
+  args.source.object = "my-src-object";
+  args.part_size = 64 * 1024 * 1024;
+  args.max_inflight_parts = 8;
+
+  // Pin the source version, so a resumed transfer never mixes in parts of
+  // a newer one.
+  minio::s3::StatObjectArgs stat_args;
+  stat_args.bucket = args.source.bucket;
+  stat_args.object = args.source.object;
+  auto stat_resp = src_client.StatObject(stat_args);
+  if (!stat_resp) {
+    std::cout << "unable to do stat object; " << stat_resp.error().String()
+              << std::endl;
+    return 0;
+  }
+  args.source.match_etag = stat_resp->etag;
+
+  // Call transfer object; keep the upload ID to resume after a failure.
+  std::string upload_id;
+  auto resp = dst_client.TransferObject(src_client, args, upload_id);
+  if (!resp && !upload_id.empty()) {
+    resp = dst_client.TransferObject(src_client, args, upload_id);
+  }
+
+  // Handle response.
+  if (resp) {
+    std::cout << "my-object is successfully transferred from "
+              << "my-src-bucket/my-src-object" << std::endl;
+  } else {
+    std::cout << "unable to do transfer object; " << resp.error().String()
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -25,6 +25,7 @@
 #include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "error.h"
 #include "http.h"
@@ -134,6 +135,9 @@ struct AbortMultipartUploadArgs : public ObjectArgs {
 struct CompleteMultipartUploadArgs : public ObjectArgs {
   std::string upload_id;
   std::list<Part> parts;
+  // FULL_OBJECT CRC64NVME of the whole object, base64; when set, the server
+  // checks it and the call fails if the object it assembled differs.
+  std::string checksum_crc64nvme;
 
   CompleteMultipartUploadArgs() = default;
   ~CompleteMultipartUploadArgs() = default;
@@ -153,6 +157,10 @@ struct PutObjectBaseArgs : public ObjectWriteArgs {
   size_t part_size = 0;
   std::optional<size_t> part_count;
   std::string content_type;
+  // How the body is signed, and the checksum S3 verifies it against; see
+  // PayloadSigning. A streamed body sends its checksum as a trailer.
+  PayloadSigning payload_signing = PayloadSigning::kAuto;
+  ChecksumAlgorithm checksum = ChecksumAlgorithm::kNone;
 
   PutObjectBaseArgs() = default;
   ~PutObjectBaseArgs() = default;
@@ -162,6 +170,10 @@ struct PutObjectApiArgs : public PutObjectBaseArgs {
   std::string_view data;
   char* buf;
   size_t size;
+  // Pulls the body while it is sent, instead of data; size is then the body
+  // length. See http::Request::bodyfunc.
+  http::BodyFunction bodyfunc = nullptr;
+  void* body_userdata = nullptr;
   utils::Multimap query_params;
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
@@ -180,6 +192,12 @@ struct UploadPartArgs : public ObjectWriteArgs {
   char* buf;
   size_t part_size;
   std::string_view data;
+  // Pulls the part while it is sent, instead of data; part_size is then the
+  // part length. See http::Request::bodyfunc.
+  http::BodyFunction bodyfunc = nullptr;
+  void* body_userdata = nullptr;
+  PayloadSigning payload_signing = PayloadSigning::kAuto;
+  ChecksumAlgorithm checksum = ChecksumAlgorithm::kNone;
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
 #ifdef MINIO_CPP_RDMA
@@ -193,6 +211,17 @@ struct UploadPartArgs : public ObjectWriteArgs {
   error::Error Validate() const;
 };  // struct UploadPartArgs
 
+struct ListPartsArgs : public ObjectArgs {
+  std::string upload_id;
+  unsigned int max_parts = 1000;
+  unsigned int part_number_marker = 0;
+
+  ListPartsArgs() = default;
+  ~ListPartsArgs() = default;
+
+  error::Error Validate() const;
+};  // struct ListPartsArgs
+
 struct UploadPartCopyArgs : public ObjectWriteArgs {
   std::string upload_id;
   unsigned int part_number;
@@ -213,6 +242,13 @@ struct DownloadObjectArgs : public ObjectReadArgs {
   bool overwrite;
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
+  // The object is fetched as part_size (0 == 16 MiB) ranges, up to
+  // max_inflight_parts at once, written at their offsets into
+  // "<filename>.<etag>.part.minio". Completed ranges are recorded in a
+  // ".journal" sidecar, so a failed download of the same ETag resumes.
+  size_t part_size = 0;
+  std::optional<unsigned int>
+      max_inflight_parts;  // Max concurrent ranged GETs
 
   DownloadObjectArgs() = default;
   ~DownloadObjectArgs() = default;
@@ -222,14 +258,29 @@ struct DownloadObjectArgs : public ObjectReadArgs {
 
 struct GetObjectArgs : public ObjectConditionalReadArgs {
   // Exactly one of (datafunc, buf) must be set; Validate() enforces.
-  // When buf is set, the call attempts RDMA and falls back to streaming
-  // the HTTP body into the same buffer on RDMA decline.
+  // When buf is set, the HTTP body is received directly into it (at most size
+  // bytes; GetObjectResponse::size reports how many were written). With RDMA
+  // built in, the call attempts RDMA first and falls back to HTTP on decline.
   http::DataFunction datafunc;
   void* userdata = nullptr;
+  // Hand body chunks to datafunc only as DataFunctionArgs::data, a view into
+  // the transport buffer, leaving datachunk empty; saves a copy per chunk.
+  bool zero_copy = false;
   char* buf = nullptr;
   std::optional<size_t> size;
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
+  // Parallel ranged download (Client::GetObject only): with
+  // max_inflight_parts > 1 an object larger than part_size (0 == 16 MiB) is
+  // fetched as concurrent ranged GETs pinned to its ETag, then written into
+  // buf or handed to datafunc in order.
+  size_t part_size = 0;
+  std::optional<unsigned int>
+      max_inflight_parts;  // Max concurrent ranged GETs
+  // Checks a whole-object read against the object's full-object checksum of
+  // this algorithm, computed as the body is received; a mismatch fails the
+  // call. Objects stored without one, and ranged reads, are not checked.
+  ChecksumAlgorithm verify_checksum = ChecksumAlgorithm::kNone;
 
   GetObjectArgs() = default;
   ~GetObjectArgs() = default;
@@ -252,6 +303,13 @@ struct ListObjectsArgs : public BucketArgs {
   bool recursive = false;
   bool use_api_v1 = false;
   bool include_versions = false;
+  // A recursive listing of objects (not versions) is split into key ranges,
+  // by the common prefixes of a delimiter probe or else by start_after
+  // bounds, and up to max_inflight_partitions (unset == sequential) of them
+  // are listed at once. Items keep key order unless unordered is set, which
+  // returns each page as soon as it arrives.
+  std::optional<unsigned int> max_inflight_partitions;
+  bool unordered = false;
 
   ListObjectsArgs() = default;
   ~ListObjectsArgs() = default;
@@ -389,6 +447,10 @@ struct ComposeSource : public ObjectConditionalReadArgs {
 
 struct ComposeObjectArgs : public ObjectWriteArgs {
   std::list<ComposeSource> sources;
+  // Sources are stat'ed and parts copied up to max_inflight_parts (unset ==
+  // 4) at once; parts still complete in source order.
+  std::optional<unsigned int>
+      max_inflight_parts;  // Max concurrent StatObject/UploadPartCopy calls
 
   ComposeObjectArgs() = default;
   ~ComposeObjectArgs() = default;
@@ -396,10 +458,40 @@ struct ComposeObjectArgs : public ObjectWriteArgs {
   error::Error Validate() const;
 };  // struct ComposeObjectArgs
 
+struct TransferObjectArgs : public ObjectWriteArgs {
+  // Object to read through the source client; offset/length are ignored.
+  CopySource source;
+  // Range size (0 == picked from the object size) and number of ranges
+  // being fetched from the source and uploaded at once; buffered memory is
+  // at most max_inflight_parts * part_size.
+  size_t part_size = 0;
+  std::optional<unsigned int>
+      max_inflight_parts;  // Max concurrent GET + UploadPart pipelines
+  // Copy Content-Type, Cache-Control, Content-Encoding, Content-Disposition,
+  // Content-Language, Expires and user metadata of the source unless set in
+  // headers or user_metadata.
+  bool preserve_metadata = true;
+  // Copy the source object's tags unless tags is set.
+  bool preserve_tags = true;
+  http::ProgressFunction progressfunc = nullptr;
+  void* progress_userdata = nullptr;
+
+  TransferObjectArgs() = default;
+  ~TransferObjectArgs() = default;
+
+  error::Error Validate() const;
+};  // struct TransferObjectArgs
+
 struct UploadObjectArgs : public PutObjectBaseArgs {
   std::filesystem::path filename;
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
+  // Each part is read from its own range of the file into a buffer of its
+  // own, up to max_inflight_parts (unset == 4) at once, so the upload holds
+  // at most that many part_size buffers. A file truncated during the upload
+  // fails it.
+  std::optional<unsigned int>
+      max_inflight_parts;  // Max concurrent UploadPart calls
 
   UploadObjectArgs() = default;
   ~UploadObjectArgs() = default;
@@ -421,6 +513,14 @@ using DeleteObjectFunction = std::function<bool(DeleteObject&)>;
 struct RemoveObjectsArgs : public BucketArgs {
   bool bypass_governance_mode = false;
   DeleteObjectFunction func = nullptr;
+  // Objects from func are deleted in batches of up to 1000, with up to
+  // max_inflight_batches (unset == 4) DeleteObjects calls at once. Errors
+  // are returned batch by batch, in submission order. Stopping the iteration
+  // early does not cancel batches already submitted: they still delete their
+  // objects, and the last copy of the RemoveObjectsResult waits for them when
+  // destroyed.
+  std::optional<unsigned int>
+      max_inflight_batches;  // Max concurrent DeleteObjects calls
 
   RemoveObjectsArgs() = default;
   ~RemoveObjectsArgs() = default;
@@ -599,6 +699,17 @@ struct GetPresignedObjectUrlArgs : public ObjectVersionArgs {
   error::Error Validate() const;
 };  // struct GetPresignedObjectUrlArgs
 
+struct GetPresignedObjectUrlsArgs : public BucketArgs {
+  std::vector<PresignObject> objects;
+  unsigned int expiry_seconds = kDefaultExpirySeconds;
+  utils::UtcTime request_time;
+
+  GetPresignedObjectUrlsArgs() = default;
+  ~GetPresignedObjectUrlsArgs() = default;
+
+  error::Error Validate() const;
+};  // struct GetPresignedObjectUrlsArgs
+
 struct PostPolicy {
   std::string bucket;
   std::string region;
@@ -18,20 +18,27 @@
 #ifndef MINIO_CPP_BASECLIENT_H_INCLUDED
 #define MINIO_CPP_BASECLIENT_H_INCLUDED
 
+#include <functional>
 #include <future>
 #include <map>
+#include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "args.h"
 #include "config.h"
 #include "error.h"
+#include "executor.h"
 #include "http.h"
 #include "providers.h"
 #include "request.h"
 #include "response.h"
 #include "result.h"
+#include "statcache.h"
 #include "utils.h"
 
 #ifdef MINIO_CPP_RDMA
@@ -64,6 +71,14 @@ class BaseClient {
   bool ignore_cert_check_ = false;
   std::string ssl_cert_file_;
   std::string user_agent_ = DEFAULT_USER_AGENT;
+  std::shared_ptr<http::ConnectionPool> connection_pool_ =
+      std::make_shared<http::ConnectionPool>();
+  std::shared_ptr<http::TlsContextCache> tls_context_cache_ =
+      std::make_shared<http::TlsContextCache>();
+  std::shared_ptr<utils::Executor> executor_ =
+      std::make_shared<utils::Executor>();
+  std::shared_ptr<http::Transport> transport_;
+  std::shared_ptr<StatCache> stat_cache_;
 
  public:
   explicit BaseClient(BaseUrl base_url,
@@ -89,6 +104,64 @@ class BaseClient {
   error::Error SetAppInfo(std::string_view app_name,
                           std::string_view app_version);
 
+  // Connection pool reused by every request of this client. Tune it through
+  // the returned pointer, share one pool between clients, or pass nullptr to
+  // open a fresh connection per request.
+  const std::shared_ptr<http::ConnectionPool>& GetConnectionPool() const {
+    return connection_pool_;
+  }
+
+  void SetConnectionPool(std::shared_ptr<http::ConnectionPool> pool) {
+    connection_pool_ = std::move(pool);
+  }
+
+  // TLS context cache shared by every https connection of this client; its
+  // counters report full vs resumed handshakes. Pass nullptr to disable
+  // CA store sharing and session resumption.
+  const std::shared_ptr<http::TlsContextCache>& GetTlsContextCache() const {
+    return tls_context_cache_;
+  }
+
+  void SetTlsContextCache(std::shared_ptr<http::TlsContextCache> cache) {
+    tls_context_cache_ = std::move(cache);
+  }
+
+  // Executor running the Async overloads and the parallel parts of
+  // multipart operations; its size caps their concurrency and Stats() reports
+  // queue depth. Share one executor between clients, or pass nullptr to get a
+  // fresh default-sized one. Set it before issuing requests; the client must
+  // outlive the work it submitted.
+  const std::shared_ptr<utils::Executor>& GetExecutor() const {
+    return executor_;
+  }
+
+  void SetExecutor(std::shared_ptr<utils::Executor> executor) {
+    executor_ = executor ? std::move(executor)
+                         : std::make_shared<utils::Executor>();
+  }
+
+  // Transport every request of this client runs on, e.g. an
+  // http::EventLoopTransport. nullptr (the default) uses a blocking
+  // cpp-httplib client per request with the connection pool above.
+  const std::shared_ptr<http::Transport>& GetTransport() const {
+    return transport_;
+  }
+
+  void SetTransport(std::shared_ptr<http::Transport> transport) {
+    transport_ = std::move(transport);
+  }
+
+  // Cache of StatObject responses, also used by the stats of DownloadObject,
+  // CopyObject and ComposeObject; its counters report hits and misses.
+  // nullptr (the default) sends a HEAD request for every stat.
+  const std::shared_ptr<StatCache>& GetStatCache() const {
+    return stat_cache_;
+  }
+
+  void SetStatCache(std::shared_ptr<StatCache> cache) {
+    stat_cache_ = std::move(cache);
+  }
+
   void HandleRedirectResponse(std::string& code, std::string& message,
                               int status_code, http::Method method,
                               const utils::Multimap& headers,
@@ -99,10 +172,25 @@ class BaseClient {
                                     http::Method method,
                                     const std::string& bucket_name,
                                     const std::string& object_name);
+  http::Request NewHttpRequest(Request& req);
+  Result<Response> HandleResponse(Request& req, std::string_view resource,
+                                  http::Response response);
   Result<Response> execute(Request& req);
   Result<Response> Execute(Request& req);
+
+  // ExecuteAsync runs req like Execute() without blocking the caller. With a
+  // transport it goes through Transport::Submit(), so on an
+  // EventLoopTransport no thread waits for the response; otherwise it runs
+  // on the executor. done gets the result on the thread that completed the
+  // request and must not block. req is kept until then; the body and the
+  // data it refers to, and the client, must outlive the call.
+  void ExecuteAsync(std::shared_ptr<Request> req,
+                    std::function<void(Result<Response>)> done);
   Result<GetRegionResponse> GetRegion(const std::string& bucket_name,
                                       const std::string& region);
+  void GetRegionAsync(const std::string& bucket_name,
+                      const std::string& region,
+                      std::function<void(Result<GetRegionResponse>)> done);
 
   Result<AbortMultipartUploadResponse> AbortMultipartUpload(
       AbortMultipartUploadArgs args);
@@ -149,6 +237,11 @@ class BaseClient {
   Result<GetObjectTagsResponse> GetObjectTags(GetObjectTagsArgs args);
   Result<GetPresignedObjectUrlResponse> GetPresignedObjectUrl(
       GetPresignedObjectUrlArgs args);
+  // GetPresignedObjectUrls presigns args.objects in one pass, writing the URL
+  // of args.objects[i] into urls[i]. Region, credentials and signing key are
+  // resolved once; existing strings in urls are reused.
+  error::Error GetPresignedObjectUrls(const GetPresignedObjectUrlsArgs& args,
+                                      std::vector<std::string>& urls);
   Result<GetPresignedPostFormDataResponse> GetPresignedPostFormData(
       PostPolicy policy);
   Result<IsObjectLegalHoldEnabledResponse> IsObjectLegalHoldEnabled(
@@ -160,6 +253,7 @@ class BaseClient {
   Result<ListObjectsResponse> ListObjectsV1(ListObjectsV1Args args);
   Result<ListObjectsResponse> ListObjectsV2(ListObjectsV2Args args);
   Result<ListObjectsResponse> ListObjectVersions(ListObjectVersionsArgs args);
+  Result<ListPartsResponse> ListParts(ListPartsArgs args);
   Result<MakeBucketResponse> MakeBucket(MakeBucketArgs args);
   Result<PutObjectResponse> PutObject(PutObjectApiArgs args);
   Result<RemoveBucketResponse> RemoveBucket(RemoveBucketArgs args);
@@ -188,7 +282,8 @@ class BaseClient {
   Result<UploadPartResponse> UploadPart(UploadPartArgs args);
   Result<UploadPartCopyResponse> UploadPartCopy(UploadPartCopyArgs args);
 
-  // Async overloads — return std::future<Result<T>> backed by std::async.
+  // Async overloads — return std::future<Result<T>> run on the client's
+  // executor. Unlike std::async futures, destroying one does not wait.
   // All sync methods now also return Result<T>.
   std::future<Result<AbortMultipartUploadResponse>> AbortMultipartUploadAsync(
       AbortMultipartUploadArgs args);
@@ -256,6 +351,7 @@ class BaseClient {
       ListObjectsV2Args args);
   std::future<Result<ListObjectsResponse>> ListObjectVersionsAsync(
       ListObjectVersionsArgs args);
+  std::future<Result<ListPartsResponse>> ListPartsAsync(ListPartsArgs args);
   std::future<Result<MakeBucketResponse>> MakeBucketAsync(MakeBucketArgs args);
   std::future<Result<PutObjectResponse>> PutObjectAsync(PutObjectApiArgs args);
   std::future<Result<RemoveBucketResponse>> RemoveBucketAsync(
@@ -291,6 +387,27 @@ class BaseClient {
   std::future<Result<UploadPartCopyResponse>> UploadPartCopyAsync(
       UploadPartCopyArgs args);
 
+  // Callback overloads — run like ExecuteAsync(): no thread waits for the
+  // response on an EventLoopTransport, and done gets the result on the thread
+  // that completed the request, where it must not block. An exception thrown
+  // by a data function becomes an error result.
+  void GetObjectAsync(GetObjectArgs args,
+                      std::function<void(Result<GetObjectResponse>)> done);
+  void ListObjectsV1Async(
+      ListObjectsV1Args args,
+      std::function<void(Result<ListObjectsResponse>)> done);
+  void ListObjectsV2Async(
+      ListObjectsV2Args args,
+      std::function<void(Result<ListObjectsResponse>)> done);
+  void ListObjectVersionsAsync(
+      ListObjectVersionsArgs args,
+      std::function<void(Result<ListObjectsResponse>)> done);
+  void RemoveObjectsAsync(
+      RemoveObjectsApiArgs args,
+      std::function<void(Result<RemoveObjectsResponse>)> done);
+  void StatObjectAsync(StatObjectArgs args,
+                       std::function<void(Result<StatObjectResponse>)> done);
+
   // Windows API fix:
   //
   // Windows API headers define `GetObject()` as a macro that expands to either
@@ -308,6 +425,29 @@ class BaseClient {
   }
 #endif  // _WIN32
 
+ private:
+  template <typename T>
+  struct Call;
+
+  template <typename T>
+  Result<T> Run(Call<T> call);
+  template <typename T>
+  void RunAsync(Call<T> call, std::function<void(Result<T>)> done);
+
+  Call<GetObjectResponse> PrepareGetObject(GetObjectArgs args);
+  Call<ListObjectsResponse> PrepareListObjectsV1(ListObjectsV1Args args);
+  Call<ListObjectsResponse> PrepareListObjectsV2(ListObjectsV2Args args);
+  Call<ListObjectsResponse> PrepareListObjectVersions(
+      ListObjectVersionsArgs args);
+  Call<RemoveObjectsResponse> PrepareRemoveObjects(RemoveObjectsApiArgs args);
+  Call<StatObjectResponse> PrepareStatObject(StatObjectArgs args);
+
+  std::optional<Result<GetRegionResponse>> KnownRegion(
+      const std::string& bucket_name, const std::string& region);
+  Result<GetRegionResponse> StoreRegion(const std::string& bucket_name,
+                                        Result<Response> exec_gr);
+  void executeAsync(std::shared_ptr<Request> req, bool retried,
+                    std::function<void(Result<Response>)> done);
 };  // class BaseClient
 
 }  // namespace minio::s3
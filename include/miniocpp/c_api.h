@@ -64,8 +64,9 @@ MINIOCPP_API void miniocpp_client_free(miniocpp_client* client);
 // PUT. When `buf` is non-NULL, attempts RDMA with HTTP-from-buf fallback;
 // `read_cb` is ignored. When `buf` is NULL, streams from `read_cb`.
 // Writes the resulting ETag (max 63 chars + NUL) into etag_out if non-NULL.
-// Writes the CRC64NVME checksum (base64, ~32 chars) into checksum_out if
-// non-NULL. Returns bytes transferred on success, or one of MINIOCPP_ERR_*.
+// Writes the FULL_OBJECT CRC64NVME checksum of the whole object (base64, 12
+// chars), verified by the server, into checksum_out if non-NULL. Returns
+// bytes transferred on success, or one of MINIOCPP_ERR_*.
 MINIOCPP_API ssize_t miniocpp_put_object(miniocpp_client* client,
                                          const char* bucket, const char* object,
                                          void* buf, size_t size,
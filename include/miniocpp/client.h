@@ -18,9 +18,15 @@
 #ifndef MINIO_CPP_CLIENT_H_INCLUDED
 #define MINIO_CPP_CLIENT_H_INCLUDED
 
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <future>
 #include <list>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "args.h"
 #include "baseclient.h"
@@ -38,6 +44,7 @@
 namespace minio::s3 {
 
 class Client;
+class ParallelListing;
 
 class ListObjectsResult {
  private:
@@ -45,9 +52,11 @@ class ListObjectsResult {
   ListObjectsArgs args_;
   bool failed_ = false;
   std::shared_ptr<ListObjectsResponse> resp_;
-  std::list<Item>::iterator itr_;
+  std::vector<Item>::iterator itr_;
   std::shared_ptr<std::shared_future<std::shared_ptr<ListObjectsResponse>>>
       prefetch_future_;
+  // Set when args_.max_inflight_partitions splits the listing.
+  std::shared_ptr<ParallelListing> parallel_;
 
   void Populate();
   void StartPrefetch();
@@ -89,10 +98,15 @@ class RemoveObjectsResult {
  private:
   Client* client_ = nullptr;
   RemoveObjectsArgs args_;
-  bool done_ = false;
+  bool done_ = false;  // args_.func has no more objects.
+  unsigned int max_inflight_ = 1;
+  // DeleteObjects batches in submission order; shared by copies, the last of
+  // which waits for those still in flight.
+  std::shared_ptr<std::deque<std::future<RemoveObjectsResponse>>> inflight_;
   RemoveObjectsResponse resp_;
   std::list<DeleteError>::iterator itr_;
 
+  void Submit();
   void Populate();
 
  public:
@@ -105,7 +119,7 @@ class RemoveObjectsResult {
   explicit operator bool() const { return itr_ != resp_.errors.end(); }
   RemoveObjectsResult& operator++() {
     itr_++;
-    if (!done_ && itr_ == resp_.errors.end()) {
+    if (itr_ == resp_.errors.end() && (!done_ || !inflight_->empty())) {
       Populate();
     }
     return *this;
@@ -124,11 +138,16 @@ class RemoveObjectsResult {
 class Client : public BaseClient {
  protected:
   Result<StatObjectResponse> CalculatePartCount(
-      size_t& part_count, std::list<ComposeSource> sources);
+      size_t& part_count, std::list<ComposeSource>& sources,
+      unsigned int max_inflight);
   Result<ComposeObjectResponse> ComposeObject(ComposeObjectArgs args,
                                               std::string& upload_id);
   Result<PutObjectResponse> PutObject(PutObjectArgs args,
                                       std::string& upload_id, char* buf);
+  Result<GetObjectResponse> ParallelGetObject(GetObjectArgs args);
+  Result<UploadObjectResponse> UploadObject(
+      UploadObjectArgs args, unsigned int max_inflight,
+      const std::function<error::Error(char*, size_t, uint64_t)>& read_at);
 
 #ifdef MINIO_CPP_RDMA
   // The process-wide RDMA client — see minio::rdma::Shared() in
@@ -149,7 +168,22 @@ class Client : public BaseClient {
   Result<UploadObjectResponse> UploadObject(UploadObjectArgs args);
   RemoveObjectsResult RemoveObjects(RemoveObjectsArgs args);
 
-  // Async overloads — return std::future<T> backed by std::async.
+  // TransferObject copies args.source, read through source_client (which may
+  // point at another cluster), to args.bucket/args.object on this client.
+  // Ranged GETs feed concurrent UploadParts without staging the object. The
+  // overload taking upload_id resumes that multipart upload when it is
+  // non-empty, skipping parts already uploaded, and leaves the upload in
+  // place on failure so it can be resumed; the other aborts it. Resuming
+  // requires args.source.match_etag, the ETag of the source the upload was
+  // started from; if the source has changed since, the upload is aborted and
+  // upload_id cleared.
+  Result<TransferObjectResponse> TransferObject(BaseClient& source_client,
+                                                TransferObjectArgs args);
+  Result<TransferObjectResponse> TransferObject(BaseClient& source_client,
+                                                TransferObjectArgs args,
+                                                std::string& upload_id);
+
+  // Async overloads — return std::future<T> run on the client's executor.
   //
   // Lifetime note for PutObjectAsync: the caller must ensure
   // args.stream (if set) outlives the returned std::future<T>,
@@ -164,6 +198,8 @@ class Client : public BaseClient {
   std::future<Result<PutObjectResponse>> PutObjectAsync(PutObjectArgs args);
   std::future<Result<UploadObjectResponse>> UploadObjectAsync(
       UploadObjectArgs args);
+  std::future<Result<TransferObjectResponse>> TransferObjectAsync(
+      BaseClient& source_client, TransferObjectArgs args);
 };  // class Client
 
 }  // namespace minio::s3
@@ -0,0 +1,334 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MINIO_CPP_CORO_H_INCLUDED
+#define MINIO_CPP_CORO_H_INCLUDED
+
+// Coroutine API; available when built with MINIO_CPP_STD=20.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define MINIO_CPP_HAS_COROUTINES 1
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "args.h"
+#include "client.h"
+#include "error.h"
+#include "executor.h"
+#include "response.h"
+#include "result.h"
+
+namespace minio::s3::coro {
+
+/**
+ * Task is a lazily started coroutine returning T. It runs when awaited, or
+ * when handed to Start(). Awaiting a Task resumes the awaiter on the thread
+ * that finished it.
+ */
+template <typename T>
+class Task;
+
+namespace detail {
+
+template <typename T>
+struct TaskPromiseBase {
+  std::coroutine_handle<> continuation;
+  std::exception_ptr exception;
+
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<P> handle) noexcept {
+      auto continuation = handle.promise().continuation;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() { exception = std::current_exception(); }
+};  // struct TaskPromiseBase
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase<T> {
+  std::optional<T> value;
+
+  Task<T> get_return_object();
+  template <typename U>
+  void return_value(U&& v) {
+    value.emplace(std::forward<U>(v));
+  }
+  T Take() {
+    if (this->exception) std::rethrow_exception(this->exception);
+    return std::move(*value);
+  }
+};  // struct TaskPromise
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase<void> {
+  Task<void> get_return_object();
+  void return_void() {}
+  void Take() {
+    if (exception) std::rethrow_exception(exception);
+  }
+};  // struct TaskPromise<void>
+
+// Detached is an eagerly started coroutine that frees itself when done.
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};  // struct Detached
+
+}  // namespace detail
+
+template <typename T>
+class Task {
+ public:
+  using promise_type = detail::TaskPromise<T>;
+
+  Task() = default;
+  explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  bool await_ready() const noexcept { return !handle_ || handle_.done(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) {
+    handle_.promise().continuation = awaiter;
+    return handle_;
+  }
+  T await_resume() { return handle_.promise().Take(); }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};  // class Task
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() {
+  return Task<void>(
+      std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * Start runs task on the calling thread until its first suspension and
+ * returns a future of its result. Use it to launch many coroutines at once,
+ * or call get() on it to block until one finishes.
+ */
+template <typename T>
+std::future<T> Start(Task<T> task) {
+  std::promise<T> promise;
+  std::future<T> future = promise.get_future();
+  [](Task<T> task, std::promise<T> promise) -> detail::Detached {
+    try {
+      if constexpr (std::is_void_v<T>) {
+        co_await task;
+        promise.set_value();
+      } else {
+        promise.set_value(co_await task);
+      }
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  }(std::move(task), std::move(promise));
+  return future;
+}
+
+/**
+ * Operation is the awaitable returned by the functions below. Most of them
+ * complete from the request's own completion: with an EventLoopTransport no
+ * thread waits for the response, so thousands can be in flight on a few
+ * threads, and the awaiting coroutine resumes on the loop thread, where it
+ * must not block; without one the request runs on the client's executor and
+ * the coroutine resumes on that worker. An operation built from a blocking
+ * function instead runs it on the executor and occupies a worker for its
+ * whole request, so the executor's thread count bounds those in flight; an
+ * exception thrown by the function, e.g. by a data callback, is rethrown to
+ * the awaiter.
+ */
+template <typename R>
+class Operation {
+ public:
+  // Start begins the operation and calls its argument once with the result,
+  // on any thread, possibly before returning.
+  using Start = std::function<void(std::function<void(R)>)>;
+
+  explicit Operation(Start start) : start_(std::move(start)) {}
+  Operation(std::shared_ptr<utils::Executor> executor, std::function<R()> func)
+      : executor_(std::move(executor)), func_(std::move(func)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  bool await_suspend(std::coroutine_handle<> handle) {
+    handle_ = handle;
+    if (start_) {
+      Start start = std::move(start_);
+      start([this](R result) {
+        result_.emplace(std::move(result));
+        Complete();
+      });
+    } else {
+      try {
+        executor_->Submit([this]() {
+          // The awaiter must resume whatever happens; a lost exception would
+          // leave it suspended forever.
+          try {
+            result_.emplace(func_());
+          } catch (...) {
+            exception_ = std::current_exception();
+          }
+          Complete();
+        });
+      } catch (const std::system_error& e) {
+        result_.emplace(tl::make_unexpected(
+            error::Error(std::string("unable to create thread: ") + e.what())));
+        return false;
+      }
+    }
+    // Whichever of this and Complete() comes second resumes the awaiter, so
+    // a result delivered before the suspension resumes it right here.
+    return !completed_.exchange(true);
+  }
+
+  R await_resume() {
+    if (exception_) std::rethrow_exception(exception_);
+    return std::move(*result_);
+  }
+
+ private:
+  void Complete() {
+    if (completed_.exchange(true)) handle_.resume();
+  }
+
+  Start start_;
+  std::shared_ptr<utils::Executor> executor_;
+  std::function<R()> func_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> completed_ = false;
+  std::optional<R> result_;
+  std::exception_ptr exception_;
+};  // class Operation
+
+// GetObject completes from the response, so args.datafunc runs on the thread
+// that receives it. Parallel parts and RDMA buffers block a worker instead.
+inline Operation<Result<GetObjectResponse>> GetObject(Client& client,
+                                                      GetObjectArgs args) {
+  bool blocking = args.max_inflight_parts.value_or(1) > 1;
+#ifdef MINIO_CPP_RDMA
+  blocking = blocking || args.buf != nullptr;
+#endif
+  if (blocking) {
+    return {client.GetExecutor(), [&client, args = std::move(args)]() {
+              return client.GetObject(args);
+            }};
+  }
+  return Operation<Result<GetObjectResponse>>(
+      [&client, args = std::move(args)](
+          std::function<void(Result<GetObjectResponse>)> done) {
+        client.BaseClient::GetObjectAsync(args, std::move(done));
+      });
+}
+
+// PutObject streams args.stream from a worker for the whole upload.
+inline Operation<Result<PutObjectResponse>> PutObject(Client& client,
+                                                      PutObjectArgs args) {
+  return {client.GetExecutor(), [&client, args = std::move(args)]() {
+            return client.PutObject(args);
+          }};
+}
+
+inline Operation<Result<StatObjectResponse>> StatObject(Client& client,
+                                                        StatObjectArgs args) {
+  return Operation<Result<StatObjectResponse>>(
+      [&client, args = std::move(args)](
+          std::function<void(Result<StatObjectResponse>)> done) {
+        client.BaseClient::StatObjectAsync(args, std::move(done));
+      });
+}
+
+// ListObjectsPage fetches one page of args; continue with the markers of the
+// returned response while it is truncated.
+inline Operation<Result<ListObjectsResponse>> ListObjectsPage(
+    Client& client, ListObjectsArgs args) {
+  if (args.recursive) {
+    args.delimiter = "";
+  } else if (args.delimiter.empty()) {
+    args.delimiter = "/";
+  }
+  return Operation<Result<ListObjectsResponse>>(
+      [&client, args = std::move(args)](
+          std::function<void(Result<ListObjectsResponse>)> done) {
+        if (error::Error err = args.Validate()) {
+          done(tl::make_unexpected(err));
+        } else if (args.include_versions || !args.version_id_marker.empty()) {
+          client.BaseClient::ListObjectVersionsAsync(
+              ListObjectVersionsArgs(args), std::move(done));
+        } else if (args.use_api_v1) {
+          client.BaseClient::ListObjectsV1Async(ListObjectsV1Args(args),
+                                                std::move(done));
+        } else {
+          client.BaseClient::ListObjectsV2Async(ListObjectsV2Args(args),
+                                                std::move(done));
+        }
+      });
+}
+
+// RemoveObjects deletes one batch of up to 1000 objects.
+inline Operation<Result<RemoveObjectsResponse>> RemoveObjects(
+    Client& client, RemoveObjectsApiArgs args) {
+  return Operation<Result<RemoveObjectsResponse>>(
+      [&client, args = std::move(args)](
+          std::function<void(Result<RemoveObjectsResponse>)> done) {
+        client.BaseClient::RemoveObjectsAsync(args, std::move(done));
+      });
+}
+
+}  // namespace minio::s3::coro
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // MINIO_CPP_CORO_H_INCLUDED
@@ -0,0 +1,107 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MINIO_CPP_EXECUTOR_H_INCLUDED
+#define MINIO_CPP_EXECUTOR_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace minio::utils {
+
+struct ExecutorStats {
+  unsigned int max_threads = 0;  // Concurrency cap.
+  unsigned int threads = 0;      // Worker threads started so far.
+  unsigned int active = 0;       // Workers currently running a task.
+  size_t queued = 0;             // Tasks waiting for a worker.
+  size_t max_queued = 0;         // High-water mark of queued.
+  uint64_t submitted = 0;        // Tasks submitted.
+  uint64_t completed = 0;        // Tasks finished.
+  uint64_t stolen = 0;           // Tasks taken from another worker's queue.
+};  // struct ExecutorStats
+
+/**
+ * Executor runs tasks on a bounded set of worker threads. Workers are started
+ * on demand up to max_threads. A task submitted from a worker goes to that
+ * worker's own queue; idle workers steal from the others. A worker waiting on
+ * a future through Wait()/Get() runs pending tasks meanwhile, so nested
+ * parallel stages cannot starve the pool. It is thread-safe and may be shared
+ * by several clients. Pending tasks are run before the destructor returns.
+ */
+class Executor {
+ public:
+  explicit Executor(unsigned int max_threads = DefaultMaxThreads());
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  // DefaultMaxThreads returns twice the hardware concurrency, at least 8.
+  static unsigned int DefaultMaxThreads();
+
+  // Submit queues func and returns a future of its result. Throws
+  // std::system_error when no worker thread can be started.
+  template <typename F>
+  auto Submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>&>> {
+    using R = std::invoke_result_t<std::decay_t<F>&>;
+    auto task =
+        std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+    std::future<R> future = task->get_future();
+    Post([task]() { (*task)(); });
+    return future;
+  }
+
+  // Wait blocks until future is ready. On a worker thread of this executor it
+  // runs pending tasks while waiting.
+  template <typename Future>
+  void Wait(const Future& future) {
+    if (!IsWorker()) {
+      future.wait();
+      return;
+    }
+    while (future.wait_for(std::chrono::seconds(0)) !=
+           std::future_status::ready) {
+      if (!RunPending()) future.wait_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  template <typename T>
+  T Get(std::future<T>& future) {
+    Wait(future);
+    return future.get();
+  }
+
+  ExecutorStats Stats() const;
+
+ private:
+  void Post(std::function<void()> task);
+  bool IsWorker() const;
+  bool RunPending();
+
+  struct Impl;
+  std::shared_ptr<Impl> impl_;
+};  // class Executor
+
+}  // namespace minio::utils
+
+#endif  // MINIO_CPP_EXECUTOR_H_INCLUDED
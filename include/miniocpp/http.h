@@ -18,10 +18,15 @@
 #ifndef MINIO_CPP_HTTP_H_INCLUDED
 #define MINIO_CPP_HTTP_H_INCLUDED
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "error.h"
@@ -72,12 +77,20 @@ struct ProgressFunctionArgs;
 
 using ProgressFunction = std::function<bool(ProgressFunctionArgs)>;
 
+struct BodyFunctionArgs;
+
+using BodyFunction = std::function<bool(BodyFunctionArgs&)>;
+
 struct Response;
 
 struct DataFunctionArgs {
   Response* response = nullptr;
+  // Copy of the received bytes; left empty when the request is zero-copy.
   std::string datachunk;
   void* userdata = nullptr;
+  // View of the received bytes in the transport buffer, valid only for the
+  // duration of the call.
+  std::string_view data;
 
   DataFunctionArgs() = default;
   DataFunctionArgs(Response* response, void* userdata)
@@ -88,8 +101,26 @@ struct DataFunctionArgs {
         userdata(userdata) {}
 
   ~DataFunctionArgs() = default;
+
+  // Chunk returns the received bytes, whichever of data and datachunk holds
+  // them.
+  std::string_view Chunk() const {
+    return data.data() != nullptr ? data : std::string_view(datachunk);
+  }
 };  // struct DataFunctionArgs
 
+/**
+ * ReceiveBuffer is caller-owned memory a GET response body is written into
+ * directly, instead of being handed to a data function. received is set to
+ * the number of body bytes written, so a body shorter than size is reported
+ * rather than guessed; a body longer than size fails the request.
+ */
+struct ReceiveBuffer {
+  char* data = nullptr;
+  size_t size = 0;
+  size_t received = 0;
+};  // struct ReceiveBuffer
+
 struct ProgressFunctionArgs {
   double download_total_bytes = 0.0;
   double downloaded_bytes = 0.0;
@@ -100,13 +131,117 @@ struct ProgressFunctionArgs {
   void* userdata = nullptr;
 };  // struct ProgressFunctionArgs
 
+/**
+ * BodyFunctionArgs is one pull of a streamed request body. The body function
+ * writes the next bytes of the body into buffer, at least one and at most
+ * size, sets written and returns true; false aborts the request.
+ */
+struct BodyFunctionArgs {
+  char* buffer = nullptr;
+  size_t size = 0;
+  size_t offset = 0;  // Body bytes pulled before this call.
+  size_t written = 0;
+  void* userdata = nullptr;
+};  // struct BodyFunctionArgs
+
+// StreamBody returns a body function reading from stream, which must outlive
+// the request.
+BodyFunction StreamBody(std::istream& stream);
+
+/**
+ * ConnectionPool keeps idle keep-alive HTTP connections for reuse across
+ * requests, so back-to-back requests to the same endpoint skip the TCP (and
+ * TLS) handshake. Connections are keyed by scheme, host, port, outbound
+ * interface and TLS settings. It is thread-safe and may be shared by several
+ * clients.
+ */
+class ConnectionPool {
+ public:
+  static constexpr size_t kDefaultMaxIdlePerHost = 16;
+  static constexpr std::chrono::seconds kDefaultIdleTimeout{30};
+
+  explicit ConnectionPool(
+      size_t max_idle_per_host = kDefaultMaxIdlePerHost,
+      std::chrono::seconds idle_timeout = kDefaultIdleTimeout);
+  ~ConnectionPool();
+
+  ConnectionPool(const ConnectionPool&) = delete;
+  ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+  // SetMaxIdlePerHost limits idle connections kept per endpoint; 0 disables
+  // reuse.
+  void SetMaxIdlePerHost(size_t max_idle_per_host);
+
+  // SetIdleTimeout sets how long an idle connection is kept before eviction.
+  void SetIdleTimeout(std::chrono::seconds idle_timeout);
+
+  // IdleCount returns number of idle connections currently pooled.
+  size_t IdleCount() const;
+
+  // Clear closes all idle connections.
+  void Clear();
+
+ private:
+  friend struct Request;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};  // class ConnectionPool
+
+/**
+ * TlsContextCache shares TLS state between the HTTPS connections of a client.
+ * A CA bundle is parsed once per file instead of once per connection, and the
+ * most recent session of every endpoint is kept so a reconnect (e.g. after
+ * idle eviction from the ConnectionPool) resumes it through a session ticket
+ * or session ID with an abbreviated handshake. It is thread-safe and may be
+ * shared by several clients.
+ */
+class TlsContextCache {
+ public:
+  TlsContextCache();
+  ~TlsContextCache();
+
+  TlsContextCache(const TlsContextCache&) = delete;
+  TlsContextCache& operator=(const TlsContextCache&) = delete;
+
+  // FullHandshakes returns number of handshakes that negotiated a new session.
+  uint64_t FullHandshakes() const;
+
+  // ResumedHandshakes returns number of handshakes that resumed a session.
+  uint64_t ResumedHandshakes() const;
+
+  // Clear drops cached CA stores and sessions; connections already open keep
+  // theirs.
+  void Clear();
+
+ private:
+  friend struct Request;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};  // class TlsContextCache
+
+class Transport;
+
 struct Request {
   Method method;
   http::Url url;
   utils::Multimap headers;
   std::string_view body;
+  // Streamed PUT/POST body of body_size bytes, pulled from bodyfunc while it
+  // is sent instead of being held in body. Such a request is never resent,
+  // as the body cannot be rewound.
+  BodyFunction bodyfunc = nullptr;
+  void* body_userdata = nullptr;
+  size_t body_size = 0;
   DataFunction datafunc = nullptr;
   void* userdata = nullptr;
+  // Deliver response body chunks to datafunc only through
+  // DataFunctionArgs::data, without copying them into datachunk.
+  bool zero_copy = false;
+  // Write a 2xx GET body into this buffer; datafunc is not called. nullptr ==
+  // deliver the body to datafunc, or buffer it in Response::body.
+  ReceiveBuffer* buffer = nullptr;
   ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
   bool debug = false;
@@ -134,9 +269,25 @@ struct Request {
   long connect_timeout_secs = 0;
   long timeout_secs = 0;
 
+  // Connection pool to take a keep-alive connection from and return it to.
+  // nullptr == open a fresh connection for this request only.
+  std::shared_ptr<ConnectionPool> pool;
+
+  // TLS state cache for CA stores and session resumption of new https
+  // connections. nullptr == every connection loads its CA bundle and does a
+  // full handshake.
+  std::shared_ptr<TlsContextCache> tls_cache;
+
+  // Transport to run this request on. nullptr == a blocking cpp-httplib
+  // client on the calling thread, taken from pool.
+  std::shared_ptr<Transport> transport;
+
   Request(Method method, Url url);
   ~Request() = default;
 
+  // BodySize returns length of the request body, streamed or not.
+  size_t BodySize() const { return bodyfunc ? body_size : body.size(); }
+
   Response Execute();
 
   explicit operator bool() const {
@@ -166,6 +317,60 @@ struct Response {
   error::Error Error() const;
 };  // struct Response
 
+/**
+ * Transport runs HTTP requests for a client; see BaseClient::SetTransport.
+ * Implementations must honor the DataFunction, ProgressFunction and
+ * ReceiveBuffer contract of Request.
+ */
+class Transport {
+ public:
+  using Callback = std::function<void(Response)>;
+
+  Transport() = default;
+  virtual ~Transport() = default;
+
+  Transport(const Transport&) = delete;
+  Transport& operator=(const Transport&) = delete;
+
+  // Execute runs request and returns its response, blocking the caller.
+  virtual Response Execute(Request& request) = 0;
+
+  // Submit starts request and calls done with its response. The request
+  // body and receive buffer must stay valid until then, and done must not
+  // block. This default runs Execute() and done on the calling thread; a
+  // transport completing requests on threads of its own overrides it.
+  virtual void Submit(Request request, Callback done);
+};  // class Transport
+
+/**
+ * EventLoopTransport drives many requests per thread over non-blocking
+ * sockets on an epoll loop, with TLS through OpenSSL memory BIOs, instead of
+ * holding a thread per request. Each loop keeps its own keep-alive
+ * connections and TLS sessions; Request::pool and Request::tls_cache are not
+ * used. Data, progress and completion callbacks run on a loop thread and must
+ * not block it. An exception from a data or body function fails its request;
+ * completion callbacks must not throw, an exception escaping one calls
+ * std::terminate. Only available on Linux; elsewhere requests fail.
+ */
+class EventLoopTransport : public Transport {
+ public:
+  explicit EventLoopTransport(unsigned int threads = 1);
+  ~EventLoopTransport() override;
+
+  Response Execute(Request& request) override;
+
+  // Submit starts request and calls done with its response on a loop thread.
+  // The request body and receive buffer must stay valid until then.
+  void Submit(Request request, Callback done) override;
+
+  // Inflight returns number of submitted requests not yet completed.
+  size_t Inflight() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};  // class EventLoopTransport
+
 }  // namespace minio::http
 
 #endif  // MINIO_CPP_HTTP_H_INCLUDED
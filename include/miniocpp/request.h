@@ -18,11 +18,14 @@
 #ifndef MINIO_CPP_REQUEST_H_INCLUDED
 #define MINIO_CPP_REQUEST_H_INCLUDED
 
+#include <memory>
 #include <string>
 
 #include "error.h"
+#include "executor.h"
 #include "http.h"
 #include "providers.h"
+#include "types.h"
 #include "utils.h"
 
 namespace minio::s3 {
@@ -85,9 +88,23 @@ struct Request {
   std::string object_name;
 
   std::string_view body;
+  // Streamed body of body_size bytes, used instead of body; see
+  // http::Request::bodyfunc.
+  http::BodyFunction bodyfunc = nullptr;
+  void* body_userdata = nullptr;
+  size_t body_size = 0;
+
+  // How a PUT/POST body is signed, and the checksum sent with it. A caller
+  // set x-amz-content-sha256 header overrides payload_signing.
+  PayloadSigning payload_signing = PayloadSigning::kAuto;
+  ChecksumAlgorithm checksum = ChecksumAlgorithm::kNone;
+  // Hashes the chunks of a kStreaming body in parallel when set.
+  std::shared_ptr<utils::Executor> executor;
 
   http::DataFunction datafunc = nullptr;
   void* userdata = nullptr;
+  bool zero_copy = false;
+  http::ReceiveBuffer* buffer = nullptr;
 
   http::ProgressFunction progressfunc = nullptr;
   void* progress_userdata = nullptr;
@@ -107,6 +124,10 @@ struct Request {
   http::Request ToHttpRequest(creds::Provider* const provider = nullptr);
 
  private:
+  // aws-chunked encoding of the body, when BuildHeaders chose one.
+  http::BodyFunction chunked_body_ = nullptr;
+  size_t chunked_size_ = 0;
+
   void BuildHeaders(http::Url& url, creds::Provider* const provider);
 };  // struct Request
 
@@ -21,15 +21,17 @@
 #include <list>
 #include <map>
 #include <memory>
-#include <pugixml.hpp>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "error.h"
 #include "result.h"
 #include "types.h"
 #include "utils.h"
+#include "xml.h"
 
 namespace minio::s3 {
 
@@ -154,6 +156,23 @@ struct CompleteMultipartUploadResponse : public Response {
       std::string_view data, std::string version_id);
 };  // struct CompleteMultipartUploadResponse
 
+struct ListPartsResponse : public Response {
+  std::string upload_id;
+  unsigned int part_number_marker = 0;
+  unsigned int next_part_number_marker = 0;
+  unsigned int max_parts = 0;
+  bool is_truncated = false;
+  std::list<Part> parts;
+
+  ListPartsResponse() = default;
+
+  explicit ListPartsResponse(const Response& resp) : Response(resp) {}
+
+  ~ListPartsResponse() = default;
+
+  static Result<ListPartsResponse> ParseXML(std::string_view data);
+};  // struct ListPartsResponse
+
 struct CreateMultipartUploadResponse : public Response {
   std::string upload_id;
 
@@ -180,7 +199,14 @@ struct PutObjectResponse : public Response {
   explicit PutObjectResponse(const Response& resp) : Response(resp) {}
 
   explicit PutObjectResponse(const CompleteMultipartUploadResponse& resp)
-      : Response(resp), etag(resp.etag), version_id(resp.version_id) {}
+      : Response(resp),
+        etag(resp.etag),
+        version_id(resp.version_id),
+        checksumCRC32(resp.checksumCRC32),
+        checksumCRC32C(resp.checksumCRC32C),
+        checksumSHA1(resp.checksumSHA1),
+        checksumSHA256(resp.checksumSHA256),
+        checksum_crc64nvme(resp.checksum_crc64nvme) {}
 
   ~PutObjectResponse() = default;
 };  // struct PutObjectResponse
@@ -208,30 +234,43 @@ struct StatObjectResponse : public Response {
 
 MINIO_S3_DERIVE_FROM_RESPONSE(RemoveObjectResponse)
 MINIO_S3_DERIVE_FROM_RESPONSE(DownloadObjectResponse)
-MINIO_S3_DERIVE_FROM_RESPONSE(GetObjectResponse)
 
-struct Item : public Response {
-  // etag and name stored in owning ListObjectsResponse's owned_.
+struct GetObjectResponse : public Response {
+  // Number of body bytes written into GetObjectArgs::buf; less than
+  // GetObjectArgs::size when the object (or range) is shorter.
+  size_t size = 0;
+
+  GetObjectResponse() = default;
+  ~GetObjectResponse() = default;
+
+  GetObjectResponse(const GetObjectResponse&) = default;
+  GetObjectResponse& operator=(const GetObjectResponse&) = default;
+
+  GetObjectResponse(GetObjectResponse&&) = default;
+  GetObjectResponse& operator=(GetObjectResponse&&) = default;
+
+  explicit GetObjectResponse(const Response& resp) : Response(resp) {}
+};  // struct GetObjectResponse
+
+// Item is one entry of a listing page. Its strings are views into the page
+// buffer of the ListObjectsResponse it came from and live as long as it.
+struct Item {
   std::string_view etag;  // except DeleteMarker
   std::string_view name;
-  utils::UtcTime last_modified;
-  // Fields below point into owning ListObjectsResponse's xml_document memory.
   std::string_view owner_id;
   std::string_view owner_name;
-  size_t size = 0;  // except DeleteMarker
   std::string_view storage_class;
-  bool is_latest = false;       // except ListObjects V1/V2
   std::string_view version_id;  // except ListObjects V1/V2
-  std::map<std::string, std::string> user_metadata;
+  std::string_view encoding_type;
+  utils::UtcTime last_modified;
+  size_t size = 0;  // except DeleteMarker
+  std::vector<std::pair<std::string_view, std::string_view>> user_metadata;
+  bool is_latest = false;  // except ListObjects V1/V2
   bool is_prefix = false;
   bool is_delete_marker = false;
-  std::string_view encoding_type;
-
-  Item() = default;
-
-  explicit Item(const Response& resp) : Response(resp) {}
-
-  ~Item() = default;
+  // Set, with the other fields empty, on the last item of a listing that
+  // failed; the error message.
+  std::string_view error;
 };  // struct Item
 
 struct ListObjectsResponse : public Response {
@@ -240,21 +279,19 @@ struct ListObjectsResponse : public Response {
   std::string_view encoding_type;
   std::string_view prefix;
   std::string_view delimiter;
-  bool is_truncated;
-  unsigned int max_keys;
-  std::list<Item> contents;
+  bool is_truncated = false;
+  unsigned int max_keys = 0;
+  std::vector<Item> contents;
 
-  // Owned XML document for zero-copy string_view backing.
-  std::shared_ptr<pugi::xml_document> doc_;
-  // Owned strings for non-XML-assigned string_view backing storage.
-  std::list<std::string> owned_;
+  // The XML page, decoded in place, that the string_views point into.
+  std::shared_ptr<std::string> page_;
 
   // ListObjectsV1
   std::string_view marker;
   std::string_view next_marker;
 
   // ListObjectsV2
-  unsigned int key_count;
+  unsigned int key_count = 0;
   std::string_view start_after;
   std::string_view continuation_token;
   std::string_view next_continuation_token;
@@ -273,12 +310,14 @@ struct ListObjectsResponse : public Response {
 
   explicit ListObjectsResponse(const Response& resp) : Response(resp) {}
 
-  static Result<ListObjectsResponse> ParseXML(std::string_view data,
-                                              bool version);
+  // ParseXML keeps data as the page; pass the body with std::move to avoid
+  // copying it.
+  static Result<ListObjectsResponse> ParseXML(std::string data, bool version);
 };  // struct ListObjectsResponse
 
 MINIO_S3_DERIVE_FROM_PUT_OBJECT_RESPONSE(CopyObjectResponse)
 MINIO_S3_DERIVE_FROM_PUT_OBJECT_RESPONSE(ComposeObjectResponse)
+MINIO_S3_DERIVE_FROM_PUT_OBJECT_RESPONSE(TransferObjectResponse)
 MINIO_S3_DERIVE_FROM_PUT_OBJECT_RESPONSE(UploadObjectResponse)
 
 struct DeletedObject : public Response {
@@ -312,6 +351,10 @@ struct RemoveObjectsResponse : public Response {
   ~RemoveObjectsResponse() = default;
 
   static Result<RemoveObjectsResponse> ParseXML(std::string_view data);
+  // NewDecoder returns a decoder filling resp from a DeleteResult body fed
+  // in chunks as it arrives.
+  static std::unique_ptr<xml::Decoder<RemoveObjectsResponse>> NewDecoder(
+      RemoveObjectsResponse& resp);
 };  // struct RemoveObjectsResponse
 
 MINIO_S3_DERIVE_FROM_RESPONSE(SelectObjectContentResponse)
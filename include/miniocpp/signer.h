@@ -46,33 +46,99 @@ std::string GetAuthorization(const std::string& access_key,
                              const std::string& scope,
                              const std::string& signed_headers,
                              const std::string& signature);
-utils::Multimap SignV4(const std::string& service_name, http::Method method,
-                       const std::string& uri, const std::string& region,
-                       utils::Multimap& headers, utils::Multimap query_params,
-                       const std::string& access_key,
-                       const std::string& secret_key,
-                       const std::string& content_sha256,
-                       const utils::UtcTime& date);
-utils::Multimap SignV4S3(http::Method method, const std::string& uri,
-                         const std::string& region, utils::Multimap& headers,
-                         utils::Multimap query_params,
-                         const std::string& access_key,
-                         const std::string& secret_key,
-                         const std::string& content_sha256,
-                         const utils::UtcTime& date);
-utils::Multimap SignV4STS(http::Method method, const std::string& uri,
+// SignV4 adds the Authorization header to headers and returns them. The
+// signature is also stored in *signature when given, as the seed of a
+// chunk-signed body.
+utils::Multimap& SignV4(const std::string& service_name, http::Method method,
+                        const std::string& uri, const std::string& region,
+                        utils::Multimap& headers,
+                        const utils::Multimap& query_params,
+                        const std::string& access_key,
+                        const std::string& secret_key,
+                        const std::string& content_sha256,
+                        const utils::UtcTime& date,
+                        std::string* signature = nullptr);
+utils::Multimap& SignV4S3(http::Method method, const std::string& uri,
                           const std::string& region, utils::Multimap& headers,
-                          utils::Multimap query_params,
+                          const utils::Multimap& query_params,
                           const std::string& access_key,
                           const std::string& secret_key,
                           const std::string& content_sha256,
-                          const utils::UtcTime& date);
+                          const utils::UtcTime& date,
+                          std::string* signature = nullptr);
+utils::Multimap& SignV4STS(http::Method method, const std::string& uri,
+                           const std::string& region, utils::Multimap& headers,
+                           const utils::Multimap& query_params,
+                           const std::string& access_key,
+                           const std::string& secret_key,
+                           const std::string& content_sha256,
+                           const utils::UtcTime& date);
 utils::Multimap PresignV4(http::Method method, const std::string& host,
                           const std::string& uri, const std::string& region,
                           utils::Multimap& query_params,
                           const std::string& access_key,
                           const std::string& secret_key,
                           const utils::UtcTime& date, unsigned int expires);
+
+/**
+ * Presigner presigns many URLs sharing one host, region, credential, date and
+ * expiry. The scope, signing key and common canonical query parameters are
+ * computed once, so each Sign() call costs one SHA-256 and one HMAC-SHA256
+ * and reuses its buffers.
+ */
+class Presigner {
+ private:
+  std::string host_;
+  std::string signing_key_;
+  std::string string_to_sign_prefix_;
+  std::string query_before_version_;
+  std::string query_after_version_;
+  std::string buffer_;
+
+ public:
+  Presigner(const std::string& host, const std::string& region,
+            const utils::Multimap& query_params,
+            const std::string& access_key, const std::string& secret_key,
+            const utils::UtcTime& date, unsigned int expires);
+  ~Presigner() = default;
+
+  // Sign writes the presigned query string of uri, with an optional
+  // versionId, into query_string.
+  void Sign(http::Method method, const std::string& uri,
+            const std::string& version_id, std::string& query_string);
+};  // class Presigner
+
+/**
+ * ChunkSigner signs the chunks of an aws-chunked
+ * STREAMING-AWS4-HMAC-SHA256-PAYLOAD body as they are sent. Each signature
+ * chains from the previous one, starting at the seed signature of the
+ * request headers; the last chunk is empty and may be followed by a signed
+ * trailer.
+ */
+class ChunkSigner {
+ private:
+  std::string signing_key_;
+  std::string date_scope_;  // "<amz-date>\n<scope>\n"
+  std::string previous_;
+  std::string buffer_;
+
+ public:
+  ChunkSigner(const std::string& secret_key, const utils::UtcTime& date,
+              const std::string& region, std::string seed_signature);
+  ~ChunkSigner() = default;
+
+  // Sign returns the signature of the next chunk.
+  const std::string& Sign(std::string_view chunk);
+
+  // SignHash is Sign of a chunk whose hex SHA-256 is chunk_sha256, for
+  // chunks hashed ahead of signing.
+  const std::string& SignHash(std::string_view chunk_sha256);
+
+  // SignTrailer returns the signature of trailer, the trailing headers as
+  // "name:value\n" lines, sent after the last chunk.
+  const std::string& SignTrailer(std::string_view trailer);
+};  // class ChunkSigner
+
 std::string PostPresignV4(const std::string& data,
                           const std::string& secret_key,
                           const utils::UtcTime& date,
@@ -0,0 +1,112 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MINIO_CPP_STATCACHE_H_INCLUDED
+#define MINIO_CPP_STATCACHE_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "response.h"
+
+namespace minio::s3 {
+
+struct StatCacheStats {
+  uint64_t hits = 0;           // Lookups answered by an unexpired entry.
+  uint64_t misses = 0;         // Lookups without an entry.
+  uint64_t revalidations = 0;  // Expired entries checked with If-None-Match.
+  uint64_t not_modified = 0;   // Revalidations the server answered with 304.
+  uint64_t evictions = 0;      // Entries dropped for the size bound.
+  uint64_t invalidations = 0;  // Invalidate() calls, e.g. by object writes.
+  size_t entries = 0;          // Entries currently cached.
+};  // struct StatCacheStats
+
+/**
+ * StatCache keeps StatObject responses by bucket, object and version ID, so
+ * repeated stats of an object skip the HEAD request. An entry is used as is
+ * for the TTL after it was fetched; after that it is revalidated with an
+ * If-None-Match request, which the server answers with 304 while the object
+ * is unchanged, or it is dropped if revalidation is off. The least recently
+ * used entries are dropped beyond max_entries. A client invalidates the
+ * entries of an object on each of its own writes to it; writes by others are
+ * seen once the TTL has passed. Stats with SSE-C, conditions, a range or
+ * extra headers or query parameters bypass the cache. It is thread-safe and
+ * may be shared by several clients of the same endpoint.
+ */
+class StatCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 10000;
+  static constexpr std::chrono::seconds kDefaultTtl{60};
+
+  explicit StatCache(size_t max_entries = kDefaultMaxEntries,
+                     std::chrono::seconds ttl = kDefaultTtl);
+  ~StatCache();
+
+  StatCache(const StatCache&) = delete;
+  StatCache& operator=(const StatCache&) = delete;
+
+  // SetMaxEntries bounds the number of entries kept.
+  void SetMaxEntries(size_t max_entries);
+
+  // SetTtl sets how long an entry is used without asking the server; 0
+  // revalidates on every lookup.
+  void SetTtl(std::chrono::seconds ttl);
+
+  // SetRevalidate chooses whether an expired entry is revalidated (the
+  // default) or dropped.
+  void SetRevalidate(bool revalidate);
+
+  // Invalidate drops the entries of all versions of object.
+  void Invalidate(const std::string& bucket, const std::string& object);
+
+  // Clear drops all entries.
+  void Clear();
+
+  StatCacheStats Stats() const;
+
+ private:
+  friend class BaseClient;
+
+  enum class Lookup { kHit, kStale, kMiss };
+
+  // Find copies the entry of the version of object into resp. kStale means
+  // it has expired and is to be revalidated. generation is to be passed back
+  // to Store() or Refresh(), which ignore the response if the object was
+  // invalidated after the lookup.
+  Lookup Find(const std::string& bucket, const std::string& object,
+              const std::string& version_id, StatObjectResponse& resp,
+              uint64_t& generation);
+
+  // Store caches resp unless the object was invalidated since generation.
+  void Store(const std::string& bucket, const std::string& object,
+             const std::string& version_id, const StatObjectResponse& resp,
+             uint64_t generation);
+
+  // Refresh restarts the TTL of an entry the server reported unchanged.
+  void Refresh(const std::string& bucket, const std::string& object,
+               const std::string& version_id, uint64_t generation);
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};  // class StatCache
+
+}  // namespace minio::s3
+
+#endif  // MINIO_CPP_STATCACHE_H_INCLUDED
@@ -31,6 +31,7 @@
 #include <type_traits>
 
 #include "error.h"
+#include "http.h"
 #include "utils.h"
 
 namespace minio::s3 {
@@ -192,6 +193,75 @@ constexpr const char* QuoteFieldsToString(QuoteFields qtype) noexcept {
   return nullptr;
 }
 
+enum class ChecksumAlgorithm { kNone, kCrc32c, kCrc64Nvme };
+
+// ChecksumAlgorithmToString converts checksum algorithm enum to the name used
+// in x-amz-checksum-algorithm; kNone is empty.
+constexpr const char* ChecksumAlgorithmToString(
+    ChecksumAlgorithm algorithm) noexcept {
+  switch (algorithm) {
+    case ChecksumAlgorithm::kNone:
+      return "";
+    case ChecksumAlgorithm::kCrc32c:
+      return "CRC32C";
+    case ChecksumAlgorithm::kCrc64Nvme:
+      return "CRC64NVME";
+    default: {
+      std::cerr << "ABORT: Unknown checksum algorithm. This should not happen."
+                << std::endl;
+      std::terminate();
+    }
+  }
+  return nullptr;
+}
+
+// ChecksumHeaderName returns the x-amz-checksum-* header carrying a checksum
+// of algorithm.
+std::string ChecksumHeaderName(ChecksumAlgorithm algorithm);
+
+/**
+ * Checksum is a running checksum of the data fed to it, in order. Base64()
+ * encodes its big-endian bytes the way S3 sends checksums in headers and
+ * XML.
+ */
+class Checksum {
+ private:
+  ChecksumAlgorithm algorithm_;
+  uint64_t crc_ = 0;
+
+ public:
+  explicit Checksum(ChecksumAlgorithm algorithm) : algorithm_(algorithm) {}
+  ~Checksum() = default;
+
+  ChecksumAlgorithm Algorithm() const { return algorithm_; }
+  void Update(const char* data, size_t len);
+  std::string Base64() const;
+
+  // Verify compares the checksum with the full-object one in the headers of
+  // an object response, if they carry one.
+  error::Error Verify(const utils::Multimap& headers) const;
+};  // class Checksum
+
+/**
+ * PayloadSigning selects how an upload body is covered by the request
+ * signature. With a ChecksumAlgorithm, a buffered body sends its checksum as
+ * a header; a streamed or aws-chunked body sends it as a trailer computed
+ * while the body is sent.
+ */
+enum class PayloadSigning {
+  // SHA-256 of a buffered body. A streamed body is sent UNSIGNED-PAYLOAD over
+  // https and as kStreaming over http.
+  kAuto,
+  // UNSIGNED-PAYLOAD; the body is not hashed.
+  kUnsigned,
+  // STREAMING-AWS4-HMAC-SHA256-PAYLOAD: aws-chunked, each chunk signed as it
+  // is sent, so nothing is hashed up front.
+  kStreaming,
+  // STREAMING-UNSIGNED-PAYLOAD-TRAILER: aws-chunked and unsigned, with a
+  // trailing checksum (CRC64NVME unless another is chosen).
+  kUnsignedTrailer,
+};
+
 struct CsvInputSerialization {
   std::shared_ptr<CompressionType> compression_type;
   bool allow_quoted_record_delimiter = false;
@@ -333,6 +403,7 @@ struct Part {
   utils::UtcTime last_modified = {};
   size_t size = 0;
   std::string checksum_crc64nvme;
+  std::string checksum_crc32c;
 
   Part() = default;
   explicit Part(unsigned int number, std::string etag)
@@ -363,6 +434,18 @@ struct DeleteObject {
   ~DeleteObject() = default;
 };  // struct DeleteObject
 
+struct PresignObject {
+  std::string name = {};
+  std::string version_id = {};
+  http::Method method = http::Method::kGet;
+
+  PresignObject() = default;
+  explicit PresignObject(std::string object_name,
+                         http::Method method = http::Method::kGet)
+      : name(std::move(object_name)), method(method) {}
+  ~PresignObject() = default;
+};  // struct PresignObject
+
 struct NotificationRecord {
   std::string event_version;
   std::string event_source;
@@ -39,6 +39,8 @@
 
 namespace minio::utils {
 
+class Executor;
+
 // path::u8string() returns std::string in C++17 but std::u8string in C++20;
 // normalize to std::string so callers work under both standards.
 inline std::string PathToUtf8(const std::filesystem::path& p) {
@@ -119,12 +121,27 @@ std::string EncodePath(const std::string& path);
 // XMLEncode does XML encoding of value.
 std::string XMLEncode(const std::string& value);
 
+// XMLEncodeTo appends the XML encoding of value to out.
+void XMLEncodeTo(std::string& out, std::string_view value);
+
 // Sha256hash computes SHA-256 of data and return hash as hex encoded value.
+// The digest context is kept per thread and reused between calls; OpenSSL
+// picks the SHA extensions of the CPU (SHA-NI, ARMv8 crypto) when present.
 std::string Sha256Hash(std::string_view str);
 
+// Sha256HashAll returns Sha256Hash of each of buffers, hashing them in
+// parallel on executor when one is given. The calling thread hashes what no
+// worker has picked up, so it need not be a worker and never waits on busy
+// ones.
+std::vector<std::string> Sha256HashAll(
+    const std::vector<std::string_view>& buffers, Executor* executor);
+
 // Base64Encode encodes string to base64.
 std::string Base64Encode(std::string_view str);
 
+// Base64Decode decodes base64 string; invalid input yields an empty string.
+std::string Base64Decode(std::string_view str);
+
 // Md5sumHash computes MD5 of data and return hash as Base64 encoded value.
 std::string Md5sumHash(std::string_view str);
 
@@ -132,12 +149,37 @@ std::string Md5sumHash(std::string_view str);
 // (polynomial 0xad93d23594c93659, reflected, init/xor 0xffffffffffffffff)
 // of `data`/`len` and returns the 8-byte raw value. Used to populate the
 // per-part `x-amz-checksum-crc64nvme` header on RDMA multipart uploads.
-uint64_t Crc64Nvme(const char* data, size_t len);
+// Pass the CRC of the preceding bytes as `crc` to continue a running
+// checksum. Uses the carry-less multiply instructions of the CPU (PCLMULQDQ
+// on x86-64, PMULL on ARMv8) when present, and slice-by-8 tables otherwise.
+uint64_t Crc64Nvme(const char* data, size_t len, uint64_t crc = 0);
+
+// Crc64NvmePortable is Crc64Nvme always computed with the slice-by-8 tables.
+uint64_t Crc64NvmePortable(const char* data, size_t len, uint64_t crc = 0);
+
+// Crc64NvmeKernel names the implementation Crc64Nvme uses on this CPU:
+// "pclmulqdq", "pmull" or "slice-by-8".
+const char* Crc64NvmeKernel();
+
+// Crc64NvmeCombine returns the Crc64Nvme of A followed by B from crc1 of A,
+// crc2 of B and the length of B, without reading either.
+uint64_t Crc64NvmeCombine(uint64_t crc1, uint64_t crc2, uint64_t len2);
+
+// Crc32c computes the CRC-32C (Castagnoli, polynomial 0x1edc6f41, reflected)
+// of `data`/`len`, continuing from `crc` like Crc64Nvme.
+uint32_t Crc32c(const char* data, size_t len, uint32_t crc = 0);
 
 // Crc64NvmeBase64 returns the Crc64Nvme of `data`/`len` encoded as the
 // 12-character base64 string the S3 RDMA UploadPart protocol expects.
 std::string Crc64NvmeBase64(const char* data, size_t len);
 
+// Crc64NvmeBase64 encodes a CRC-64/NVME value like the above.
+std::string Crc64NvmeBase64(uint64_t crc);
+
+// ParseCrc64NvmeBase64 decodes a value encoded by Crc64NvmeBase64 into crc;
+// false if value is not one.
+bool ParseCrc64NvmeBase64(std::string_view value, uint64_t& crc);
+
 error::Error CheckBucketName(std::string_view bucket_name, bool strict = false);
 error::Error ReadPart(std::istream& stream, char* buf, size_t size,
                       size_t& bytes_read);
@@ -210,12 +252,27 @@ class UtcTime {
 };  // class UtcTime
 
 /**
- * Multimap represents dictionary of keys and their multiple values.
+ * Multimap represents dictionary of keys and their multiple values. Keys are
+ * case-insensitive for lookup; entries are kept in one flat vector sorted by
+ * key and value, each with its lower-cased key computed once on Add().
  */
 class Multimap {
+ public:
+  struct Entry {
+    std::string key;
+    std::string lower_key;
+    std::string value;
+  };  // struct Entry
+
+  using const_iterator = std::vector<Entry>::const_iterator;
+
  private:
-  std::map<std::string, std::set<std::string>> map_;
-  std::map<std::string, std::set<std::string>> keys_;
+  // Typical request carries about a dozen headers; reserve once for them.
+  static constexpr size_t kInitialCapacity = 16;
+
+  std::vector<Entry> entries_;
+
+  void Insert(Entry entry);
 
  public:
   Multimap() = default;
@@ -233,7 +290,11 @@ class Multimap {
 
   std::string ToQueryString() const;
 
-  explicit operator bool() const { return !map_.empty(); }
+  explicit operator bool() const { return !entries_.empty(); }
+
+  // Iterates entries ordered by key, then value.
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
 
   bool Contains(std::string_view key) const;
 
@@ -243,10 +304,15 @@ class Multimap {
 
   std::list<std::string> Keys() const;
 
+  // GetCanonicalHeaders appends SigV4 signed headers and canonical headers,
+  // ordered by lower-cased key, to the given buffers.
   void GetCanonicalHeaders(std::string& signed_headers,
                            std::string& canonical_headers) const;
 
   std::string GetCanonicalQueryString() const;
+
+  // GetCanonicalQueryString appends SigV4 canonical query string to buffer.
+  void GetCanonicalQueryString(std::string& buffer) const;
 };  // class Multimap
 
 /**
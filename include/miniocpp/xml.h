@@ -0,0 +1,210 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MINIO_CPP_XML_H_INCLUDED
+#define MINIO_CPP_XML_H_INCLUDED
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "error.h"
+
+namespace minio::xml {
+
+/**
+ * Reader is a pull parser over an XML document. Each call to Next() returns
+ * the next event. It reads either a complete document in a writable buffer,
+ * or a document fed in chunks as it arrives, keeping only the bytes not yet
+ * parsed. Entity and character references are decoded in place. It reads
+ * the subset of XML used by S3 responses: elements, character data and
+ * CDATA sections. Attributes, comments, processing instructions and the
+ * DOCTYPE are skipped.
+ *
+ * Name(), Text() and Path() are valid until the next call to Next() or
+ * Feed(). For a buffer given to the constructor, Text() and the Name() of a
+ * kStart event stay valid as long as the buffer.
+ */
+class Reader {
+ public:
+  enum class Event { kStart, kText, kEnd, kEof, kMore, kError };
+
+  // Reader over the complete document in data.
+  Reader(char* data, size_t size);
+  // Reader over a document given to Feed() and ended by Close().
+  Reader();
+
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  // Feed appends the next bytes of the document.
+  void Feed(std::string_view data);
+  // Close marks the end of the document.
+  void Close();
+
+  // Next returns the next event, or kMore when the bytes fed so far end
+  // before it. An empty element yields kStart and kEnd without kText;
+  // whitespace between elements is reported as text.
+  Event Next();
+
+  // Name is the element started or ended, or the one enclosing the text.
+  std::string_view Name() const { return name_; }
+  // Text is the character data of a kText event.
+  std::string_view Text() const { return text_; }
+  // Depth is the depth of Name(); the document element is at depth 1.
+  size_t Depth() const { return offsets_.size(); }
+  // Path is the slash-separated path of Name() from the document element.
+  std::string_view Path() const { return path_; }
+  // Path of Name() below its ancestor at depth, e.g. "Owner/ID" for depth 2
+  // of "ListBucketResult/Contents/Owner/ID"; empty if it is not below.
+  std::string_view Path(size_t depth) const;
+  // Error tells why Next() returned kError.
+  const char* Error() const { return error_; }
+
+ private:
+  std::string buffer_;  // Bytes fed and not yet parsed.
+  bool closed_ = false;
+  char* pos_ = nullptr;
+  char* end_ = nullptr;
+  std::string path_;             // Path of the open elements.
+  std::vector<size_t> offsets_;  // Offset of each open element in path_.
+  std::string_view name_;
+  std::string_view text_;
+  bool close_ = false;  // The element started last was self-closing.
+  bool pop_ = false;    // The element ended last is still in path_.
+  bool has_root_ = false;
+  const char* error_ = nullptr;
+
+  Event Fail(const char* error);
+  Event Incomplete(const char* error);
+  char* Find(char* from, std::string_view terminator) const;
+  std::string_view Decode(char* begin, char* end);
+  void Push(std::string_view name);
+};  // class Reader
+
+/**
+ * Field maps an element, by its path below the element a table of fields
+ * is applied to, to what is done with it: text is called with its
+ * character data, start when it starts and end when it ends. Any of them may
+ * be null. The empty path is the element the table is applied to. Tables of
+ * fields are constexpr arrays, e.g.
+ *
+ *   constexpr xml::Field<Bucket> kBucketFields[] = {
+ *       {"Name", [](Bucket& b, std::string_view v) { b.name = v; }},
+ *   };
+ */
+template <typename T>
+struct Field {
+  std::string_view path;
+  void (*text)(T&, std::string_view) = nullptr;
+  void (*start)(T&) = nullptr;
+  void (*end)(T&) = nullptr;
+};  // struct Field
+
+// Apply hands the kStart, kText or kEnd event of reader to the field of
+// fields, count long, whose path matches the path of the event below depth;
+// false if none does.
+template <typename T>
+bool Apply(const Field<T>* fields, size_t count, const Reader& reader,
+           size_t depth, T& target, Reader::Event event) {
+  std::string_view path = reader.Path(depth);
+  for (const Field<T>* field = fields; field != fields + count; ++field) {
+    if (field->path != path) continue;
+    if (event == Reader::Event::kText && field->text != nullptr) {
+      field->text(target, reader.Text());
+    } else if (event == Reader::Event::kStart && field->start != nullptr) {
+      field->start(target);
+    } else if (event == Reader::Event::kEnd && field->end != nullptr) {
+      field->end(target);
+    }
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Decoder fills target from a document through a table of fields applied
+ * to the document element, which must be named root; otherwise nothing is
+ * set. The document may be fed in chunks as it arrives.
+ */
+template <typename T>
+class Decoder {
+ public:
+  template <size_t N>
+  Decoder(std::string_view root, const Field<T> (&fields)[N], T& target)
+      : root_(root), fields_(fields), count_(N), target_(target) {}
+
+  // Feed parses the next chunk of the document; false once it is malformed.
+  bool Feed(std::string_view chunk) {
+    reader_.Feed(chunk);
+    return Run();
+  }
+
+  // Matched tells whether the document element read so far is named root.
+  bool Matched() const { return matched_; }
+
+  // Finish parses the rest of the document and reports whether it was
+  // complete and well-formed.
+  error::Error Finish() {
+    reader_.Close();
+    if (Run()) return error::SUCCESS;
+    return error::Error(std::string("unable to parse XML; ") +
+                        reader_.Error());
+  }
+
+ private:
+  Reader reader_;
+  std::string_view root_;
+  const Field<T>* fields_;
+  size_t count_;
+  T& target_;
+  bool matched_ = false;
+
+  bool Run() {
+    while (true) {
+      Reader::Event event = reader_.Next();
+      switch (event) {
+        case Reader::Event::kMore:
+        case Reader::Event::kEof:
+          return true;
+        case Reader::Event::kError:
+          return false;
+        case Reader::Event::kStart:
+          if (reader_.Depth() == 1) matched_ = reader_.Name() == root_;
+          [[fallthrough]];
+        case Reader::Event::kText:
+        case Reader::Event::kEnd:
+          if (matched_) Apply(fields_, count_, reader_, 1, target_, event);
+          break;
+      }
+    }
+  }
+};  // class Decoder
+
+// Decode fills target from the complete document data; see Decoder.
+template <typename T, size_t N>
+error::Error Decode(std::string_view data, std::string_view root,
+                    const Field<T> (&fields)[N], T& target) {
+  Decoder<T> decoder(root, fields, target);
+  decoder.Feed(data);
+  return decoder.Finish();
+}
+
+}  // namespace minio::xml
+
+#endif  // MINIO_CPP_XML_H_INCLUDED
@@ -193,6 +193,20 @@ error::Error UploadPartArgs::Validate() const {
   return error::SUCCESS;
 }
 
+error::Error ListPartsArgs::Validate() const {
+  if (error::Error err = ObjectArgs::Validate()) {
+    return err;
+  }
+  if (!utils::CheckNonEmptyString(upload_id)) {
+    return error::Error("upload ID cannot be empty");
+  }
+  if (max_parts < 1 || max_parts > 1000) {
+    return error::Error("max parts must be between 1 and 1000");
+  }
+
+  return error::SUCCESS;
+}
+
 error::Error UploadPartCopyArgs::Validate() const {
   if (error::Error err = ObjectArgs::Validate()) {
     return err;
@@ -438,6 +452,25 @@ error::Error ComposeObjectArgs::Validate() const {
   return error::SUCCESS;
 }
 
+error::Error TransferObjectArgs::Validate() const {
+  if (error::Error err = ObjectArgs::Validate()) {
+    return err;
+  }
+  if (error::Error err = source.Validate()) {
+    return err;
+  }
+  if (part_size > 0 && part_size < utils::kMinPartSize) {
+    return error::Error("part size " + std::to_string(part_size) +
+                        " is not supported; minimum allowed 5MiB");
+  }
+  if (part_size > utils::kMaxPartSize) {
+    return error::Error("part size " + std::to_string(part_size) +
+                        " is not supported; maximum allowed 5GiB");
+  }
+
+  return error::SUCCESS;
+}
+
 error::Error UploadObjectArgs::Validate() {
   if (error::Error err = ObjectArgs::Validate()) {
     return err;
@@ -617,6 +650,27 @@ error::Error GetPresignedObjectUrlArgs::Validate() const {
   return error::SUCCESS;
 }
 
+error::Error GetPresignedObjectUrlsArgs::Validate() const {
+  if (error::Error err = BucketArgs::Validate()) {
+    return err;
+  }
+  for (const auto& object : objects) {
+    if (!utils::CheckNonEmptyString(object.name)) {
+      return error::Error("object name cannot be empty");
+    }
+    if (object.method < http::Method::kGet ||
+        object.method > http::Method::kDelete) {
+      return error::Error("valid HTTP method must be provided");
+    }
+  }
+  if (expiry_seconds < 1 || expiry_seconds > kDefaultExpirySeconds) {
+    return error::Error("expiry seconds must be between 1 and " +
+                        std::to_string(kDefaultExpirySeconds));
+  }
+
+  return error::SUCCESS;
+}
+
 error::Error PostPolicy::AddEqualsCondition(std::string element,
                                             std::string value) {
   if (element.empty()) {
@@ -24,14 +24,19 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <ostream>
-#include <pugixml.hpp>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "miniocpp/args.h"
 #include "miniocpp/config.h"
@@ -45,6 +50,7 @@
 #include "miniocpp/signer.h"
 #include "miniocpp/types.h"
 #include "miniocpp/utils.h"
+#include "miniocpp/xml.h"
 
 #ifdef MINIO_CPP_RDMA
 #include "miniocpp/rdma.h"
@@ -58,6 +64,63 @@
 
 namespace minio::s3 {
 
+namespace {
+
+constexpr xml::Field<std::string> kLocationConstraintFields[] = {
+    {"", [](std::string& s, std::string_view v) { s = v; }},
+};
+
+constexpr xml::Field<std::string> kInitiateMultipartUploadFields[] = {
+    {"UploadId", [](std::string& s, std::string_view v) { s = v; }},
+};
+
+// An element that is present sets the flag, enabled or not.
+constexpr xml::Field<GetBucketVersioningResponse> kVersioningFields[] = {
+    {"Status",
+     [](GetBucketVersioningResponse& r, std::string_view v) {
+       r.status = v == "Enabled";
+     },
+     [](GetBucketVersioningResponse& r) { r.status = false; }},
+    {"MFADelete",
+     [](GetBucketVersioningResponse& r, std::string_view v) {
+       r.mfa_delete = v == "Enabled";
+     },
+     [](GetBucketVersioningResponse& r) { r.mfa_delete = false; }},
+};
+
+constexpr xml::Field<ObjectLockConfig> kObjectLockFields[] = {
+    {"Rule/DefaultRetention/Mode",
+     [](ObjectLockConfig& c, std::string_view v) {
+       c.retention_mode = StringToRetentionMode(v);
+     }},
+    {"Rule/DefaultRetention/Days",
+     [](ObjectLockConfig& c, std::string_view v) {
+       c.retention_duration_days = Integer(std::stoi(std::string(v)));
+     }},
+    {"Rule/DefaultRetention/Years",
+     [](ObjectLockConfig& c, std::string_view v) {
+       c.retention_duration_years = Integer(std::stoi(std::string(v)));
+     }},
+};
+
+constexpr xml::Field<GetObjectRetentionResponse> kRetentionFields[] = {
+    {"Mode",
+     [](GetObjectRetentionResponse& r, std::string_view v) {
+       r.retention_mode = StringToRetentionMode(v);
+     }},
+    {"RetainUntilDate",
+     [](GetObjectRetentionResponse& r, std::string_view v) {
+       r.retain_until_date =
+           utils::UtcTime::FromISO8601UTC(std::string(v).c_str());
+     }},
+};
+
+constexpr xml::Field<std::string> kLegalHoldFields[] = {
+    {"Status", [](std::string& s, std::string_view v) { s = v; }},
+};
+
+}  // namespace
+
 utils::Multimap GetCommonListObjectsQueryParams(
     const std::string& delimiter, const std::string& encoding_type,
     unsigned int max_keys, const std::string& prefix) {
@@ -69,6 +132,56 @@ utils::Multimap GetCommonListObjectsQueryParams(
   return query_params;
 }
 
+// Call is an API call prepared for Run() or RunAsync(): its request, built
+// without the region, and finish, which turns the response into the result.
+// result is set instead when the call is answered without a request, e.g. on
+// invalid arguments or a stat cache hit.
+template <typename T>
+struct BaseClient::Call {
+  std::optional<Result<T>> result;
+  std::string region;  // Region argument, resolved by GetRegion().
+  std::shared_ptr<Request> req;
+  std::function<Result<T>(Result<Response>)> finish;
+
+  Call() = default;
+  Call(Result<T> result) : result(std::move(result)) {}
+  Call(tl::unexpected<error::Error> err) : result(std::move(err)) {}
+};  // struct BaseClient::Call
+
+template <typename T>
+Result<T> BaseClient::Run(Call<T> call) {
+  if (call.result) return std::move(*call.result);
+
+  auto get_resp = GetRegion(call.req->bucket_name, call.region);
+  if (!get_resp) return tl::make_unexpected(get_resp.error());
+  call.req->region = get_resp->region;
+  return call.finish(Execute(*call.req));
+}
+
+template <typename T>
+void BaseClient::RunAsync(Call<T> call, std::function<void(Result<T>)> done) {
+  if (call.result) {
+    done(std::move(*call.result));
+    return;
+  }
+
+  auto req = call.req;
+  GetRegionAsync(
+      req->bucket_name, call.region,
+      [this, req, finish = std::move(call.finish),
+       done = std::move(done)](Result<GetRegionResponse> get_resp) mutable {
+        if (!get_resp) {
+          done(tl::make_unexpected(get_resp.error()));
+          return;
+        }
+        req->region = get_resp->region;
+        ExecuteAsync(req, [finish = std::move(finish), done = std::move(done)](
+                              Result<Response> resp) {
+          done(finish(std::move(resp)));
+        });
+      });
+}
+
 BaseClient::BaseClient(BaseUrl base_url, creds::Provider* provider)
     : base_url_(std::move(base_url)), provider_(provider) {
   if (!base_url_) {
@@ -159,6 +272,9 @@ Result<Response> BaseClient::GetErrorResponse(
 
   // Format the error message based on status code.
   switch (resp.status_code) {
+    case 304:
+      return tl::make_unexpected(
+          error::Error("NotModified: Object not modified"));
     case 301:
     case 307:
     case 400: {
@@ -206,13 +322,31 @@ Result<Response> BaseClient::GetErrorResponse(
   }
 }
 
-Result<Response> BaseClient::execute(Request& req) {
+http::Request BaseClient::NewHttpRequest(Request& req) {
   req.user_agent = user_agent_;
   req.ignore_cert_check = ignore_cert_check_;
   if (!ssl_cert_file_.empty()) req.ssl_cert_file = ssl_cert_file_;
+  req.executor = executor_;
   http::Request request = req.ToHttpRequest(provider_);
   request.debug = debug_;
-  http::Response response = request.Execute();
+  request.pool = connection_pool_;
+  request.tls_cache = tls_context_cache_;
+  request.transport = transport_;
+  return request;
+}
+
+Result<Response> BaseClient::HandleResponse(Request& req,
+                                            std::string_view resource,
+                                            http::Response response) {
+  // A write of this client, even a failed one, may have changed the object.
+  // Of the multipart upload calls only CompleteMultipartUpload does.
+  if (stat_cache_ != nullptr && !req.object_name.empty() &&
+      req.method != http::Method::kGet && req.method != http::Method::kHead &&
+      !req.query_params.Contains("uploads") &&
+      (req.method == http::Method::kPost ||
+       !req.query_params.Contains("uploadId"))) {
+    stat_cache_->Invalidate(req.bucket_name, req.object_name);
+  }
   if (response) {
     Response resp;
     resp.status_code = response.status_code;
@@ -221,7 +355,7 @@ Result<Response> BaseClient::execute(Request& req) {
     return resp;
   }
 
-  auto err = GetErrorResponse(response, request.url.path, req.method,
+  auto err = GetErrorResponse(std::move(response), resource, req.method,
                               req.bucket_name, req.object_name);
   if (!err) {
     std::string err_str = err.error().String();
@@ -234,6 +368,55 @@ Result<Response> BaseClient::execute(Request& req) {
   return err;
 }
 
+Result<Response> BaseClient::execute(Request& req) {
+  http::Request request = NewHttpRequest(req);
+  return HandleResponse(req, request.url.path, request.Execute());
+}
+
+void BaseClient::executeAsync(std::shared_ptr<Request> req, bool retried,
+                              std::function<void(Result<Response>)> done) {
+  http::Request request = NewHttpRequest(*req);
+  request.transport = nullptr;
+  std::string resource = request.url.path;
+  transport_->Submit(
+      std::move(request),
+      [this, req = std::move(req), retried, resource = std::move(resource),
+       done = std::move(done)](http::Response response) mutable {
+        auto resp = HandleResponse(*req, resource, std::move(response));
+        // Retry only once on RetryHead error, as Execute() does.
+        if (!resp && !retried && resp.error().String() == "RetryHead") {
+          executeAsync(std::move(req), true, std::move(done));
+          return;
+        }
+        done(std::move(resp));
+      });
+}
+
+void BaseClient::ExecuteAsync(std::shared_ptr<Request> req,
+                              std::function<void(Result<Response>)> done) {
+  if (transport_ != nullptr) {
+    executeAsync(std::move(req), false, std::move(done));
+    return;
+  }
+  // The cpp-httplib path blocks, so it runs on a worker instead of the
+  // caller. An exception from a data or body function fails the request, as
+  // on an EventLoopTransport, since done is the only way out.
+  auto run = [this, req, done]() {
+    Result<Response> resp;
+    try {
+      resp = Execute(*req);
+    } catch (const std::exception& e) {
+      resp = error::make<Response>(std::string("HTTP error: ") + e.what());
+    }
+    done(std::move(resp));
+  };
+  try {
+    (void)executor_->Submit(run);
+  } catch (const std::system_error&) {
+    run();
+  }
+}
+
 Result<Response> BaseClient::Execute(Request& req) {
   auto exec_resp = execute(req);
   if (exec_resp) return exec_resp;
@@ -247,8 +430,8 @@ Result<Response> BaseClient::Execute(Request& req) {
   return tl::make_unexpected(exec_resp.error());
 }
 
-Result<GetRegionResponse> BaseClient::GetRegion(const std::string& bucket_name,
-                                                const std::string& region) {
+std::optional<Result<GetRegionResponse>> BaseClient::KnownRegion(
+    const std::string& bucket_name, const std::string& region) {
   std::string base_region = base_url_.region;
   if (!region.empty()) {
     if (!base_region.empty() && base_region != region) {
@@ -267,30 +450,25 @@ Result<GetRegionResponse> BaseClient::GetRegion(const std::string& bucket_name,
     return GetRegionResponse("us-east-1");
   }
 
-  {
-    std::shared_lock<std::shared_mutex> lock(region_map_mutex_);
-    if (auto it = region_map_.find(bucket_name);
-        it != region_map_.end() && !it->second.empty()) {
-      return GetRegionResponse(it->second);
-    }
+  std::shared_lock<std::shared_mutex> lock(region_map_mutex_);
+  if (auto it = region_map_.find(bucket_name);
+      it != region_map_.end() && !it->second.empty()) {
+    return GetRegionResponse(it->second);
   }
-  Request req(http::Method::kGet, "us-east-1", base_url_, utils::Multimap(),
-              utils::Multimap());
-  req.query_params.Add("location", "");
-  req.bucket_name = bucket_name;
+  return std::nullopt;
+}
 
-  auto exec_gr = Execute(req);
+Result<GetRegionResponse> BaseClient::StoreRegion(
+    const std::string& bucket_name, Result<Response> exec_gr) {
   if (!exec_gr) {
     return tl::make_unexpected(exec_gr.error());
   }
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(exec_gr->data.data());
-  if (!result) {
-    return error::make<GetRegionResponse>("unable to parse XML");
+  std::string value;
+  if (error::Error err = xml::Decode(exec_gr->data, "LocationConstraint",
+                                     kLocationConstraintFields, value)) {
+    return tl::make_unexpected(err);
   }
-  auto text = xdoc.select_node("/LocationConstraint/text()");
-  std::string value = text.node().value();
 
   if (value.empty()) {
     value = "us-east-1";
@@ -306,6 +484,36 @@ Result<GetRegionResponse> BaseClient::GetRegion(const std::string& bucket_name,
   return GetRegionResponse(value);
 }
 
+Result<GetRegionResponse> BaseClient::GetRegion(const std::string& bucket_name,
+                                                const std::string& region) {
+  if (auto known = KnownRegion(bucket_name, region)) return std::move(*known);
+
+  Request req(http::Method::kGet, "us-east-1", base_url_, utils::Multimap(),
+              utils::Multimap());
+  req.query_params.Add("location", "");
+  req.bucket_name = bucket_name;
+  return StoreRegion(bucket_name, Execute(req));
+}
+
+void BaseClient::GetRegionAsync(
+    const std::string& bucket_name, const std::string& region,
+    std::function<void(Result<GetRegionResponse>)> done) {
+  if (auto known = KnownRegion(bucket_name, region)) {
+    done(std::move(*known));
+    return;
+  }
+
+  auto req = std::make_shared<Request>(http::Method::kGet, "us-east-1",
+                                       base_url_, utils::Multimap(),
+                                       utils::Multimap());
+  req->query_params.Add("location", "");
+  req->bucket_name = bucket_name;
+  ExecuteAsync(req, [this, bucket_name, done = std::move(done)](
+                        Result<Response> resp) {
+    done(StoreRegion(bucket_name, std::move(resp)));
+  });
+}
+
 Result<AbortMultipartUploadResponse> BaseClient::AbortMultipartUpload(
     AbortMultipartUploadArgs args) {
   if (error::Error err = args.Validate()) {
@@ -387,6 +595,9 @@ Result<CompleteMultipartUploadResponse> BaseClient::CompleteMultipartUpload(
       ss << "<ChecksumCRC64NVME>" << part.checksum_crc64nvme
          << "</ChecksumCRC64NVME>";
     }
+    if (!part.checksum_crc32c.empty()) {
+      ss << "<ChecksumCRC32C>" << part.checksum_crc32c << "</ChecksumCRC32C>";
+    }
     ss << "</Part>";
   }
   ss << "</CompleteMultipartUpload>";
@@ -396,14 +607,27 @@ Result<CompleteMultipartUploadResponse> BaseClient::CompleteMultipartUpload(
   utils::Multimap headers;
   headers.Add("Content-Type", "application/xml");
   headers.Add("Content-MD5", utils::Md5sumHash(body));
+  if (!args.checksum_crc64nvme.empty()) {
+    headers.Add("x-amz-checksum-crc64nvme", args.checksum_crc64nvme);
+    headers.Add("x-amz-checksum-type", "FULL_OBJECT");
+  }
   req.headers = headers;
 
   auto response = Execute(req);
   if (!response) {
     return tl::make_unexpected(response.error());
   }
-  return CompleteMultipartUploadResponse::ParseXML(
+  auto resp = CompleteMultipartUploadResponse::ParseXML(
       response->data, response->headers.GetFront("x-amz-version-id"));
+  if (!resp || args.checksum_crc64nvme.empty()) return resp;
+  if (resp->checksum_crc64nvme.empty()) {
+    resp->checksum_crc64nvme = args.checksum_crc64nvme;
+  } else if (resp->checksum_crc64nvme != args.checksum_crc64nvme) {
+    return error::make<CompleteMultipartUploadResponse>(
+        "full object CRC64NVME mismatch; expected: " +
+        args.checksum_crc64nvme + ", got: " + resp->checksum_crc64nvme);
+  }
+  return resp;
 }
 
 Result<CreateMultipartUploadResponse> BaseClient::CreateMultipartUpload(
@@ -432,14 +656,13 @@ Result<CreateMultipartUploadResponse> BaseClient::CreateMultipartUpload(
   req.headers.AddAll(args.headers);
 
   if (auto resp = Execute(req)) {
-    pugi::xml_document xdoc;
-    pugi::xml_parse_result result = xdoc.load_string(resp->data.data());
-    if (!result) {
-      return error::make<CreateMultipartUploadResponse>("unable to parse XML");
+    std::string upload_id;
+    if (error::Error err =
+            xml::Decode(resp->data, "InitiateMultipartUploadResult",
+                        kInitiateMultipartUploadFields, upload_id)) {
+      return tl::make_unexpected(err);
     }
-    auto text =
-        xdoc.select_node("/InitiateMultipartUploadResult/UploadId/text()");
-    return CreateMultipartUploadResponse(std::string(text.node().value()));
+    return CreateMultipartUploadResponse(std::move(upload_id));
   } else {
     return tl::make_unexpected(resp.error());
   }
@@ -900,29 +1123,16 @@ Result<GetBucketVersioningResponse> BaseClient::GetBucketVersioning(
   }
   GetBucketVersioningResponse response;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(resp->data.data());
-  if (!result) {
-    return error::make<GetBucketVersioningResponse>("unable to parse XML");
-  }
-
-  auto root = xdoc.select_node("/VersioningConfiguration");
-
-  pugi::xpath_node text;
-
-  if (root.node().select_node("Status")) {
-    text = root.node().select_node("Status/text()");
-    response.status = (strcmp(text.node().value(), "Enabled") == 0);
-  }
-  if (root.node().select_node("MFADelete")) {
-    text = root.node().select_node("MFADelete/text()");
-    response.mfa_delete = (strcmp(text.node().value(), "Enabled") == 0);
+  if (error::Error err = xml::Decode(resp->data, "VersioningConfiguration",
+                                     kVersioningFields, response)) {
+    return tl::make_unexpected(err);
   }
 
   return response;
 }
 
-Result<GetObjectResponse> BaseClient::GetObject(GetObjectArgs args) {
+BaseClient::Call<GetObjectResponse> BaseClient::PrepareGetObject(
+    GetObjectArgs args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
@@ -932,32 +1142,82 @@ Result<GetObjectResponse> BaseClient::GetObject(GetObjectArgs args) {
         "SSE-C operation must be performed over a secure connection");
   }
 
-  std::string region;
-  auto get_resp = GetRegion(args.bucket, args.region);
-  if (get_resp) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
-  }
-
-  Request req(http::Method::kGet, region, base_url_, args.extra_headers,
-              args.extra_query_params);
+  Call<GetObjectResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kGet, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
   req.bucket_name = args.bucket;
   req.object_name = args.object;
   if (!args.version_id.empty()) {
     req.query_params.Add("versionId", args.version_id);
   }
-  req.datafunc = args.datafunc;
-  req.userdata = args.userdata;
+
+  // The receive buffer and the checksum state are shared by the request and
+  // finish, so they stay put until the response is in.
+  struct State {
+    http::ReceiveBuffer buffer;
+    std::optional<Checksum> checksum;
+    bool canceled = false;
+  };
+  auto state = std::make_shared<State>();
+  if (args.buf != nullptr) {
+    state->buffer.data = args.buf;
+    state->buffer.size = *args.size;
+    req.buffer = &state->buffer;
+  } else {
+    req.datafunc = args.datafunc;
+    req.userdata = args.userdata;
+    req.zero_copy = args.zero_copy;
+  }
   req.progressfunc = args.progressfunc;
   req.progress_userdata = args.progress_userdata;
   req.headers.AddAll(args.Headers());
 
-  auto exec_set = Execute(req);
+  // The checksum is computed as the body arrives, so a whole-object read is
+  // verified without a second pass over it.
+  // A body the caller canceled is incomplete and not verified.
+  if (args.verify_checksum != ChecksumAlgorithm::kNone && !args.offset &&
+      !args.length) {
+    state->checksum.emplace(args.verify_checksum);
+    req.headers.Add("x-amz-checksum-mode", "ENABLED");
+    if (req.datafunc != nullptr) {
+      req.datafunc = [state, datafunc = req.datafunc](
+                         http::DataFunctionArgs args) -> bool {
+        state->checksum->Update(args.data.data(), args.data.size());
+        if (datafunc(std::move(args))) return true;
+        state->canceled = true;
+        return false;
+      };
+    }
+  }
 
-  if (!exec_set) return tl::make_unexpected(exec_set.error());
+  call.finish = [state, buf = args.buf](
+                    Result<Response> exec_set) -> Result<GetObjectResponse> {
+    if (!exec_set) return tl::make_unexpected(exec_set.error());
 
-  return GetObjectResponse(std::move(*exec_set));
+    if (state->checksum && !state->canceled) {
+      if (buf != nullptr) state->checksum->Update(buf, state->buffer.received);
+      if (error::Error err = state->checksum->Verify(exec_set->headers)) {
+        return tl::make_unexpected(err);
+      }
+    }
+
+    GetObjectResponse resp(std::move(*exec_set));
+    resp.size = state->buffer.received;
+    return resp;
+  };
+  return call;
+}
+
+Result<GetObjectResponse> BaseClient::GetObject(GetObjectArgs args) {
+  return Run(PrepareGetObject(std::move(args)));
+}
+
+void BaseClient::GetObjectAsync(
+    GetObjectArgs args, std::function<void(Result<GetObjectResponse>)> done) {
+  RunAsync(PrepareGetObject(std::move(args)), std::move(done));
 }
 
 Result<GetObjectLockConfigResponse> BaseClient::GetObjectLockConfig(
@@ -983,30 +1243,10 @@ Result<GetObjectLockConfigResponse> BaseClient::GetObjectLockConfig(
   if (!resp) {
     return tl::make_unexpected(resp.error());
   }
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(resp->data.data());
-  if (!result) {
-    return error::make<GetObjectLockConfigResponse>("unable to parse XML");
-  }
   ObjectLockConfig config;
-
-  auto rule = xdoc.select_node("/ObjectLockConfiguration/Rule");
-  if (!rule) {
-    return GetObjectLockConfigResponse(config);
-  }
-  auto text = rule.node().select_node("DefaultRetention/Mode/text()");
-  config.retention_mode = StringToRetentionMode(text.node().value());
-
-  if (rule.node().select_node("DefaultRetention/Days")) {
-    text = rule.node().select_node("DefaultRetention/Days/text()");
-    std::string value = text.node().value();
-    config.retention_duration_days = Integer(std::stoi(value));
-  }
-
-  if (rule.node().select_node("DefaultRetention/Years")) {
-    text = rule.node().select_node("DefaultRetention/Years/text()");
-    std::string value = text.node().value();
-    config.retention_duration_years = Integer(std::stoi(value));
+  if (error::Error err = xml::Decode(resp->data, "ObjectLockConfiguration",
+                                     kObjectLockFields, config)) {
+    return tl::make_unexpected(err);
   }
 
   return GetObjectLockConfigResponse(config);
@@ -1046,19 +1286,11 @@ Result<GetObjectRetentionResponse> BaseClient::GetObjectRetention(
     return tl::make_unexpected(resp.error());
   }
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(resp->data.data());
-  if (!result) {
-    return error::make<GetObjectRetentionResponse>("unable to parse XML");
+  if (error::Error err =
+          xml::Decode(resp->data, "Retention", kRetentionFields, response)) {
+    return tl::make_unexpected(err);
   }
 
-  auto text = xdoc.select_node("/Retention/Mode/text()");
-  response.retention_mode = StringToRetentionMode(text.node().value());
-
-  text = xdoc.select_node("/Retention/RetainUntilDate/text()");
-  response.retain_until_date =
-      utils::UtcTime::FromISO8601UTC(text.node().value());
-
   return response;
 }
 
@@ -1137,6 +1369,83 @@ Result<GetPresignedObjectUrlResponse> BaseClient::GetPresignedObjectUrl(
   return GetPresignedObjectUrlResponse(url.String());
 }
 
+error::Error BaseClient::GetPresignedObjectUrls(
+    const GetPresignedObjectUrlsArgs& args, std::vector<std::string>& urls) {
+  if (error::Error err = args.Validate()) {
+    return err;
+  }
+
+  std::string region;
+  auto get_resp = GetRegion(args.bucket, args.region);
+  if (get_resp) {
+    region = get_resp->region;
+  } else {
+    return get_resp.error();
+  }
+
+  utils::Multimap query_params;
+  query_params.AddAll(args.extra_query_params);
+
+  // The bucket decides host and path style, so build the URL once and append
+  // each encoded object name to its path.
+  http::Url url;
+  if (error::Error err = base_url_.BuildUrl(url, http::Method::kGet, region,
+                                            query_params, args.bucket, "")) {
+    return err;
+  }
+  std::string path = url.path;
+  if (!utils::EndsWith(path, "/")) path += '/';
+  url.path.clear();
+  url.query_string.clear();
+  std::string prefix = url.String();
+
+  std::optional<signer::Presigner> presigner;
+  if (provider_ != nullptr) {
+    creds::Credentials creds = provider_->Fetch();
+    if (!creds.session_token.empty()) {
+      query_params.Add("X-Amz-Security-Token", creds.session_token);
+    }
+
+    utils::UtcTime date = utils::UtcTime::Now();
+    if (args.request_time) date = args.request_time;
+
+    presigner.emplace(url.HostHeaderValue(), region, query_params,
+                      creds.access_key, creds.secret_key, date,
+                      args.expiry_seconds);
+  }
+
+  urls.resize(args.objects.size());
+  std::string object_path;
+  std::string query_string;
+  for (size_t i = 0; i < args.objects.size(); ++i) {
+    const PresignObject& object = args.objects[i];
+    object_path.assign(path);
+    object_path += utils::EncodePath(object.name);
+
+    std::string& out = urls[i];
+    out.assign(prefix);
+    out += object_path;
+    if (presigner) {
+      presigner->Sign(object.method, object_path, object.version_id,
+                      query_string);
+      out += '?';
+      out += query_string;
+    } else {
+      utils::Multimap params = query_params;
+      if (!object.version_id.empty()) {
+        params.Add("versionId", object.version_id);
+      }
+      query_string = params.ToQueryString();
+      if (!query_string.empty()) {
+        out += '?';
+        out += query_string;
+      }
+    }
+  }
+
+  return error::SUCCESS;
+}
+
 Result<GetPresignedPostFormDataResponse> BaseClient::GetPresignedPostFormData(
     PostPolicy policy) {
   if (!policy) {
@@ -1198,13 +1507,11 @@ Result<IsObjectLegalHoldEnabledResponse> BaseClient::IsObjectLegalHoldEnabled(
     return tl::make_unexpected(resp.error());
   }
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(resp->data.data());
-  if (!result) {
-    return error::make<IsObjectLegalHoldEnabledResponse>("unable to parse XML");
+  std::string value;
+  if (error::Error err =
+          xml::Decode(resp->data, "LegalHold", kLegalHoldFields, value)) {
+    return tl::make_unexpected(err);
   }
-  auto text = xdoc.select_node("/LegalHold/Status/text()");
-  std::string value = text.node().value();
   return IsObjectLegalHoldEnabledResponse(value == "ON");
 }
 
@@ -1256,9 +1563,10 @@ Result<ListenBucketNotificationResponse> BaseClient::ListenBucketNotification(
 
   std::string data;
   auto func = args.func;
+  req.zero_copy = true;
   req.datafunc = [&func = func,
                   &data = data](http::DataFunctionArgs args) -> bool {
-    data += args.datachunk;
+    data += args.data;
     while (true) {
       size_t pos = data.find('\n');
       if (pos == std::string::npos) return true;
@@ -1291,49 +1599,55 @@ Result<ListenBucketNotificationResponse> BaseClient::ListenBucketNotification(
   return ListenBucketNotificationResponse(std::move(*exec_set));
 }
 
-Result<ListObjectsResponse> BaseClient::ListObjectsV1(ListObjectsV1Args args) {
+BaseClient::Call<ListObjectsResponse> BaseClient::PrepareListObjectsV1(
+    ListObjectsV1Args args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
 
-  std::string region;
-  auto get_resp = GetRegion(args.bucket, args.region);
-  if (get_resp) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
-  }
-
-  Request req(http::Method::kGet, region, base_url_, args.extra_headers,
-              args.extra_query_params);
+  Call<ListObjectsResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kGet, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
   req.bucket_name = args.bucket;
   req.query_params.AddAll(GetCommonListObjectsQueryParams(
       args.delimiter, args.encoding_type, args.max_keys, args.prefix));
   if (!args.marker.empty()) {
     req.query_params.Add("marker", args.marker);
   }
-  auto resp = Execute(req);
-  if (!resp) {
-    return tl::make_unexpected(resp.error());
-  }
-  return ListObjectsResponse::ParseXML(resp->data, false);
+  call.finish = [](Result<Response> resp) -> Result<ListObjectsResponse> {
+    if (!resp) {
+      return tl::make_unexpected(resp.error());
+    }
+    return ListObjectsResponse::ParseXML(std::move(resp->data), false);
+  };
+  return call;
 }
 
-Result<ListObjectsResponse> BaseClient::ListObjectsV2(ListObjectsV2Args args) {
+Result<ListObjectsResponse> BaseClient::ListObjectsV1(ListObjectsV1Args args) {
+  return Run(PrepareListObjectsV1(std::move(args)));
+}
+
+void BaseClient::ListObjectsV1Async(
+    ListObjectsV1Args args,
+    std::function<void(Result<ListObjectsResponse>)> done) {
+  RunAsync(PrepareListObjectsV1(std::move(args)), std::move(done));
+}
+
+BaseClient::Call<ListObjectsResponse> BaseClient::PrepareListObjectsV2(
+    ListObjectsV2Args args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
 
-  std::string region;
-  auto get_resp = GetRegion(args.bucket, args.region);
-  if (get_resp) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
-  }
-
-  Request req(http::Method::kGet, region, base_url_, args.extra_headers,
-              args.extra_query_params);
+  Call<ListObjectsResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kGet, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
   req.bucket_name = args.bucket;
   req.query_params.Add("list-type", "2");
   req.query_params.AddAll(GetCommonListObjectsQueryParams(
@@ -1350,15 +1664,69 @@ Result<ListObjectsResponse> BaseClient::ListObjectsV2(ListObjectsV2Args args) {
   if (args.include_user_metadata) {
     req.query_params.Add("metadata", "true");
   }
-  auto resp = Execute(req);
-  if (!resp) {
-    return tl::make_unexpected(resp.error());
+  call.finish = [](Result<Response> resp) -> Result<ListObjectsResponse> {
+    if (!resp) {
+      return tl::make_unexpected(resp.error());
+    }
+    return ListObjectsResponse::ParseXML(std::move(resp->data), false);
+  };
+  return call;
+}
+
+Result<ListObjectsResponse> BaseClient::ListObjectsV2(ListObjectsV2Args args) {
+  return Run(PrepareListObjectsV2(std::move(args)));
+}
+
+void BaseClient::ListObjectsV2Async(
+    ListObjectsV2Args args,
+    std::function<void(Result<ListObjectsResponse>)> done) {
+  RunAsync(PrepareListObjectsV2(std::move(args)), std::move(done));
+}
+
+BaseClient::Call<ListObjectsResponse> BaseClient::PrepareListObjectVersions(
+    ListObjectVersionsArgs args) {
+  if (error::Error err = args.Validate()) {
+    return tl::make_unexpected(err);
+  }
+
+  Call<ListObjectsResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kGet, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
+  req.bucket_name = args.bucket;
+  req.query_params.Add("versions", "");
+  req.query_params.AddAll(GetCommonListObjectsQueryParams(
+      args.delimiter, args.encoding_type, args.max_keys, args.prefix));
+  if (!args.key_marker.empty()) {
+    req.query_params.Add("key-marker", args.key_marker);
   }
-  return ListObjectsResponse::ParseXML(resp->data, false);
+  if (!args.version_id_marker.empty()) {
+    req.query_params.Add("version-id-marker", args.version_id_marker);
+  }
+
+  call.finish = [](Result<Response> resp) -> Result<ListObjectsResponse> {
+    if (!resp) {
+      return tl::make_unexpected(resp.error());
+    }
+    return ListObjectsResponse::ParseXML(std::move(resp->data), true);
+  };
+  return call;
 }
 
 Result<ListObjectsResponse> BaseClient::ListObjectVersions(
     ListObjectVersionsArgs args) {
+  return Run(PrepareListObjectVersions(std::move(args)));
+}
+
+void BaseClient::ListObjectVersionsAsync(
+    ListObjectVersionsArgs args,
+    std::function<void(Result<ListObjectsResponse>)> done) {
+  RunAsync(PrepareListObjectVersions(std::move(args)), std::move(done));
+}
+
+Result<ListPartsResponse> BaseClient::ListParts(ListPartsArgs args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
@@ -1374,21 +1742,19 @@ Result<ListObjectsResponse> BaseClient::ListObjectVersions(
   Request req(http::Method::kGet, region, base_url_, args.extra_headers,
               args.extra_query_params);
   req.bucket_name = args.bucket;
-  req.query_params.Add("versions", "");
-  req.query_params.AddAll(GetCommonListObjectsQueryParams(
-      args.delimiter, args.encoding_type, args.max_keys, args.prefix));
-  if (!args.key_marker.empty()) {
-    req.query_params.Add("key-marker", args.key_marker);
-  }
-  if (!args.version_id_marker.empty()) {
-    req.query_params.Add("version-id-marker", args.version_id_marker);
+  req.object_name = args.object;
+  req.query_params.Add("uploadId", args.upload_id);
+  req.query_params.Add("max-parts", std::to_string(args.max_parts));
+  if (args.part_number_marker > 0) {
+    req.query_params.Add("part-number-marker",
+                         std::to_string(args.part_number_marker));
   }
 
-  auto resp = Execute(req);
-  if (!resp) {
-    return tl::make_unexpected(resp.error());
+  auto response = Execute(req);
+  if (!response) {
+    return tl::make_unexpected(response.error());
   }
-  return ListObjectsResponse::ParseXML(resp->data, true);
+  return ListPartsResponse::ParseXML(response->data);
 }
 
 Result<MakeBucketResponse> BaseClient::MakeBucket(MakeBucketArgs args) {
@@ -1474,6 +1840,13 @@ Result<PutObjectResponse> BaseClient::PutObject(PutObjectApiArgs args) {
   req.query_params.AddAll(args.query_params);
   req.headers.AddAll(args.headers);
   req.body = args.data;
+  if (args.bodyfunc != nullptr) {
+    req.bodyfunc = args.bodyfunc;
+    req.body_userdata = args.body_userdata;
+    req.body_size = args.size;
+  }
+  req.payload_signing = args.payload_signing;
+  req.checksum = args.checksum;
   req.progressfunc = args.progressfunc;
   req.progress_userdata = args.progress_userdata;
 
@@ -1489,6 +1862,8 @@ Result<PutObjectResponse> BaseClient::PutObject(PutObjectApiArgs args) {
   resp.checksumCRC32C = response->headers.GetFront("x-amz-checksum-crc32c");
   resp.checksumSHA1 = response->headers.GetFront("x-amz-checksum-sha1");
   resp.checksumSHA256 = response->headers.GetFront("x-amz-checksum-sha256");
+  resp.checksum_crc64nvme =
+      response->headers.GetFront("x-amz-checksum-crc64nvme");
 
   return resp;
 }
@@ -1545,50 +1920,117 @@ Result<RemoveObjectResponse> BaseClient::RemoveObject(RemoveObjectArgs args) {
   return RemoveObjectResponse(std::move(*exec_set));
 }
 
-Result<RemoveObjectsResponse> BaseClient::RemoveObjects(
+BaseClient::Call<RemoveObjectsResponse> BaseClient::PrepareRemoveObjects(
     RemoveObjectsApiArgs args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
 
-  std::string region;
-  auto get_resp = GetRegion(args.bucket, args.region);
-  if (get_resp) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
-  }
-
-  Request req(http::Method::kPost, region, base_url_, args.extra_headers,
-              args.extra_query_params);
+  Call<RemoveObjectsResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kPost, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
   req.bucket_name = args.bucket;
   req.query_params.Add("delete", "");
   if (args.bypass_governance_mode) {
     req.headers.Add("x-amz-bypass-governance-retention", "true");
   }
 
-  std::stringstream ss;
-  ss << "<Delete>";
-  if (args.quiet) ss << "<Quiet>true</Quiet>";
+  // The body and the decoder are shared by the request and finish, so they
+  // stay put until the response is in. The result is parsed as it arrives,
+  // so a large list of errors is never held as a whole. A body that is not a
+  // DeleteResult is kept to report it.
+  struct State {
+    std::string body;
+    RemoveObjectsResponse resp;
+    std::unique_ptr<xml::Decoder<RemoveObjectsResponse>> decoder;
+    std::string unmatched;
+  };
+  auto state = std::make_shared<State>();
+  std::string& body = state->body;
+  size_t size = 64;
   for (auto& object : args.objects) {
-    ss << "<Object>";
-    ss << "<Key>" << utils::XMLEncode(object.name) << "</Key>";
+    size += 48 + object.name.size() + object.version_id.size();
+  }
+  body.reserve(size);
+  body += "<Delete>";
+  if (args.quiet) body += "<Quiet>true</Quiet>";
+  for (auto& object : args.objects) {
+    body += "<Object><Key>";
+    utils::XMLEncodeTo(body, object.name);
+    body += "</Key>";
     if (!object.version_id.empty()) {
-      ss << "<VersionId>" << object.version_id << "</VersionId>";
+      body += "<VersionId>";
+      body += object.version_id;
+      body += "</VersionId>";
     }
-    ss << "</Object>";
+    body += "</Object>";
   }
-  ss << "</Delete>";
-  std::string body = ss.str();
+  body += "</Delete>";
   req.body = body;
   req.headers.Add("Content-Type", "application/xml");
   req.headers.Add("Content-MD5", utils::Md5sumHash(body));
 
-  auto response = Execute(req);
-  if (!response) {
-    return tl::make_unexpected(response.error());
-  }
-  return RemoveObjectsResponse::ParseXML(response->data);
+  state->decoder = RemoveObjectsResponse::NewDecoder(state->resp);
+  req.zero_copy = true;
+  req.datafunc = [state](http::DataFunctionArgs args) -> bool {
+    const bool ok = state->decoder->Feed(args.data);
+    if (state->decoder->Matched()) {
+      state->unmatched.clear();
+    } else {
+      state->unmatched += args.data;
+    }
+    return ok;
+  };
+
+  call.finish = [this, state, bucket = args.bucket,
+                 objects = std::move(args.objects)](
+                    Result<Response> response)
+      -> Result<RemoveObjectsResponse> {
+    if (stat_cache_ != nullptr) {
+      for (auto& object : objects) {
+        stat_cache_->Invalidate(bucket, object.name);
+      }
+    }
+    if (!response) {
+      if (!state->unmatched.empty()) {
+        auto parsed =
+            Response::ParseXML(state->unmatched, 0, utils::Multimap());
+        if (parsed && !parsed->code.empty()) {
+          // execute() never saw the body, so forget the region here as it
+          // would.
+          if (parsed->code == "NoSuchBucket") {
+            std::unique_lock<std::shared_mutex> lock(region_map_mutex_);
+            region_map_.erase(bucket);
+          }
+          return error::make<RemoveObjectsResponse>(parsed->code + ": " +
+                                                    parsed->message);
+        }
+      }
+      return tl::make_unexpected(response.error());
+    }
+    if (error::Error err = state->decoder->Finish()) {
+      return tl::make_unexpected(err);
+    }
+    RemoveObjectsResponse resp = std::move(state->resp);
+    resp.status_code = response->status_code;
+    resp.headers = response->headers;
+    return resp;
+  };
+  return call;
+}
+
+Result<RemoveObjectsResponse> BaseClient::RemoveObjects(
+    RemoveObjectsApiArgs args) {
+  return Run(PrepareRemoveObjects(std::move(args)));
+}
+
+void BaseClient::RemoveObjectsAsync(
+    RemoveObjectsApiArgs args,
+    std::function<void(Result<RemoveObjectsResponse>)> done) {
+  RunAsync(PrepareRemoveObjects(std::move(args)), std::move(done));
 }
 
 Result<SelectObjectContentResponse> BaseClient::SelectObjectContent(
@@ -1623,6 +2065,7 @@ Result<SelectObjectContentResponse> BaseClient::SelectObjectContent(
   SelectHandler handler(args.resultfunc);
   using namespace std::placeholders;
   req.datafunc = std::bind(&SelectHandler::DataFunction, &handler, _1);
+  req.zero_copy = true;
 
   auto exec_set = Execute(req);
 
@@ -2014,7 +2457,8 @@ Result<SetObjectTagsResponse> BaseClient::SetObjectTags(
   return SetObjectTagsResponse(std::move(*exec_set));
 }
 
-Result<StatObjectResponse> BaseClient::StatObject(StatObjectArgs args) {
+BaseClient::Call<StatObjectResponse> BaseClient::PrepareStatObject(
+    StatObjectArgs args) {
   if (error::Error err = args.Validate()) {
     return tl::make_unexpected(err);
   }
@@ -2024,69 +2468,112 @@ Result<StatObjectResponse> BaseClient::StatObject(StatObjectArgs args) {
         "SSE-C operation must be performed over a secure connection");
   }
 
-  std::string region;
-  auto get_resp = GetRegion(args.bucket, args.region);
-  if (get_resp) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
+  // Only a plain stat is cached; a range, conditions, SSE-C or extra
+  // parameters may change the response.
+  utils::Multimap headers = args.Headers();
+  std::shared_ptr<StatCache> cache = stat_cache_;
+  if (headers || args.ssec != nullptr || args.extra_headers ||
+      args.extra_query_params) {
+    cache = nullptr;
+  }
+  StatObjectResponse cached;
+  uint64_t generation = 0;
+  StatCache::Lookup lookup = StatCache::Lookup::kMiss;
+  if (cache != nullptr) {
+    lookup = cache->Find(args.bucket, args.object, args.version_id, cached,
+                         generation);
+    if (lookup == StatCache::Lookup::kHit) {
+      return Result<StatObjectResponse>(std::move(cached));
+    }
   }
 
-  Request req(http::Method::kHead, region, base_url_, args.extra_headers,
-              args.extra_query_params);
+  Call<StatObjectResponse> call;
+  call.region = args.region;
+  call.req = std::make_shared<Request>(http::Method::kHead, "", base_url_,
+                                       args.extra_headers,
+                                       args.extra_query_params);
+  Request& req = *call.req;
   req.bucket_name = args.bucket;
   req.object_name = args.object;
   if (!args.version_id.empty()) {
     req.query_params.Add("versionId", args.version_id);
   }
-  req.headers.AddAll(args.Headers());
-
-  auto response = Execute(req);
-  if (!response) {
-    return tl::make_unexpected(response.error());
+  req.headers.AddAll(headers);
+  if (lookup == StatCache::Lookup::kStale) {
+    req.headers.Add("If-None-Match", "\"" + cached.etag + "\"");
   }
-  StatObjectResponse resp(std::move(*response));
-  resp.bucket_name = args.bucket;
-  resp.object_name = args.object;
-  resp.version_id = response->headers.GetFront("x-amz-version-id");
 
-  resp.etag = utils::Trim(response->headers.GetFront("etag"), '"');
+  call.finish = [cache, cached = std::move(cached), generation, lookup,
+                 bucket = args.bucket, object = args.object,
+                 version_id = args.version_id](Result<Response> response)
+      -> Result<StatObjectResponse> {
+    if (!response) {
+      if (lookup == StatCache::Lookup::kStale &&
+          utils::StartsWith(response.error().String(), "NotModified")) {
+        cache->Refresh(bucket, object, version_id, generation);
+        return cached;
+      }
+      return tl::make_unexpected(response.error());
+    }
+    StatObjectResponse resp(std::move(*response));
+    resp.bucket_name = bucket;
+    resp.object_name = object;
+    resp.version_id = response->headers.GetFront("x-amz-version-id");
 
-  std::string value = response->headers.GetFront("content-length");
-  if (!value.empty()) resp.size = std::stoll(value);
+    resp.etag = utils::Trim(response->headers.GetFront("etag"), '"');
 
-  value = response->headers.GetFront("last-modified");
-  if (!value.empty()) {
-    resp.last_modified = utils::UtcTime::FromHttpHeaderValue(value.c_str());
-  }
+    std::string value = response->headers.GetFront("content-length");
+    if (!value.empty()) resp.size = std::stoll(value);
 
-  value = response->headers.GetFront("x-amz-object-lock-mode");
-  if (!value.empty()) resp.retention_mode = StringToRetentionMode(value);
+    value = response->headers.GetFront("last-modified");
+    if (!value.empty()) {
+      resp.last_modified =
+          utils::UtcTime::FromHttpHeaderValue(value.c_str());
+    }
 
-  value = response->headers.GetFront("x-amz-object-lock-retain-until-date");
-  if (!value.empty()) {
-    resp.retention_retain_until_date =
-        utils::UtcTime::FromISO8601UTC(value.c_str());
-  }
+    value = response->headers.GetFront("x-amz-object-lock-mode");
+    if (!value.empty()) resp.retention_mode = StringToRetentionMode(value);
 
-  value = response->headers.GetFront("x-amz-object-lock-legal-hold");
-  if (!value.empty()) resp.legal_hold = StringToLegalHold(value);
+    value =
+        response->headers.GetFront("x-amz-object-lock-retain-until-date");
+    if (!value.empty()) {
+      resp.retention_retain_until_date =
+          utils::UtcTime::FromISO8601UTC(value.c_str());
+    }
 
-  value = response->headers.GetFront("x-amz-delete-marker");
-  if (!value.empty()) resp.delete_marker = utils::StringToBool(value);
+    value = response->headers.GetFront("x-amz-object-lock-legal-hold");
+    if (!value.empty()) resp.legal_hold = StringToLegalHold(value);
 
-  utils::Multimap user_metadata;
-  std::list<std::string> keys = response->headers.Keys();
-  for (auto key : keys) {
-    if (utils::StartsWith(key, "x-amz-meta-")) {
-      std::list<std::string> values = response->headers.Get(key);
-      key.erase(0, 11);
-      for (auto value : values) user_metadata.Add(key, value);
+    value = response->headers.GetFront("x-amz-delete-marker");
+    if (!value.empty()) resp.delete_marker = utils::StringToBool(value);
+
+    utils::Multimap user_metadata;
+    std::list<std::string> keys = response->headers.Keys();
+    for (auto key : keys) {
+      if (utils::StartsWith(key, "x-amz-meta-")) {
+        std::list<std::string> values = response->headers.Get(key);
+        key.erase(0, 11);
+        for (auto value : values) user_metadata.Add(key, value);
+      }
     }
-  }
-  resp.user_metadata = user_metadata;
+    resp.user_metadata = user_metadata;
 
-  return resp;
+    if (cache != nullptr) {
+      cache->Store(bucket, object, version_id, resp, generation);
+    }
+
+    return resp;
+  };
+  return call;
+}
+
+Result<StatObjectResponse> BaseClient::StatObject(StatObjectArgs args) {
+  return Run(PrepareStatObject(std::move(args)));
+}
+
+void BaseClient::StatObjectAsync(
+    StatObjectArgs args, std::function<void(Result<StatObjectResponse>)> done) {
+  RunAsync(PrepareStatObject(std::move(args)), std::move(done));
 }
 
 Result<UploadPartResponse> BaseClient::UploadPart(UploadPartArgs args) {
@@ -2134,6 +2621,11 @@ Result<UploadPartResponse> BaseClient::UploadPart(UploadPartArgs args) {
   api_args.region = args.region;
   api_args.object = args.object;
   api_args.data = args.data;
+  api_args.bodyfunc = args.bodyfunc;
+  api_args.body_userdata = args.body_userdata;
+  api_args.size = args.part_size;
+  api_args.payload_signing = args.payload_signing;
+  api_args.checksum = args.checksum;
   api_args.headers = args.headers;
   api_args.progressfunc = args.progressfunc;
   api_args.progress_userdata = args.progress_userdata;
@@ -2181,429 +2673,384 @@ Result<UploadPartCopyResponse> BaseClient::UploadPartCopy(
 
 std::future<Result<AbortMultipartUploadResponse>>
 BaseClient::AbortMultipartUploadAsync(AbortMultipartUploadArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return AbortMultipartUpload(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return AbortMultipartUpload(std::move(args));
+  });
 }
 
 std::future<Result<BucketExistsResponse>> BaseClient::BucketExistsAsync(
     BucketExistsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return BucketExists(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return BucketExists(std::move(args));
+  });
 }
 
 std::future<Result<CompleteMultipartUploadResponse>>
 BaseClient::CompleteMultipartUploadAsync(CompleteMultipartUploadArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return CompleteMultipartUpload(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return CompleteMultipartUpload(std::move(args));
+  });
 }
 
 std::future<Result<CreateMultipartUploadResponse>>
 BaseClient::CreateMultipartUploadAsync(CreateMultipartUploadArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return CreateMultipartUpload(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return CreateMultipartUpload(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketEncryptionResponse>>
 BaseClient::DeleteBucketEncryptionAsync(DeleteBucketEncryptionArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketEncryption(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketEncryption(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketLifecycleResponse>>
 BaseClient::DeleteBucketLifecycleAsync(DeleteBucketLifecycleArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketLifecycle(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketLifecycle(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketNotificationResponse>>
 BaseClient::DeleteBucketNotificationAsync(DeleteBucketNotificationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketNotification(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketNotification(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketPolicyResponse>>
 BaseClient::DeleteBucketPolicyAsync(DeleteBucketPolicyArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketPolicy(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketPolicy(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketReplicationResponse>>
 BaseClient::DeleteBucketReplicationAsync(DeleteBucketReplicationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketReplication(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketReplication(std::move(args));
+  });
 }
 
 std::future<Result<DeleteBucketTagsResponse>> BaseClient::DeleteBucketTagsAsync(
     DeleteBucketTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteBucketTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteBucketTags(std::move(args));
+  });
 }
 
 std::future<Result<DeleteObjectLockConfigResponse>>
 BaseClient::DeleteObjectLockConfigAsync(DeleteObjectLockConfigArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteObjectLockConfig(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteObjectLockConfig(std::move(args));
+  });
 }
 
 std::future<Result<DeleteObjectTagsResponse>> BaseClient::DeleteObjectTagsAsync(
     DeleteObjectTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DeleteObjectTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DeleteObjectTags(std::move(args));
+  });
 }
 
 std::future<Result<DisableObjectLegalHoldResponse>>
 BaseClient::DisableObjectLegalHoldAsync(DisableObjectLegalHoldArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DisableObjectLegalHold(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DisableObjectLegalHold(std::move(args));
+  });
 }
 
 std::future<Result<EnableObjectLegalHoldResponse>>
 BaseClient::EnableObjectLegalHoldAsync(EnableObjectLegalHoldArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return EnableObjectLegalHold(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return EnableObjectLegalHold(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketEncryptionResponse>>
 BaseClient::GetBucketEncryptionAsync(GetBucketEncryptionArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketEncryption(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketEncryption(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketLifecycleResponse>>
 BaseClient::GetBucketLifecycleAsync(GetBucketLifecycleArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketLifecycle(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketLifecycle(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketNotificationResponse>>
 BaseClient::GetBucketNotificationAsync(GetBucketNotificationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketNotification(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketNotification(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketPolicyResponse>> BaseClient::GetBucketPolicyAsync(
     GetBucketPolicyArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketPolicy(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketPolicy(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketReplicationResponse>>
 BaseClient::GetBucketReplicationAsync(GetBucketReplicationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketReplication(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketReplication(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketTagsResponse>> BaseClient::GetBucketTagsAsync(
     GetBucketTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketTags(std::move(args));
+  });
 }
 
 std::future<Result<GetBucketVersioningResponse>>
 BaseClient::GetBucketVersioningAsync(GetBucketVersioningArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetBucketVersioning(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetBucketVersioning(std::move(args));
+  });
 }
 
 std::future<Result<GetObjectResponse>> BaseClient::GetObjectAsync(
     GetObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetObject(std::move(args));
+  });
 }
 
 std::future<Result<GetObjectLockConfigResponse>>
 BaseClient::GetObjectLockConfigAsync(GetObjectLockConfigArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetObjectLockConfig(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetObjectLockConfig(std::move(args));
+  });
 }
 
 std::future<Result<GetObjectRetentionResponse>>
 BaseClient::GetObjectRetentionAsync(GetObjectRetentionArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetObjectRetention(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetObjectRetention(std::move(args));
+  });
 }
 
 std::future<Result<GetObjectTagsResponse>> BaseClient::GetObjectTagsAsync(
     GetObjectTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetObjectTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetObjectTags(std::move(args));
+  });
 }
 
 std::future<Result<GetPresignedObjectUrlResponse>>
 BaseClient::GetPresignedObjectUrlAsync(GetPresignedObjectUrlArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return GetPresignedObjectUrl(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return GetPresignedObjectUrl(std::move(args));
+  });
 }
 
 std::future<Result<GetPresignedPostFormDataResponse>>
 BaseClient::GetPresignedPostFormDataAsync(PostPolicy policy) {
-  return std::async(std::launch::async,
-                    [this, policy = std::move(policy)]() mutable {
-                      return GetPresignedPostFormData(std::move(policy));
-                    });
+  return executor_->Submit([this, policy = std::move(policy)]() mutable {
+    return GetPresignedPostFormData(std::move(policy));
+  });
 }
 
 std::future<Result<IsObjectLegalHoldEnabledResponse>>
 BaseClient::IsObjectLegalHoldEnabledAsync(IsObjectLegalHoldEnabledArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return IsObjectLegalHoldEnabled(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return IsObjectLegalHoldEnabled(std::move(args));
+  });
 }
 
 std::future<Result<ListBucketsResponse>> BaseClient::ListBucketsAsync(
     ListBucketsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListBuckets(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListBuckets(std::move(args));
+  });
 }
 
 std::future<Result<ListBucketsResponse>> BaseClient::ListBucketsAsync() {
-  return std::async(std::launch::async, [this]() { return ListBuckets(); });
+  return executor_->Submit([this]() { return ListBuckets(); });
 }
 
 std::future<Result<ListenBucketNotificationResponse>>
 BaseClient::ListenBucketNotificationAsync(ListenBucketNotificationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListenBucketNotification(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListenBucketNotification(std::move(args));
+  });
 }
 
 std::future<Result<ListObjectsResponse>> BaseClient::ListObjectsV1Async(
     ListObjectsV1Args args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListObjectsV1(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListObjectsV1(std::move(args));
+  });
 }
 
 std::future<Result<ListObjectsResponse>> BaseClient::ListObjectsV2Async(
     ListObjectsV2Args args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListObjectsV2(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListObjectsV2(std::move(args));
+  });
 }
 
 std::future<Result<ListObjectsResponse>> BaseClient::ListObjectVersionsAsync(
     ListObjectVersionsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListObjectVersions(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListObjectVersions(std::move(args));
+  });
+}
+
+std::future<Result<ListPartsResponse>> BaseClient::ListPartsAsync(
+    ListPartsArgs args) {
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListParts(std::move(args));
+  });
 }
 
 std::future<Result<MakeBucketResponse>> BaseClient::MakeBucketAsync(
     MakeBucketArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return MakeBucket(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return MakeBucket(std::move(args));
+  });
 }
 
 std::future<Result<PutObjectResponse>> BaseClient::PutObjectAsync(
     PutObjectApiArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return BaseClient::PutObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return BaseClient::PutObject(std::move(args));
+  });
 }
 
 std::future<Result<RemoveBucketResponse>> BaseClient::RemoveBucketAsync(
     RemoveBucketArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return RemoveBucket(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return RemoveBucket(std::move(args));
+  });
 }
 
 std::future<Result<RemoveObjectResponse>> BaseClient::RemoveObjectAsync(
     RemoveObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return RemoveObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return RemoveObject(std::move(args));
+  });
 }
 
 std::future<Result<RemoveObjectsResponse>> BaseClient::RemoveObjectsAsync(
     RemoveObjectsApiArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return BaseClient::RemoveObjects(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return BaseClient::RemoveObjects(std::move(args));
+  });
 }
 
 // SelectObjectContentArgs owns request by value (deep-copied via
 // SelectRequest's shared_ptr chain). Direct move is safe.
 std::future<Result<SelectObjectContentResponse>>
 BaseClient::SelectObjectContentAsync(SelectObjectContentArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SelectObjectContent(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SelectObjectContent(std::move(args));
+  });
 }
 
 // SetBucketEncryptionArgs owns config by value.
 std::future<Result<SetBucketEncryptionResponse>>
 BaseClient::SetBucketEncryptionAsync(SetBucketEncryptionArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketEncryption(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketEncryption(std::move(args));
+  });
 }
 
 // SetBucketLifecycleArgs owns config by value.
 std::future<Result<SetBucketLifecycleResponse>>
 BaseClient::SetBucketLifecycleAsync(SetBucketLifecycleArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketLifecycle(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketLifecycle(std::move(args));
+  });
 }
 
 // SetBucketNotificationArgs owns config by value.
 // config.
 std::future<Result<SetBucketNotificationResponse>>
 BaseClient::SetBucketNotificationAsync(SetBucketNotificationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketNotification(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketNotification(std::move(args));
+  });
 }
 
 // SetBucketReplicationArgs owns config by value.
 std::future<Result<SetBucketReplicationResponse>>
 BaseClient::SetBucketReplicationAsync(SetBucketReplicationArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketReplication(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketReplication(std::move(args));
+  });
 }
 
 std::future<Result<SetBucketPolicyResponse>> BaseClient::SetBucketPolicyAsync(
     SetBucketPolicyArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketPolicy(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketPolicy(std::move(args));
+  });
 }
 
 std::future<Result<SetBucketTagsResponse>> BaseClient::SetBucketTagsAsync(
     SetBucketTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketTags(std::move(args));
+  });
 }
 
 std::future<Result<SetBucketVersioningResponse>>
 BaseClient::SetBucketVersioningAsync(SetBucketVersioningArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetBucketVersioning(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetBucketVersioning(std::move(args));
+  });
 }
 
 std::future<Result<SetObjectLockConfigResponse>>
 BaseClient::SetObjectLockConfigAsync(SetObjectLockConfigArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetObjectLockConfig(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetObjectLockConfig(std::move(args));
+  });
 }
 
 std::future<Result<SetObjectRetentionResponse>>
 BaseClient::SetObjectRetentionAsync(SetObjectRetentionArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetObjectRetention(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetObjectRetention(std::move(args));
+  });
 }
 
 std::future<Result<SetObjectTagsResponse>> BaseClient::SetObjectTagsAsync(
     SetObjectTagsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return SetObjectTags(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return SetObjectTags(std::move(args));
+  });
 }
 
 std::future<Result<StatObjectResponse>> BaseClient::StatObjectAsync(
     StatObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return StatObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return StatObject(std::move(args));
+  });
 }
 
 std::future<Result<UploadPartResponse>> BaseClient::UploadPartAsync(
     UploadPartArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return UploadPart(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return UploadPart(std::move(args));
+  });
 }
 
 std::future<Result<UploadPartCopyResponse>> BaseClient::UploadPartCopyAsync(
     UploadPartCopyArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return UploadPartCopy(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return UploadPartCopy(std::move(args));
+  });
 }
 
 }  // namespace minio::s3
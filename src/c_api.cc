@@ -140,6 +140,9 @@ ssize_t miniocpp_put_object(miniocpp_client* c, const char* bucket,
   args.bucket = bucket;
   args.object = object;
   args.region = holder->base_url.region;
+  // Per-part CRCs are combined into the FULL_OBJECT checksum returned in
+  // checksum_out.
+  args.checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
 
   std::unique_ptr<ReadCbStreamBuf> sbuf;
   std::unique_ptr<std::istream> sis;
@@ -199,11 +202,12 @@ ssize_t miniocpp_get_object(miniocpp_client* c, const char* bucket,
   } else {
     args.datafunc = [write_cb, userdata,
                      &bytes_seen](minio::http::DataFunctionArgs a) -> bool {
-      ssize_t n = write_cb(userdata, a.datachunk.data(), a.datachunk.size());
-      if (n < 0 || static_cast<size_t>(n) != a.datachunk.size()) return false;
+      ssize_t n = write_cb(userdata, a.data.data(), a.data.size());
+      if (n < 0 || static_cast<size_t>(n) != a.data.size()) return false;
       bytes_seen += n;
       return true;
     };
+    args.zero_copy = true;
   }
 
   auto resp = holder->client->GetObject(args);
@@ -211,7 +215,7 @@ ssize_t miniocpp_get_object(miniocpp_client* c, const char* bucket,
     SetLastError(resp.error().String());
     return MINIOCPP_ERR_GENERIC;
   }
-  return buf != nullptr ? static_cast<ssize_t>(size) : bytes_seen;
+  return buf != nullptr ? static_cast<ssize_t>(resp->size) : bytes_seen;
 }
 
 void* miniocpp_alloc_aligned(size_t size) {
@@ -21,6 +21,7 @@
 #include <malloc.h>
 #else
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <unistd.h>
 #endif
 
@@ -32,12 +33,18 @@
 #undef GetObject
 #endif
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
 #include <deque>
 #include <filesystem>
 #include <fstream>
 #include <future>
 #include <iostream>
+#include <limits>
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -156,12 +163,12 @@ const CudaHostCopy& GetCudaHostCopy() {
 }
 
 // The driver API copies operate on the calling thread's *current* context.
-// GetObjectAsync/PutObjectAsync dispatch through std::async, so a fallback can
-// run on a pool thread that has never touched CUDA; there every copy would fail
-// with CUDA_ERROR_INVALID_CONTEXT. Borrow the primary context of the device the
-// buffer belongs to for the duration of the copy, and put the thread back the
-// way we found it afterwards. A thread that already has a context is left
-// alone.
+// GetObjectAsync/PutObjectAsync dispatch through the executor, so a fallback
+// can run on a pool thread that has never touched CUDA; there every copy would
+// fail with CUDA_ERROR_INVALID_CONTEXT. Borrow the primary context of the
+// device the buffer belongs to for the duration of the copy, and put the
+// thread back the way we found it afterwards. A thread that already has a
+// context is left alone.
 class ScopedCudaContext {
  public:
   ScopedCudaContext(const CudaHostCopy& fns, void* devptr) : fns_(&fns) {
@@ -276,12 +283,553 @@ struct ScopedRDMARegistration {
 };
 #endif
 
+// Default range size of a parallel GetObject or DownloadObject.
+constexpr size_t kDefaultGetPartSize = 16 * 1024 * 1024;  // 16MiB
+
+// PartFile is a preallocated download target written at arbitrary offsets
+// from several threads at once.
+class PartFile {
+ public:
+  PartFile() = default;
+  ~PartFile() { Close(); }
+
+  PartFile(const PartFile&) = delete;
+  PartFile& operator=(const PartFile&) = delete;
+
+  // Open opens (or creates) path, emptying it when truncate is set, and
+  // sizes it to size bytes.
+  error::Error Open(const std::filesystem::path& path, uint64_t size,
+                    bool truncate) {
+#ifdef _WIN32
+    handle_ = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                          FILE_SHARE_READ, nullptr,
+                          truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
+                          FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle_ == INVALID_HANDLE_VALUE) {
+      return error::Error("unable to open file " + utils::PathToUtf8(path));
+    }
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(handle_, end, nullptr, FILE_BEGIN) ||
+        !SetEndOfFile(handle_)) {
+      return error::Error("unable to allocate file " +
+                          utils::PathToUtf8(path));
+    }
+#else
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) flags |= O_TRUNC;
+    fd_ = open(path.c_str(), flags, 0644);
+    if (fd_ < 0) {
+      return error::Error("unable to open file " + utils::PathToUtf8(path));
+    }
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+      return error::Error("unable to allocate file " +
+                          utils::PathToUtf8(path));
+    }
+#ifdef __linux__
+    // Reserve the blocks up front so parallel writes don't fragment the file;
+    // a filesystem without fallocate support keeps the sparse file.
+    if (size > 0) posix_fallocate(fd_, 0, static_cast<off_t>(size));
+#endif
+#endif
+    return error::SUCCESS;
+  }
+
+  bool WriteAt(const char* data, size_t length, uint64_t offset) {
+    while (length > 0) {
+#ifdef _WIN32
+      OVERLAPPED ov = {};
+      ov.Offset = static_cast<DWORD>(offset);
+      ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD n = 0;
+      DWORD chunk = static_cast<DWORD>(std::min<size_t>(length, 1 << 30));
+      if (!WriteFile(handle_, data, chunk, &n, &ov) || n == 0) return false;
+#else
+      ssize_t n = pwrite(fd_, data, length, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+#endif
+      data += n;
+      length -= static_cast<size_t>(n);
+      offset += static_cast<uint64_t>(n);
+    }
+    return true;
+  }
+
+  // Sync flushes written ranges to disk before they are journaled.
+  bool Sync() {
+#ifdef _WIN32
+    return FlushFileBuffers(handle_) != 0;
+#else
+    return fsync(fd_) == 0;
+#endif
+  }
+
+  bool Close() {
+    bool ok = true;
+#ifdef _WIN32
+    if (handle_ != INVALID_HANDLE_VALUE) ok = CloseHandle(handle_) != 0;
+    handle_ = INVALID_HANDLE_VALUE;
+#else
+    if (fd_ >= 0) ok = close(fd_) == 0;
+    fd_ = -1;
+#endif
+    return ok;
+  }
+
+ private:
+#ifdef _WIN32
+  HANDLE handle_ = INVALID_HANDLE_VALUE;
+#else
+  int fd_ = -1;
+#endif
+};  // class PartFile
+
+// SourceFile is an upload source read at arbitrary offsets from several
+// threads at once, so parts can be uploaded concurrently without a shared
+// stream cursor. A file truncated meanwhile reads short instead of faulting.
+class SourceFile {
+ public:
+  SourceFile() = default;
+  ~SourceFile() { Close(); }
+
+  SourceFile(const SourceFile&) = delete;
+  SourceFile& operator=(const SourceFile&) = delete;
+
+  // Open opens path for reading; false when it cannot be opened.
+  bool Open(const std::filesystem::path& path) {
+#ifdef _WIN32
+    handle_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                          nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                          nullptr);
+    return handle_ != INVALID_HANDLE_VALUE;
+#else
+    fd_ = open(path.c_str(), O_RDONLY);
+    return fd_ >= 0;
+#endif
+  }
+
+  // ReadAt fills length bytes of data from offset; false on a read error or
+  // when the file ends first.
+  bool ReadAt(char* data, size_t length, uint64_t offset) const {
+    while (length > 0) {
+#ifdef _WIN32
+      OVERLAPPED ov = {};
+      ov.Offset = static_cast<DWORD>(offset);
+      ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+      DWORD n = 0;
+      DWORD chunk = static_cast<DWORD>(std::min<size_t>(length, 1 << 30));
+      if (!ReadFile(handle_, data, chunk, &n, &ov) || n == 0) return false;
+#else
+      ssize_t n = pread(fd_, data, length, static_cast<off_t>(offset));
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+#endif
+      data += n;
+      length -= static_cast<size_t>(n);
+      offset += static_cast<uint64_t>(n);
+    }
+    return true;
+  }
+
+  void Close() {
+#ifdef _WIN32
+    if (handle_ != INVALID_HANDLE_VALUE) CloseHandle(handle_);
+    handle_ = INVALID_HANDLE_VALUE;
+#else
+    if (fd_ >= 0) close(fd_);
+    fd_ = -1;
+#endif
+  }
+
+ private:
+#ifdef _WIN32
+  HANDLE handle_ = INVALID_HANDLE_VALUE;
+#else
+  int fd_ = -1;
+#endif
+};  // class SourceFile
+
+// Default number of concurrent parts of UploadObject and ComposeObject.
+constexpr unsigned int kDefaultInflightParts = 4;
+
+// Upper bound of any max_inflight_parts, to keep untrusted input from
+// spawning unbounded threads.
+constexpr unsigned int kMaxInflightParts = 100;
+
+unsigned int ClampInflight(std::optional<unsigned int> max_inflight_parts,
+                           unsigned int default_value) {
+  unsigned int n = max_inflight_parts.value_or(default_value);
+  if (n < 1) return 1;
+  return n > kMaxInflightParts ? kMaxInflightParts : n;
+}
+
+// The download journal's first line identifies the layout it describes;
+// every following line is the number of a part already on disk.
+std::string JournalHeader(const std::string& etag, uint64_t size,
+                          size_t part_size) {
+  return "minio-download 1 " + etag + " " + std::to_string(size) + " " +
+         std::to_string(part_size);
+}
+
+// ReadJournal returns the completed parts of a previous download with the
+// same header, or nothing when the journal is missing or describes another
+// layout.
+std::vector<bool> ReadJournal(const std::filesystem::path& path,
+                              const std::string& header, size_t part_count) {
+  std::vector<bool> done(part_count, false);
+  std::ifstream journal(path, std::ios::binary);
+  std::string line;
+  if (!journal.is_open() || !std::getline(journal, line) || line != header) {
+    return done;
+  }
+  while (std::getline(journal, line)) {
+    // A record cut short by a crash is simply ignored.
+    char* end = nullptr;
+    unsigned long long part = std::strtoull(line.c_str(), &end, 10);
+    if (end == line.c_str() || *end != '\0' || part >= part_count) continue;
+    done[part] = true;
+  }
+  return done;
+}
+
+// UploadedPart returns the completion entry of an uploaded part of size
+// bytes, with the checksums the server computed; crc64nvme is the one
+// computed locally, if any.
+Part UploadedPart(unsigned int number, size_t size, UploadPartResponse& resp,
+                  std::string crc64nvme) {
+  if (crc64nvme.empty()) crc64nvme = std::move(resp.checksum_crc64nvme);
+  Part part(number, std::move(resp.etag), std::move(crc64nvme));
+  part.size = size;
+  part.checksum_crc32c = std::move(resp.checksumCRC32C);
+  return part;
+}
+
+// FullObjectCrc64Nvme combines the CRC64NVME of parts, in order, into the
+// FULL_OBJECT checksum of the object they make up, without reading it again.
+// Empty when a part has none.
+std::string FullObjectCrc64Nvme(const std::list<Part>& parts) {
+  uint64_t crc = 0;  // Of no bytes.
+  for (const Part& part : parts) {
+    uint64_t part_crc = 0;
+    if (!utils::ParseCrc64NvmeBase64(part.checksum_crc64nvme, part_crc)) {
+      return "";
+    }
+    crc = utils::Crc64NvmeCombine(crc, part_crc, part.size);
+  }
+  return utils::Crc64NvmeBase64(crc);
+}
+
+// SetCrc64Nvme sets the FULL_OBJECT CRC64NVME of args.parts on args when the
+// upload declared CRC64NVME on create. Otherwise no CRC64NVME is sent at
+// all: the parts may still carry ones the server computed on its own, which
+// it rejects on an upload that declared none.
+void SetCrc64Nvme(CompleteMultipartUploadArgs& args, bool declared) {
+  if (declared) {
+    args.checksum_crc64nvme = FullObjectCrc64Nvme(args.parts);
+    return;
+  }
+  for (Part& part : args.parts) part.checksum_crc64nvme.clear();
+}
+
+// DeclareChecksum adds the checksum algorithm of a multipart upload to the
+// headers of CreateMultipartUpload and reports whether it is CRC64NVME.
+// CRC64NVME is only defined over the full object, so its type is declared as
+// well.
+bool DeclareChecksum(utils::Multimap& headers, ChecksumAlgorithm checksum) {
+  if (checksum != ChecksumAlgorithm::kNone &&
+      !headers.Contains("x-amz-checksum-algorithm")) {
+    headers.Add("x-amz-checksum-algorithm",
+                ChecksumAlgorithmToString(checksum));
+  }
+  if (headers.GetFront("x-amz-checksum-algorithm") != "CRC64NVME") {
+    return false;
+  }
+  if (!headers.Contains("x-amz-checksum-type")) {
+    headers.Add("x-amz-checksum-type", "FULL_OBJECT");
+  }
+  return true;
+}
+
+// ErrorPage returns a page holding just an item reporting err.
+std::shared_ptr<ListObjectsResponse> ErrorPage(const error::Error& err) {
+  auto page = std::make_shared<ListObjectsResponse>();
+  page->page_ = std::make_shared<std::string>(err.String());
+  page->contents.emplace_back().error = *page->page_;
+  return page;
+}
+
+// Failed reports whether page is an ErrorPage.
+bool Failed(const ListObjectsResponse& page) {
+  return page.contents.size() == 1 && !page.contents.front().error.empty();
+}
+
+// ListPage fetches the one page of objects args describes, or an ErrorPage.
+std::shared_ptr<ListObjectsResponse> ListPage(Client* client,
+                                              ListObjectsArgs args) {
+  try {
+    auto resp = client->GetRegion(args.bucket, args.region);
+    if (!resp) return ErrorPage(resp.error());
+    args.region = resp->region;
+    if (args.recursive) {
+      args.delimiter = "";
+    } else if (args.delimiter.empty()) {
+      args.delimiter = "/";
+    }
+
+    Result<ListObjectsResponse> list_resp;
+    if (args.include_versions || !args.version_id_marker.empty()) {
+      list_resp = client->ListObjectVersions(ListObjectVersionsArgs(args));
+    } else if (args.use_api_v1) {
+      list_resp = client->ListObjectsV1(ListObjectsV1Args(args));
+    } else {
+      list_resp = client->ListObjectsV2(ListObjectsV2Args(args));
+    }
+    if (!list_resp) return ErrorPage(list_resp.error());
+    return std::make_shared<ListObjectsResponse>(std::move(*list_resp));
+  } catch (const std::exception& e) {
+    return ErrorPage(error::Error(e.what()));
+  }
+}
+
+using RemoveBatches = std::deque<std::future<RemoveObjectsResponse>>;
+
+// NewRemoveBatches returns the batch queue shared by the copies of a
+// RemoveObjectsResult. The last copy to go waits for the batches still in
+// flight: they use the client, which may be destroyed right after.
+std::shared_ptr<RemoveBatches> NewRemoveBatches(
+    std::shared_ptr<utils::Executor> executor) {
+  return std::shared_ptr<RemoveBatches>(
+      new RemoveBatches(), [executor](RemoveBatches* batches) {
+        for (auto& batch : *batches) executor->Wait(batch);
+        delete batches;
+      });
+}
+
 }  // namespace
 
-ListObjectsResult::ListObjectsResult([[maybe_unused]] error::Error err)
-    : failed_(true) {
-  resp_ = std::make_shared<ListObjectsResponse>();
-  itr_ = resp_->contents.end();
+/**
+ * ParallelListing walks the key ranges of a recursive listing concurrently
+ * for ListObjectsResult. Each range is its own chain of pages; at most
+ * max_inflight pages are requested at once, and in key order no range runs
+ * more than kMaxBufferedPages ahead of the one being returned. A page that
+ * fails ends the listing with its ErrorPage, in key order after the pages of
+ * the ranges before it.
+ */
+class ParallelListing {
+ private:
+  // Pages a range may fetch ahead of being returned.
+  static constexpr size_t kMaxBufferedPages = 2;
+  // Delimiter pages probed for common prefixes before falling back to
+  // start_after bounds.
+  static constexpr size_t kMaxProbePages = 8;
+
+  struct Range {
+    ListObjectsArgs args;  // Next page of the range.
+    std::string last;      // Greatest key of the range, when bounded.
+    bool bounded = false;
+    bool fixed = false;  // Objects of the probe, returned as they are.
+    bool done = false;
+    std::deque<std::shared_ptr<ListObjectsResponse>> pages;
+    std::future<std::shared_ptr<ListObjectsResponse>> inflight;
+  };
+
+  Client* client_;
+  ListObjectsArgs args_;
+  unsigned int max_inflight_;
+  bool partitioned_ = false;
+  bool failed_ = false;  // An ErrorPage was returned.
+  std::vector<Range> ranges_;
+  size_t head_ = 0;              // First range not fully returned.
+  std::deque<size_t> requests_;  // Ranges with a page in flight, oldest first.
+  // Probe pages the items of fixed ranges point into.
+  std::vector<std::shared_ptr<ListObjectsResponse>> probe_;
+
+  void NextPage(ListObjectsArgs& args, const ListObjectsResponse& page) {
+    if (args.use_api_v1) {
+      args.marker = page.next_marker;
+    } else {
+      args.start_after = page.start_after;
+      args.continuation_token = page.next_continuation_token;
+    }
+  }
+
+  Range& AddRange(std::string prefix, std::string start_after) {
+    Range& range = ranges_.emplace_back();
+    range.args = args_;
+    range.args.prefix = std::move(prefix);
+    if (start_after > args_.start_after) range.args.start_after = start_after;
+    if (start_after > args_.marker) range.args.marker = start_after;
+    return range;
+  }
+
+  // Partition probes one delimiter level below the prefix. Each common
+  // prefix found becomes a range, and the objects between them are returned
+  // from the probe pages. Without at least two prefixes, e.g. in a flat
+  // keyspace, the range is instead cut at the alphanumeric characters
+  // following the prefix.
+  void Partition() {
+    partitioned_ = true;
+    ListObjectsArgs probe = args_;
+    probe.recursive = false;
+    probe.delimiter = "/";
+    std::vector<Item*> entries;
+    bool complete = false;
+    for (size_t i = 0; i < kMaxProbePages && !complete; ++i) {
+      auto page = ListPage(client_, probe);
+      if (Failed(*page)) {
+        probe_.clear();
+        Range& range = ranges_.emplace_back();
+        range.fixed = true;
+        range.done = true;
+        range.pages.push_back(std::move(page));
+        return;
+      }
+      probe_.push_back(page);
+      for (Item& item : page->contents) entries.push_back(&item);
+      complete = !page->is_truncated;
+      NextPage(probe, *page);
+    }
+    auto prefixes = std::count_if(entries.begin(), entries.end(),
+                                  [](Item* item) { return item->is_prefix; });
+
+    if (complete && prefixes >= 2) {
+      std::stable_sort(entries.begin(), entries.end(), [](Item* a, Item* b) {
+        return a->name < b->name;
+      });
+      for (Item* item : entries) {
+        if (item->is_prefix) {
+          AddRange(std::string(item->name), "");
+          continue;
+        }
+        if (ranges_.empty() || !ranges_.back().fixed) {
+          Range& range = ranges_.emplace_back();
+          range.fixed = true;
+          range.done = true;
+          range.pages.push_back(std::make_shared<ListObjectsResponse>());
+        }
+        ranges_.back().pages.back()->contents.push_back(*item);
+      }
+      return;
+    }
+
+    probe_.clear();
+    static constexpr char kBounds[] =
+        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    std::string start_after;
+    for (char bound : std::string_view(kBounds)) {
+      std::string last = args_.prefix + bound;
+      if (last > args_.start_after && last > args_.marker) {
+        Range& range = AddRange(args_.prefix, start_after);
+        range.last = last;
+        range.bounded = true;
+      }
+      start_after = std::move(last);
+    }
+    AddRange(args_.prefix, start_after);
+  }
+
+  void Request(size_t index) {
+    Range& range = ranges_[index];
+    try {
+      range.inflight = client_->GetExecutor()->Submit(
+          [client = client_, args = range.args]() mutable {
+            return ListPage(client, std::move(args));
+          });
+    } catch (const std::system_error&) {
+      std::promise<std::shared_ptr<ListObjectsResponse>> promise;
+      promise.set_value(ListPage(client_, range.args));
+      range.inflight = promise.get_future();
+    }
+    requests_.push_back(index);
+  }
+
+  // Fill keeps max_inflight_ pages in flight, favouring the first ranges.
+  void Fill() {
+    for (size_t i = head_;
+         i < ranges_.size() && requests_.size() < max_inflight_; ++i) {
+      Range& range = ranges_[i];
+      if (!range.done && !range.inflight.valid() &&
+          (i == head_ || range.pages.size() < kMaxBufferedPages)) {
+        Request(i);
+      }
+    }
+  }
+
+  void Complete(size_t index) {
+    requests_.erase(std::find(requests_.begin(), requests_.end(), index));
+    Range& range = ranges_[index];
+    std::shared_ptr<ListObjectsResponse> page = range.inflight.get();
+    if (Failed(*page)) {
+      range.done = true;
+      range.pages.push_back(std::move(page));
+      return;
+    }
+    range.done = !page->is_truncated;
+    if (!range.done) NextPage(range.args, *page);
+    if (range.bounded) {
+      auto past = std::find_if(
+          page->contents.begin(), page->contents.end(),
+          [&range](const Item& item) { return item.name > range.last; });
+      if (past != page->contents.end()) {
+        page->contents.erase(past, page->contents.end());
+        range.done = true;
+      }
+    }
+    if (!page->contents.empty()) range.pages.push_back(std::move(page));
+  }
+
+ public:
+  ParallelListing(Client* client, const ListObjectsArgs& args)
+      : client_(client),
+        args_(args),
+        max_inflight_(ClampInflight(args.max_inflight_partitions, 1)) {}
+
+  // Next returns the next non-empty page, or null when the listing is done.
+  std::shared_ptr<ListObjectsResponse> Next() {
+    if (failed_) return nullptr;
+    if (!partitioned_) Partition();
+    while (true) {
+      while (head_ < ranges_.size() && ranges_[head_].done &&
+             ranges_[head_].pages.empty()) {
+        head_++;
+      }
+      if (head_ == ranges_.size()) return nullptr;
+
+      Fill();
+      for (size_t i = head_; i < ranges_.size(); ++i) {
+        Range& range = ranges_[i];
+        if (!range.pages.empty()) {
+          auto page = std::move(range.pages.front());
+          range.pages.pop_front();
+          failed_ = Failed(*page);
+          return page;
+        }
+        if (!args_.unordered) break;
+      }
+
+      // In key order only the head range can unblock the caller; otherwise
+      // take whichever pages are ready, or wait for the oldest.
+      size_t index = args_.unordered ? requests_.front() : head_;
+      if (!ranges_[index].inflight.valid()) Request(index);
+      client_->GetExecutor()->Wait(ranges_[index].inflight);
+      Complete(index);
+      if (args_.unordered) {
+        for (size_t i : std::vector<size_t>(requests_.begin(),
+                                            requests_.end())) {
+          if (ranges_[i].inflight.wait_for(std::chrono::seconds(0)) ==
+              std::future_status::ready) {
+            Complete(i);
+          }
+        }
+      }
+    }
+  }
+};  // class ParallelListing
+
+ListObjectsResult::ListObjectsResult(error::Error err) : failed_(true) {
+  resp_ = ErrorPage(err);
+  itr_ = resp_->contents.begin();
 }
 
 ListObjectsResult::ListObjectsResult(Client* const client,
@@ -289,7 +837,12 @@ ListObjectsResult::ListObjectsResult(Client* const client,
     : client_(client), args_(args) {
   resp_ = std::make_shared<ListObjectsResponse>();
   itr_ = resp_->contents.end();
-  StartPrefetch();
+  if (args_.recursive && args_.max_inflight_partitions.has_value() &&
+      !args_.include_versions && args_.version_id_marker.empty()) {
+    parallel_ = std::make_shared<ParallelListing>(client_, args_);
+  } else {
+    StartPrefetch();
+  }
   Populate();
 }
 
@@ -298,7 +851,12 @@ ListObjectsResult::ListObjectsResult(Client* const client,
     : client_(client), args_(std::move(args)) {
   resp_ = std::make_shared<ListObjectsResponse>();
   itr_ = resp_->contents.end();
-  StartPrefetch();
+  if (args_.recursive && args_.max_inflight_partitions.has_value() &&
+      !args_.include_versions && args_.version_id_marker.empty()) {
+    parallel_ = std::make_shared<ParallelListing>(client_, args_);
+  } else {
+    StartPrefetch();
+  }
   Populate();
 }
 
@@ -315,58 +873,16 @@ void ListObjectsResult::UpdatePaginationArgs() {
 }
 
 void ListObjectsResult::StartPrefetch() {
-  ListObjectsArgs next_args = args_;
   try {
     prefetch_future_ = std::make_shared<
-        std::shared_future<std::shared_ptr<ListObjectsResponse>>>(std::async(
-        std::launch::async,
-        [client = client_, next_args = std::move(next_args)]() mutable
-            -> std::shared_ptr<ListObjectsResponse> {
-          try {
-            auto resp = client->GetRegion(next_args.bucket, next_args.region);
-            if (resp) {
-              next_args.region = resp->region;
-              if (next_args.recursive) {
-                next_args.delimiter = "";
-              } else if (next_args.delimiter.empty()) {
-                next_args.delimiter = "/";
-              }
-
-              if (next_args.include_versions ||
-                  !next_args.version_id_marker.empty()) {
-                auto list_resp = client->ListObjectVersions(
-                    ListObjectVersionsArgs(next_args));
-                if (list_resp) {
-                  return std::shared_ptr<ListObjectsResponse>(
-                      new ListObjectsResponse(std::move(*list_resp)));
-                }
-                return std::make_shared<ListObjectsResponse>();
-              } else if (next_args.use_api_v1) {
-                auto list_resp =
-                    client->ListObjectsV1(ListObjectsV1Args(next_args));
-                if (list_resp) {
-                  return std::shared_ptr<ListObjectsResponse>(
-                      new ListObjectsResponse(std::move(*list_resp)));
-                }
-                return std::make_shared<ListObjectsResponse>();
-              } else {
-                auto list_resp =
-                    client->ListObjectsV2(ListObjectsV2Args(next_args));
-                if (list_resp) {
-                  return std::shared_ptr<ListObjectsResponse>(
-                      new ListObjectsResponse(std::move(*list_resp)));
-                }
-                return std::make_shared<ListObjectsResponse>();
-              }
-            }
-            return std::make_shared<ListObjectsResponse>();
-          } catch (const std::exception& e) {
-            return std::make_shared<ListObjectsResponse>();
-          }
-        }));
+        std::shared_future<std::shared_ptr<ListObjectsResponse>>>(
+        client_->GetExecutor()->Submit(
+            [client = client_, next_args = args_]() mutable {
+              return ListPage(client, std::move(next_args));
+            }));
   } catch (const std::exception& e) {
     std::promise<std::shared_ptr<ListObjectsResponse>> p;
-    p.set_value(std::make_shared<ListObjectsResponse>());
+    p.set_value(ErrorPage(error::Error(e.what())));
     prefetch_future_ = std::make_shared<
         std::shared_future<std::shared_ptr<ListObjectsResponse>>>(
         p.get_future());
@@ -374,13 +890,26 @@ void ListObjectsResult::StartPrefetch() {
 }
 
 void ListObjectsResult::Populate() {
+  if (parallel_) {
+    resp_ = parallel_->Next();
+    if (resp_ == nullptr) {
+      failed_ = true;
+      resp_ = std::make_shared<ListObjectsResponse>();
+    } else {
+      // Until Next() runs dry or fails.
+      resp_->is_truncated = !Failed(*resp_);
+    }
+    itr_ = resp_->contents.begin();
+    return;
+  }
   if (!prefetch_future_ || !prefetch_future_->valid()) {
     return;
   }
   try {
+    client_->GetExecutor()->Wait(*prefetch_future_);
     resp_ = prefetch_future_->get();
   } catch (const std::exception& e) {
-    resp_ = std::make_shared<ListObjectsResponse>();
+    resp_ = ErrorPage(error::Error(e.what()));
   }
   prefetch_future_.reset();
   if (failed_ || resp_->contents.empty()) {
@@ -396,56 +925,83 @@ void ListObjectsResult::Populate() {
 
 RemoveObjectsResult::RemoveObjectsResult([[maybe_unused]] error::Error err) {
   done_ = true;
+  inflight_ =
+      std::make_shared<std::deque<std::future<RemoveObjectsResponse>>>();
   itr_ = resp_.errors.end();
 }
 
 RemoveObjectsResult::RemoveObjectsResult(Client* const client,
                                          const RemoveObjectsArgs& args)
     : client_(client), args_(args) {
+  max_inflight_ =
+      ClampInflight(args_.max_inflight_batches, kDefaultInflightParts);
+  inflight_ = NewRemoveBatches(client_->GetExecutor());
   Populate();
 }
 
 RemoveObjectsResult::RemoveObjectsResult(Client* const client,
                                          RemoveObjectsArgs&& args)
-    : client_(client), args_(args) {
+    : client_(client), args_(std::move(args)) {
+  max_inflight_ =
+      ClampInflight(args_.max_inflight_batches, kDefaultInflightParts);
+  inflight_ = NewRemoveBatches(client_->GetExecutor());
   Populate();
 }
 
-void RemoveObjectsResult::Populate() {
-  while (!done_ && resp_.errors.size() == 0) {
-    RemoveObjectsApiArgs args;
-    args.extra_headers = args_.extra_headers;
-    args.extra_query_params = args_.extra_query_params;
-    args.bucket = args_.bucket;
-    args.region = args_.region;
-    args.quiet = true;
-    args.bypass_governance_mode = args_.bypass_governance_mode;
-
-    for (int i = 0; i < 1000; i++) {
-      DeleteObject object;
-      if (!args_.func(object)) {
-        break;
-      }
-      args.objects.push_back(object);
-    }
-
-    if (args.objects.size() != 0) {
-      auto rm_resp = client_->BaseClient::RemoveObjects(args);
-      if (rm_resp) {
-        resp_ = std::move(*rm_resp);
-      }
-      itr_ = resp_.errors.begin();
-    } else {
+void RemoveObjectsResult::Submit() {
+  RemoveObjectsApiArgs args;
+  args.extra_headers = args_.extra_headers;
+  args.extra_query_params = args_.extra_query_params;
+  args.bucket = args_.bucket;
+  args.region = args_.region;
+  args.quiet = true;
+  args.bypass_governance_mode = args_.bypass_governance_mode;
+
+  for (int i = 0; i < 1000; i++) {
+    DeleteObject object;
+    if (!args_.func(object)) {
       done_ = true;
+      break;
     }
+    args.objects.push_back(std::move(object));
   }
-  // Caller's func may have returned false on the very first call (empty
-  // batch). `done_` flips to true above but itr_ was never assigned, so
-  // operator bool() would compare an uninitialized iterator. Pin it to
-  // end() so the result evaluates to false cleanly.
-  if (done_ && resp_.errors.empty()) {
-    itr_ = resp_.errors.end();
+  if (args.objects.empty()) return;
+
+  // A batch that fails as a whole reports every object in it.
+  auto batch = std::make_shared<RemoveObjectsApiArgs>(std::move(args));
+  auto remove = [client = client_, batch]() -> RemoveObjectsResponse {
+    auto resp = client->BaseClient::RemoveObjects(*batch);
+    if (resp) return std::move(*resp);
+    RemoveObjectsResponse failed;
+    for (const DeleteObject& object : batch->objects) {
+      DeleteError err;
+      err.message = resp.error().String();
+      err.bucket_name = batch->bucket;
+      err.object_name = object.name;
+      err.version_id = object.version_id;
+      failed.errors.push_back(std::move(err));
+    }
+    return failed;
+  };
+  try {
+    inflight_->push_back(client_->GetExecutor()->Submit(remove));
+  } catch (const std::system_error&) {
+    std::promise<RemoveObjectsResponse> promise;
+    promise.set_value(remove());
+    inflight_->push_back(promise.get_future());
+  }
+}
+
+void RemoveObjectsResult::Populate() {
+  resp_.errors.clear();
+  while (resp_.errors.empty()) {
+    // Refill before waiting so max_inflight_ batches stay on the wire.
+    while (!done_ && inflight_->size() < max_inflight_) Submit();
+    if (inflight_->empty()) break;
+    resp_ = client_->GetExecutor()->Get(inflight_->front());
+    inflight_->pop_front();
   }
+  itr_ = resp_.errors.begin();
 }
 
 #ifdef MINIO_CPP_RDMA
@@ -458,9 +1014,8 @@ Client::Client(BaseUrl& base_url, creds::Provider* const provider)
     : BaseClient(base_url, provider) {}
 
 Result<StatObjectResponse> Client::CalculatePartCount(
-    size_t& part_count, std::list<ComposeSource> sources) {
-  size_t object_size = 0;
-  size_t i = 0;
+    size_t& part_count, std::list<ComposeSource>& sources,
+    unsigned int max_inflight) {
   for (auto& source : sources) {
     if (source.ssec != nullptr && !base_url_.https) {
       std::string msg = "source " + source.bucket + "/" + source.object;
@@ -470,18 +1025,46 @@ Result<StatObjectResponse> Client::CalculatePartCount(
       msg += ": SSE-C operation must be performed over a secure connection";
       return error::make<StatObjectResponse>(msg);
     }
+  }
 
-    i++;
+  // Stat the sources with bounded concurrency; results keep source order.
+  std::vector<Result<StatObjectResponse>> stats;
+  stats.reserve(sources.size());
+  {
+    std::deque<std::future<Result<StatObjectResponse>>> inflight;
+    error::Error first_err;
+    auto finish = [&]() {
+      auto resp = executor_->Get(inflight.front());
+      inflight.pop_front();
+      if (!resp && !first_err) first_err = resp.error();
+      stats.push_back(std::move(resp));
+    };
+    for (auto& source : sources) {
+      if (first_err) break;
+      if (inflight.size() >= max_inflight) finish();
+      StatObjectArgs soargs = source;
+      try {
+        inflight.push_back(
+            executor_->Submit([this, soargs = std::move(soargs)]() mutable {
+              return StatObject(std::move(soargs));
+            }));
+      } catch (const std::system_error& e) {
+        first_err =
+            error::Error(std::string("unable to create thread: ") + e.what());
+      }
+    }
+    while (!inflight.empty()) finish();
+    if (first_err) return tl::make_unexpected(first_err);
+  }
 
-    std::string etag;
-    size_t size;
+  size_t object_size = 0;
+  size_t i = 0;
+  for (auto& source : sources) {
+    const auto& resp = stats[i];
+    i++;
 
-    auto resp = StatObject(source);
-    if (!resp) {
-      return resp;
-    }
-    etag = resp->etag;
-    size = resp->size;
+    std::string etag = resp->etag;
+    size_t size = resp->size;
     if (error::Error err = source.BuildHeaders(size, etag)) {
       return tl::make_unexpected(err);
     }
@@ -547,9 +1130,12 @@ Result<StatObjectResponse> Client::CalculatePartCount(
 
 Result<ComposeObjectResponse> Client::ComposeObject(ComposeObjectArgs args,
                                                     std::string& upload_id) {
+  const unsigned int max_inflight =
+      ClampInflight(args.max_inflight_parts, kDefaultInflightParts);
+
   size_t part_count = 0;
   {
-    auto resp = CalculatePartCount(part_count, args.sources);
+    auto resp = CalculatePartCount(part_count, args.sources, max_inflight);
     if (!resp) {
       return tl::make_unexpected(resp.error());
     }
@@ -596,7 +1182,9 @@ Result<ComposeObjectResponse> Client::ComposeObject(ComposeObjectArgs args,
     }
   }
 
-  std::list<Part> parts;
+  // Plan every part copy in part-number order, then run them concurrently.
+  std::vector<UploadPartCopyArgs> copies;
+  copies.reserve(part_count);
   for (auto& source : args.sources) {
     size_t size = source.ObjectSize();
     if (source.length.has_value()) {
@@ -631,11 +1219,7 @@ Result<ComposeObjectResponse> Client::ComposeObject(ComposeObjectArgs args,
       upc_args.headers = headers;
       upc_args.upload_id = upload_id;
       upc_args.part_number = part_number;
-      auto resp = UploadPartCopy(upc_args);
-      if (!resp) {
-        return tl::make_unexpected(resp.error());
-      }
-      parts.push_back(Part(part_number, std::move(resp->etag)));
+      copies.push_back(std::move(upc_args));
     } else {
       while (size > 0) {
         part_number++;
@@ -657,19 +1241,46 @@ Result<ComposeObjectResponse> Client::ComposeObject(ComposeObjectArgs args,
         upc_args.headers = headerscopy;
         upc_args.upload_id = upload_id;
         upc_args.part_number = part_number;
-        {
-          auto resp = UploadPartCopy(upc_args);
-          if (!resp) {
-            return tl::make_unexpected(resp.error());
-          }
-          parts.push_back(Part(part_number, std::move(resp->etag)));
-        }
+        copies.push_back(std::move(upc_args));
         offset += length;
         size -= length;
       }
     }
   }
 
+  // Parts are collected in launch order, so they stay sorted by part number.
+  // The first failure stops further copies; the caller aborts the upload.
+  std::list<Part> parts;
+  std::deque<std::future<Result<UploadPartCopyResponse>>> inflight;
+  error::Error first_err;
+  auto finish = [&]() {
+    auto resp = executor_->Get(inflight.front());
+    inflight.pop_front();
+    if (first_err) return;
+    if (!resp) {
+      first_err = resp.error();
+      return;
+    }
+    parts.push_back(Part(static_cast<unsigned int>(parts.size() + 1),
+                         std::move(resp->etag)));
+  };
+  for (auto& upc_args : copies) {
+    if (first_err) break;
+    if (inflight.size() >= max_inflight) finish();
+    if (first_err) break;
+    try {
+      inflight.push_back(
+          executor_->Submit([this, upc_args = std::move(upc_args)]() mutable {
+            return UploadPartCopy(std::move(upc_args));
+          }));
+    } catch (const std::system_error& e) {
+      first_err =
+          error::Error(std::string("unable to create thread: ") + e.what());
+    }
+  }
+  while (!inflight.empty()) finish();
+  if (first_err) return tl::make_unexpected(first_err);
+
   CompleteMultipartUploadArgs cmu_args;
   cmu_args.bucket = args.bucket;
   cmu_args.region = args.region;
@@ -726,14 +1337,15 @@ Result<GetObjectResponse> Client::GetObject(GetObjectArgs args) {
       if (ret > 0) {
         GetObjectResponse go_result;
         go_result.etag = getCtx.etag;
+        go_result.size = size;
         return go_result;
       }
       // ret < 0 (retries exhausted) or kRDMANotSupported (server declined):
       // fall through to HTTP-into-buffer path below.
     }
 
-    // HTTP fallback: stream the body into the caller's buffer. pubsetbuf and
-    // the stream writes below are ordinary host stores, so a device pointer has
+    // HTTP fallback: receive the body into the caller's buffer. The copies out
+    // of the socket buffer are ordinary host stores, so a device pointer has
     // to be staged through host memory — writing straight into it faults
     // (SIGSEGV at the buffer address) the moment an RDMA GET declines, which is
     // exactly what concurrent GETs provoke.
@@ -751,9 +1363,6 @@ Result<GetObjectResponse> Client::GetObject(GetObjectArgs args) {
     }
 
     GetObjectArgs targs;
-    std::stringstream ss(std::ios_base::in | std::ios_base::out);
-    ss.rdbuf()->pubsetbuf(sink, size);
-
     targs.bucket = args.bucket;
     targs.object = args.object;
     targs.region = region;
@@ -763,12 +1372,13 @@ Result<GetObjectResponse> Client::GetObject(GetObjectArgs args) {
       targs.offset = static_cast<size_t>(range_offset);
       targs.length = size;
     }
-    targs.datafunc = [&ss = ss](minio::http::DataFunctionArgs args) -> bool {
-      ss << args.datachunk;
-      return true;
-    };
+    targs.buf = sink;
+    targs.size = size;
 
-    Result<GetObjectResponse> tresp = BaseClient::GetObject(targs);
+    targs.part_size = args.part_size;
+    targs.max_inflight_parts = args.max_inflight_parts;
+
+    Result<GetObjectResponse> tresp = ParallelGetObject(targs);
     if (tresp.has_value() && device_buf) {
       ScopedCudaContext ctx(GetCudaHostCopy(), args.buf);
       if (!ctx.Ok()) {
@@ -776,7 +1386,7 @@ Result<GetObjectResponse> Client::GetObject(GetObjectArgs args) {
             "unable to establish a CUDA context for the HTTP fallback copy");
       }
       if (GetCudaHostCopy().htod(reinterpret_cast<unsigned long long>(args.buf),
-                                 stage.data(), size) != 0) {
+                                 stage.data(), tresp->size) != 0) {
         return error::make<GetObjectResponse>(
             "unable to copy the staged HTTP body into device memory");
       }
@@ -785,7 +1395,191 @@ Result<GetObjectResponse> Client::GetObject(GetObjectArgs args) {
   }
 #endif
 
-  return BaseClient::GetObject(args);
+  return ParallelGetObject(std::move(args));
+}
+
+Result<GetObjectResponse> Client::ParallelGetObject(GetObjectArgs args) {
+  unsigned int max_inflight = args.max_inflight_parts.value_or(1);
+  if (max_inflight <= 1) return BaseClient::GetObject(std::move(args));
+
+  std::string region;
+  if (auto get_resp = GetRegion(args.bucket, args.region)) {
+    region = get_resp->region;
+  } else {
+    return tl::make_unexpected(get_resp.error());
+  }
+
+  // The object size and ETag decide the ranges; the caller's conditions are
+  // checked once here, and every range is then pinned to this ETag so a
+  // concurrent overwrite fails the download instead of mixing versions.
+  StatObjectArgs soargs;
+  soargs.extra_headers = args.extra_headers;
+  soargs.extra_query_params = args.extra_query_params;
+  soargs.bucket = args.bucket;
+  soargs.region = region;
+  soargs.object = args.object;
+  soargs.version_id = args.version_id;
+  soargs.ssec = args.ssec;
+  soargs.match_etag = args.match_etag;
+  soargs.not_match_etag = args.not_match_etag;
+  soargs.modified_since = args.modified_since;
+  soargs.unmodified_since = args.unmodified_since;
+  if (args.verify_checksum != ChecksumAlgorithm::kNone) {
+    soargs.extra_headers.Add("x-amz-checksum-mode", "ENABLED");
+  }
+  auto stat_resp = StatObject(soargs);
+  if (!stat_resp) return tl::make_unexpected(stat_resp.error());
+
+  const size_t object_size = stat_resp->size;
+  const size_t start = args.offset.value_or(0);
+  if (start > object_size) {
+    return error::make<GetObjectResponse>(
+        "offset " + std::to_string(start) + " is beyond object size " +
+        std::to_string(object_size));
+  }
+  size_t total = object_size - start;
+  if (args.length.has_value() && *args.length < total) total = *args.length;
+
+  const size_t part_size =
+      args.part_size > 0 ? args.part_size : kDefaultGetPartSize;
+  if (total <= part_size) return BaseClient::GetObject(std::move(args));
+
+  if (args.buf != nullptr && total > *args.size) {
+    return error::make<GetObjectResponse>(
+        "object range of " + std::to_string(total) +
+        " bytes exceeds buffer size " + std::to_string(*args.size));
+  }
+
+  const size_t part_count = (total + part_size - 1) / part_size;
+  max_inflight = ClampInflight(max_inflight, 1);
+  if (static_cast<size_t>(max_inflight) > part_count) {
+    max_inflight = static_cast<unsigned int>(part_count);
+  }
+
+  // Without a caller buffer, ranges land in a ring of part buffers and are
+  // handed to datafunc in order, so at most max_inflight parts are held.
+  std::vector<std::vector<char>> buf_pool;
+  if (args.buf == nullptr) buf_pool.resize(max_inflight);
+
+  struct InflightRange {
+    size_t offset;
+    size_t length;
+    char* buf;
+    std::future<Result<GetObjectResponse>> future;
+  };
+  std::deque<InflightRange> inflight;
+
+  http::Response data_response;
+  data_response.status_code = 200;
+  data_response.headers = stat_resp->headers;
+
+  // Ranges complete in order, so the checksum of a whole-object read runs
+  // over them as they are handed out.
+  std::optional<Checksum> checksum;
+  if (args.verify_checksum != ChecksumAlgorithm::kNone && start == 0 &&
+      total == object_size) {
+    checksum.emplace(args.verify_checksum);
+  }
+
+  error::Error first_err;
+  bool canceled = false;
+  double downloaded_bytes = 0;
+
+  auto finish = [&](InflightRange& ir) -> bool {
+    auto resp = executor_->Get(ir.future);
+    if (!resp) {
+      first_err = resp.error();
+      return false;
+    }
+    if (resp->size != ir.length) {
+      first_err = error::Error(
+          "short read at offset " + std::to_string(ir.offset) +
+          "; expected: " + std::to_string(ir.length) +
+          ", got: " + std::to_string(resp->size) + " bytes");
+      return false;
+    }
+    if (checksum) checksum->Update(ir.buf, ir.length);
+    if (args.buf == nullptr) {
+      http::DataFunctionArgs dargs(&data_response, args.userdata);
+      dargs.data = std::string_view(ir.buf, ir.length);
+      if (!args.zero_copy) dargs.datachunk.assign(ir.buf, ir.length);
+      if (!args.datafunc(std::move(dargs))) {
+        canceled = true;
+        return false;
+      }
+    }
+    if (args.progressfunc != nullptr) {
+      downloaded_bytes += static_cast<double>(ir.length);
+      http::ProgressFunctionArgs pargs;
+      pargs.download_total_bytes = static_cast<double>(total);
+      pargs.downloaded_bytes = downloaded_bytes;
+      pargs.userdata = args.progress_userdata;
+      if (!args.progressfunc(pargs)) {
+        first_err = error::Error("aborted by progress function");
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t i = 0; i < part_count; i++) {
+    if (inflight.size() >= max_inflight) {
+      InflightRange ir = std::move(inflight.front());
+      inflight.pop_front();
+      if (!finish(ir)) break;
+    }
+
+    GetObjectArgs range_args;
+    range_args.extra_headers = args.extra_headers;
+    range_args.extra_query_params = args.extra_query_params;
+    range_args.bucket = args.bucket;
+    range_args.region = region;
+    range_args.object = args.object;
+    range_args.version_id = args.version_id;
+    range_args.ssec = args.ssec;
+    range_args.match_etag = stat_resp->etag;
+    range_args.offset = start + i * part_size;
+    range_args.length = std::min(part_size, total - i * part_size);
+    if (args.buf != nullptr) {
+      range_args.buf = args.buf + i * part_size;
+    } else {
+      std::vector<char>& part_buf = buf_pool[i % max_inflight];
+      part_buf.resize(*range_args.length);
+      range_args.buf = part_buf.data();
+    }
+    range_args.size = *range_args.length;
+
+    InflightRange ir{*range_args.offset, *range_args.length, range_args.buf,
+                     {}};
+    ir.future =
+        executor_->Submit([this, range_args = std::move(range_args)]() mutable {
+          return BaseClient::GetObject(std::move(range_args));
+        });
+    inflight.push_back(std::move(ir));
+  }
+
+  // Remaining ranges write into buffers owned here; wait for all of them even
+  // after a failure.
+  while (!inflight.empty()) {
+    InflightRange ir = std::move(inflight.front());
+    inflight.pop_front();
+    if (first_err || canceled) {
+      executor_->Wait(ir.future);
+    } else {
+      finish(ir);
+    }
+  }
+
+  if (first_err) return tl::make_unexpected(first_err);
+  if (checksum && !canceled) {
+    if (error::Error err = checksum->Verify(stat_resp->headers)) {
+      return tl::make_unexpected(err);
+    }
+  }
+
+  GetObjectResponse resp(*stat_resp);
+  if (args.buf != nullptr) resp.size = total;
+  return resp;
 }
 
 Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
@@ -806,6 +1600,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
   std::string one_byte;
   bool stop = false;
   std::list<Part> parts;
+  bool declared_crc64nvme = false;
   std::optional<size_t> part_count = args.part_count;
   double uploaded_bytes = 0;           // for progress
   std::optional<double> upload_speed;  // for progress
@@ -883,6 +1678,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
       api_args.progressfunc = args.progressfunc;
       api_args.progress_userdata = args.progress_userdata;
       api_args.headers = headers;
+      api_args.payload_signing = args.payload_signing;
+      api_args.checksum = args.checksum;
 
       return BaseClient::PutObject(api_args);
     }
@@ -900,6 +1697,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
       // an algorithm was declared on Create).
       cmu_args.headers.Add("x-amz-checksum-algorithm", "CRC64NVME");
 #endif
+      declared_crc64nvme = DeclareChecksum(cmu_args.headers, args.checksum);
       auto cmu_resp = CreateMultipartUpload(cmu_args);
       if (cmu_resp) {
         upload_id = cmu_resp->upload_id;
@@ -917,6 +1715,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
     up_args.data = data;
     up_args.buf = buf;
     up_args.part_size = part_size;
+    up_args.payload_signing = args.payload_signing;
+    up_args.checksum = args.checksum;
 #ifdef MINIO_CPP_RDMA
     up_args.rdmaclient = args.rdmaclient;
     if (buf != nullptr && minio::rdma::Client::GetMemoryType(buf) ==
@@ -925,6 +1725,12 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
       up_args.checksum_crc64nvme = crc;
       up_args.headers.Add("x-amz-checksum-crc64nvme", crc);
     }
+#else
+    if (args.checksum == ChecksumAlgorithm::kCrc64Nvme) {
+      up_args.checksum_crc64nvme = utils::Crc64NvmeBase64(buf, part_size);
+      up_args.headers.Add("x-amz-checksum-crc64nvme",
+                          up_args.checksum_crc64nvme);
+    }
 #endif
     if (args.progressfunc != nullptr) {
       up_args.progressfunc =
@@ -975,9 +1781,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
               error::Error("aborted by progress function"));
         }
       }
-      // HTTP fallback leaves resp.checksum_crc64nvme empty; use the local CRC.
-      parts.push_back(Part(part_number, std::move(resp->etag),
-                           std::move(up_args.checksum_crc64nvme)));
+      parts.push_back(UploadedPart(part_number, part_size, *resp,
+                                   std::move(up_args.checksum_crc64nvme)));
     } else {
       return resp;
     }
@@ -989,6 +1794,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args,
   cmu_args.object = args.object;
   cmu_args.upload_id = upload_id;
   cmu_args.parts = parts;
+  SetCrc64Nvme(cmu_args, declared_crc64nvme);
   auto resp = CompleteMultipartUpload(cmu_args);
   if (!resp) {
     return tl::make_unexpected(resp.error());
@@ -1135,70 +1941,207 @@ Result<CopyObjectResponse> Client::CopyObject(CopyObjectArgs args) {
   return resp;
 }
 
-Result<DownloadObjectResponse> Client::DownloadObject(DownloadObjectArgs args) {
-  if (error::Error err = args.Validate()) {
-    return tl::make_unexpected(err);
-  }
+Result<DownloadObjectResponse> Client::DownloadObject(DownloadObjectArgs args) {
+  if (error::Error err = args.Validate()) {
+    return tl::make_unexpected(err);
+  }
+
+  if (args.ssec != nullptr && !base_url_.https) {
+    return error::make<DownloadObjectResponse>(
+        "SSE-C operation must be performed over a secure connection");
+  }
+
+  std::string region;
+  if (auto get_resp = GetRegion(args.bucket, args.region)) {
+    region = get_resp->region;
+  } else {
+    return tl::make_unexpected(get_resp.error());
+  }
+
+  StatObjectArgs soargs;
+  soargs.bucket = args.bucket;
+  soargs.region = region;
+  soargs.object = args.object;
+  soargs.version_id = args.version_id;
+  soargs.ssec = args.ssec;
+  auto stat_resp = StatObject(soargs);
+  if (!stat_resp) {
+    return tl::make_unexpected(stat_resp.error());
+  }
+  const std::string etag = stat_resp->etag;
+  const uint64_t object_size = stat_resp->size;
+
+  const size_t part_size =
+      args.part_size > 0 ? args.part_size : kDefaultGetPartSize;
+  const size_t part_count =
+      static_cast<size_t>((object_size + part_size - 1) / part_size);
+  const unsigned int max_inflight = ClampInflight(args.max_inflight_parts, 1);
+
+  // Keep the temporary names paths so non-ASCII names survive on Windows.
+  // The ETag in the name ties both files to one object version.
+  std::filesystem::path temp_filename = args.filename;
+  temp_filename += "." + utils::UriEncode(etag) + ".part.minio";
+  std::filesystem::path journal_filename = temp_filename;
+  journal_filename += ".journal";
+
+  const std::string header = JournalHeader(etag, object_size, part_size);
+  std::error_code ec;
+  std::vector<bool> done(part_count, false);
+  if (std::filesystem::exists(temp_filename, ec)) {
+    done = ReadJournal(journal_filename, header, part_count);
+  }
+  const bool resume = std::find(done.begin(), done.end(), true) != done.end();
+
+  PartFile file;
+  if (error::Error err = file.Open(temp_filename, object_size, !resume)) {
+    return tl::make_unexpected(err);
+  }
+
+  std::ofstream journal;
+  if (resume) {
+    journal.open(journal_filename,
+                 std::ios::app | std::ios::out | std::ios::binary);
+  } else {
+    journal.open(journal_filename,
+                 std::ios::trunc | std::ios::out | std::ios::binary);
+    journal << header << '\n';
+    journal.flush();
+  }
+  if (!journal.is_open() || !journal) {
+    return error::make<DownloadObjectResponse>(
+        "unable to open file " + utils::PathToUtf8(journal_filename));
+  }
+
+  double downloaded_bytes = 0;
+  for (size_t i = 0; i < part_count; i++) {
+    if (done[i]) {
+      downloaded_bytes +=
+          static_cast<double>(std::min<uint64_t>(part_size,
+                                                 object_size - i * part_size));
+    }
+  }
+
+  struct InflightRange {
+    size_t part;
+    size_t length;
+    std::shared_ptr<size_t> written;
+    std::future<Result<GetObjectResponse>> future;
+  };
+  std::deque<InflightRange> inflight;
+  error::Error first_err;
+
+  auto finish = [&](InflightRange& ir) -> bool {
+    auto resp = executor_->Get(ir.future);
+    if (!resp) {
+      first_err = resp.error();
+      return false;
+    }
+    if (*ir.written != ir.length) {
+      first_err = error::Error(
+          "unable to write part " + std::to_string(ir.part) + " to " +
+          utils::PathToUtf8(temp_filename) + "; expected: " +
+          std::to_string(ir.length) +
+          ", written: " + std::to_string(*ir.written) + " bytes");
+      return false;
+    }
+    // Journal a part only once its bytes are durable, so a resumed download
+    // never trusts a range lost in a crash.
+    if (!file.Sync()) {
+      first_err = error::Error("unable to sync file " +
+                               utils::PathToUtf8(temp_filename));
+      return false;
+    }
+    journal << ir.part << '\n';
+    journal.flush();
+    if (args.progressfunc != nullptr) {
+      downloaded_bytes += static_cast<double>(ir.length);
+      http::ProgressFunctionArgs pargs;
+      pargs.download_total_bytes = static_cast<double>(object_size);
+      pargs.downloaded_bytes = downloaded_bytes;
+      pargs.userdata = args.progress_userdata;
+      if (!args.progressfunc(pargs)) {
+        first_err = error::Error("aborted by progress function");
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t i = 0; i < part_count && !first_err; i++) {
+    if (done[i]) continue;
+
+    if (inflight.size() >= max_inflight) {
+      InflightRange ir = std::move(inflight.front());
+      inflight.pop_front();
+      if (!finish(ir)) break;
+    }
+
+    const uint64_t offset = static_cast<uint64_t>(i) * part_size;
+    const size_t length = static_cast<size_t>(
+        std::min<uint64_t>(part_size, object_size - offset));
+
+    GetObjectArgs range_args;
+    range_args.extra_headers = args.extra_headers;
+    range_args.extra_query_params = args.extra_query_params;
+    range_args.bucket = args.bucket;
+    range_args.region = region;
+    range_args.object = args.object;
+    range_args.version_id = args.version_id;
+    range_args.ssec = args.ssec;
+    range_args.match_etag = etag;
+    range_args.offset = static_cast<size_t>(offset);
+    range_args.length = length;
+
+    // Each chunk goes straight from the socket buffer to its file offset.
+    auto written = std::make_shared<size_t>(0);
+    range_args.datafunc = [&file, offset, length,
+                           written](http::DataFunctionArgs args) -> bool {
+      if (args.data.size() > length - *written) return false;
+      if (!file.WriteAt(args.data.data(), args.data.size(),
+                        offset + *written)) {
+        return false;
+      }
+      *written += args.data.size();
+      return true;
+    };
+    range_args.zero_copy = true;
 
-  if (args.ssec != nullptr && !base_url_.https) {
-    return error::make<DownloadObjectResponse>(
-        "SSE-C operation must be performed over a secure connection");
+    InflightRange ir{i, length, written, {}};
+    ir.future =
+        executor_->Submit([this, range_args = std::move(range_args)]() mutable {
+          return BaseClient::GetObject(std::move(range_args));
+        });
+    inflight.push_back(std::move(ir));
   }
 
-  std::string etag;
-  {
-    StatObjectArgs soargs;
-    soargs.bucket = args.bucket;
-    soargs.region = args.region;
-    soargs.object = args.object;
-    soargs.version_id = args.version_id;
-    soargs.ssec = args.ssec;
-    auto resp = StatObject(soargs);
-    if (!resp) {
-      return tl::make_unexpected(resp.error());
+  // Remaining ranges write through this frame's file; wait for all of them.
+  while (!inflight.empty()) {
+    InflightRange ir = std::move(inflight.front());
+    inflight.pop_front();
+    if (first_err) {
+      executor_->Wait(ir.future);
+    } else {
+      finish(ir);
     }
-    etag = resp->etag;
   }
 
-  // Keep the temporary name a path so non-ASCII names survive on Windows
-  // (ofstream's path overload uses the wide API there).
-  std::filesystem::path temp_filename = args.filename;
-  temp_filename += "." + utils::UriEncode(etag) + ".part.minio";
-  std::ofstream fout(temp_filename,
-                     std::ios::trunc | std::ios::out | std::ios::binary);
-  if (!fout.is_open()) {
+  journal.close();
+  const bool closed = file.Close();
+  if (first_err) return tl::make_unexpected(first_err);
+  if (!closed) {
     return error::make<DownloadObjectResponse>(
-        "unable to open file " + utils::PathToUtf8(temp_filename));
-  }
-
-  std::string region;
-  if (auto get_resp = GetRegion(args.bucket, args.region)) {
-    region = get_resp->region;
-  } else {
-    return tl::make_unexpected(get_resp.error());
+        "unable to close file " + utils::PathToUtf8(temp_filename));
   }
 
-  Request req(http::Method::kGet, region, base_url_, args.extra_headers,
-              args.extra_query_params);
-  req.bucket_name = args.bucket;
-  req.object_name = args.object;
-  if (!args.version_id.empty()) {
-    req.query_params.Add("versionId", args.version_id);
+  std::filesystem::rename(temp_filename, args.filename, ec);
+  if (ec) {
+    return error::make<DownloadObjectResponse>(
+        "unable to rename " + utils::PathToUtf8(temp_filename) + " to " +
+        utils::PathToUtf8(args.filename) + ": " + ec.message());
   }
-  req.datafunc = [&fout = fout](http::DataFunctionArgs args) -> bool {
-    fout << args.datachunk;
-    return true;
-  };
-  req.progressfunc = args.progressfunc;
-  req.progress_userdata = args.progress_userdata;
+  std::filesystem::remove(journal_filename, ec);
 
-  auto response = Execute(req);
-  fout.close();
-  if (response) {
-    std::filesystem::rename(temp_filename, args.filename);
-    return DownloadObjectResponse(std::move(*response));
-  }
-  return tl::make_unexpected(response.error());
+  return DownloadObjectResponse(*stat_resp);
 }
 
 ListObjectsResult Client::ListObjects(ListObjectsArgs args) {
@@ -1253,6 +2196,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
       if (ret > 0) {
         PutObjectResponse resp;
         resp.etag = putCtx.etag;
+        resp.checksum_crc64nvme = putCtx.checksum;
         return resp;
       }
       // ret < 0 / kRDMANotSupported: fall through to HTTP-from-buffer.
@@ -1303,6 +2247,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
     api_args.data = std::string_view(src, size);
     api_args.buf = src;
     api_args.size = size;
+    api_args.checksum = args.checksum;
     api_args.headers.Add("x-amz-content-sha256", "UNSIGNED-PAYLOAD");
     return BaseClient::PutObject(api_args);
   }
@@ -1372,6 +2317,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
     std::string one_byte;
     bool stop = false;
     std::list<Part> parts;
+    bool declared_crc64nvme = false;
     std::optional<size_t> part_count = args.part_count;
     std::string upload_id;
     error::Error first_err;
@@ -1459,13 +2405,13 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
       if (inflight.size() >= max_inflight) {
         InflightPart ip = std::move(inflight.front());
         inflight.pop_front();
-        auto up_resp = ip.future.get();
+        auto up_resp = executor_->Get(ip.future);
         if (!up_resp) {
           first_err = up_resp.error();
           break;
         }
-        parts.push_back(Part(ip.part_number, std::move(up_resp->etag),
-                             std::move(ip.checksum_crc64nvme)));
+        parts.push_back(UploadedPart(ip.part_number, ip.part_bytes, *up_resp,
+                                     std::move(ip.checksum_crc64nvme)));
         if (!report_progress(ip.part_bytes)) {
           break;
         }
@@ -1493,6 +2439,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
         api_args.progressfunc = args.progressfunc;
         api_args.progress_userdata = args.progress_userdata;
         api_args.headers = headers;
+        api_args.payload_signing = args.payload_signing;
+        api_args.checksum = args.checksum;
         return BaseClient::PutObject(api_args);
       }
 
@@ -1507,6 +2455,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
 #ifdef MINIO_CPP_RDMA
         cmu_args.headers.Add("x-amz-checksum-algorithm", "CRC64NVME");
 #endif
+        declared_crc64nvme = DeclareChecksum(cmu_args.headers, args.checksum);
         if (auto cmu_resp = CreateMultipartUpload(cmu_args)) {
           upload_id = cmu_resp->upload_id;
         } else {
@@ -1515,7 +2464,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
         }
       }
 
-      // Build UploadPartArgs and dispatch via std::async.
+      // Build UploadPartArgs and dispatch to the executor.
       UploadPartArgs up_args;
       up_args.bucket = args.bucket;
       up_args.region = args.region;
@@ -1525,6 +2474,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
       up_args.data = std::string_view(buf, part_size);
       up_args.buf = buf;
       up_args.part_size = part_size;
+      up_args.payload_signing = args.payload_signing;
+      up_args.checksum = args.checksum;
 #ifdef MINIO_CPP_RDMA
       if (rdma_regs[buf_idx].client != nullptr) {
         up_args.rdmaclient = &rdma_client;
@@ -1535,6 +2486,12 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
         up_args.checksum_crc64nvme = crc;
         up_args.headers.Add("x-amz-checksum-crc64nvme", crc);
       }
+#else
+      if (args.checksum == ChecksumAlgorithm::kCrc64Nvme) {
+        up_args.checksum_crc64nvme = utils::Crc64NvmeBase64(buf, part_size);
+        up_args.headers.Add("x-amz-checksum-crc64nvme",
+                            up_args.checksum_crc64nvme);
+      }
 #endif
       if (headers.Contains("x-amz-content-sha256")) {
         up_args.headers.Add("x-amz-content-sha256",
@@ -1551,9 +2508,8 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
       ip.checksum_crc64nvme = up_args.checksum_crc64nvme;
       ip.part_bytes = part_size;
       try {
-        ip.future = std::async(std::launch::async, [this, up_args]() {
-          return UploadPart(up_args);
-        });
+        ip.future = executor_->Submit(
+            [this, up_args]() { return UploadPart(up_args); });
       } catch (const std::system_error& e) {
         first_err =
             error::Error(std::string("unable to create thread: ") + e.what());
@@ -1568,13 +2524,13 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
     while (!inflight.empty()) {
       InflightPart ip = std::move(inflight.front());
       inflight.pop_front();
-      auto drain_resp = ip.future.get();
+      auto drain_resp = executor_->Get(ip.future);
       if (!drain_resp) {
         if (!first_err) first_err = drain_resp.error();
         continue;
       }
-      parts.push_back(Part(ip.part_number, std::move(drain_resp->etag),
-                           std::move(ip.checksum_crc64nvme)));
+      parts.push_back(UploadedPart(ip.part_number, ip.part_bytes, *drain_resp,
+                                   std::move(ip.checksum_crc64nvme)));
       if (!first_err) report_progress(ip.part_bytes);
     }
 
@@ -1597,6 +2553,7 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
     cmu_args.object = args.object;
     cmu_args.upload_id = upload_id;
     cmu_args.parts = parts;
+    SetCrc64Nvme(cmu_args, declared_crc64nvme);
     auto cmu_resp = CompleteMultipartUpload(cmu_args);
     if (cmu_resp && args.progressfunc != nullptr) {
       http::ProgressFunctionArgs actual_args;
@@ -1618,6 +2575,37 @@ Result<PutObjectResponse> Client::PutObject(PutObjectArgs args) {
     return PutObjectResponse(std::move(*cmu_resp));
   }
 
+  // A single-part object of known size goes straight from the stream to the
+  // socket instead of through a part-sized buffer. Unless payload_signing
+  // says otherwise, the body is sent as UNSIGNED-PAYLOAD over TLS and signed
+  // chunk by chunk over plain HTTP.
+  if (args.stream != nullptr && args.part_count.has_value() &&
+      *args.part_count == 1
+#ifdef MINIO_CPP_RDMA
+      && !SharedRDMAClient().Ready()
+#endif
+  ) {
+    PutObjectApiArgs api_args;
+    api_args.extra_query_params = args.extra_query_params;
+    api_args.bucket = args.bucket;
+    api_args.region = args.region;
+    api_args.object = args.object;
+    api_args.headers = args.Headers();
+    if (!api_args.headers.Contains("Content-Type")) {
+      api_args.headers.Add("Content-Type", args.content_type.empty()
+                                               ? "application/octet-stream"
+                                               : args.content_type);
+    }
+    api_args.bodyfunc = http::StreamBody(*args.stream);
+    api_args.size = static_cast<size_t>(*args.object_size);
+    api_args.payload_signing = args.payload_signing;
+    api_args.checksum = args.checksum;
+    api_args.buf = nullptr;
+    api_args.progressfunc = args.progressfunc;
+    api_args.progress_userdata = args.progress_userdata;
+    return BaseClient::PutObject(api_args);
+  }
+
   void* raw = nullptr;
   if (AlignedAlloc(
           &raw, GetPageSize(),
@@ -1668,10 +2656,39 @@ Result<UploadObjectResponse> Client::UploadObject(UploadObjectArgs args) {
     return tl::make_unexpected(err);
   }
 
+  if (args.sse != nullptr && args.sse->TlsRequired() && !base_url_.https) {
+    return error::make<UploadObjectResponse>(
+        "SSE operation must be performed over a secure connection");
+  }
+
+  unsigned int max_inflight =
+      args.max_inflight_parts.value_or(kDefaultInflightParts);
+
+  // The file size is known, so every part is a fixed range of the file,
+  // read by its own upload into a buffer of its own. An empty file, and RDMA
+  // uploads (which register their own part buffers), take the stream path
+  // below.
+  SourceFile source;
+  bool use_ranges = *args.object_size > 0;
+#ifdef MINIO_CPP_RDMA
+  use_ranges = use_ranges && !SharedRDMAClient().Ready();
+#endif
+  if (use_ranges && source.Open(args.filename)) {
+    const std::string filename = utils::PathToUtf8(args.filename);
+    return UploadObject(
+        std::move(args), max_inflight,
+        [&source, filename](char* data, size_t length,
+                            uint64_t offset) -> error::Error {
+          if (source.ReadAt(data, length, offset)) return error::SUCCESS;
+          return error::Error("unable to read file " + filename +
+                              "; it may have been truncated during upload");
+        });
+  }
+
   std::ifstream file;
   file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
   try {
-    file.open(args.filename);
+    file.open(args.filename, std::ios::binary);
   } catch (std::system_error& err) {
     return error::make<UploadObjectResponse>("unable to open file " +
                                              utils::PathToUtf8(args.filename) +
@@ -1691,8 +2708,11 @@ Result<UploadObjectResponse> Client::UploadObject(UploadObjectArgs args) {
   po_args.retention = std::move(args.retention);
   po_args.legal_hold = std::move(args.legal_hold);
   po_args.content_type = std::move(args.content_type);
+  po_args.payload_signing = args.payload_signing;
+  po_args.checksum = args.checksum;
   po_args.progressfunc = std::move(args.progressfunc);
   po_args.progress_userdata = std::move(args.progress_userdata);
+  po_args.max_inflight_parts = max_inflight;
 
   auto resp = PutObject(std::move(po_args));
   file.close();
@@ -1702,6 +2722,511 @@ Result<UploadObjectResponse> Client::UploadObject(UploadObjectArgs args) {
   return tl::make_unexpected(resp.error());
 }
 
+Result<UploadObjectResponse> Client::UploadObject(
+    UploadObjectArgs args, unsigned int max_inflight,
+    const std::function<error::Error(char*, size_t, uint64_t)>& read_at) {
+  const uint64_t object_size = *args.object_size;
+  const size_t part_size = args.part_size;
+  const size_t part_count = *args.part_count;
+
+  utils::Multimap headers = args.Headers();
+  if (!headers.Contains("Content-Type")) {
+    if (args.content_type.empty()) {
+      headers.Add("Content-Type", "application/octet-stream");
+    } else {
+      headers.Add("Content-Type", args.content_type);
+    }
+  }
+
+  if (part_count == 1) {
+    std::string data(static_cast<size_t>(object_size), '\0');
+    if (error::Error err = read_at(data.data(), data.size(), 0)) {
+      return tl::make_unexpected(err);
+    }
+    PutObjectApiArgs api_args;
+    api_args.extra_headers = args.extra_headers;
+    api_args.extra_query_params = args.extra_query_params;
+    api_args.bucket = args.bucket;
+    api_args.region = args.region;
+    api_args.object = args.object;
+    api_args.data = data;
+    api_args.buf = nullptr;
+    api_args.size = static_cast<size_t>(object_size);
+    api_args.headers = headers;
+    api_args.payload_signing = args.payload_signing;
+    api_args.checksum = args.checksum;
+    api_args.progressfunc = args.progressfunc;
+    api_args.progress_userdata = args.progress_userdata;
+    auto resp = BaseClient::PutObject(api_args);
+    if (!resp) return tl::make_unexpected(resp.error());
+    return UploadObjectResponse(std::move(*resp));
+  }
+
+  max_inflight = ClampInflight(max_inflight, 1);
+  if (static_cast<size_t>(max_inflight) > part_count) {
+    max_inflight = static_cast<unsigned int>(part_count);
+  }
+
+  CreateMultipartUploadArgs cmu_args;
+  cmu_args.extra_query_params = args.extra_query_params;
+  cmu_args.bucket = args.bucket;
+  cmu_args.region = args.region;
+  cmu_args.object = args.object;
+  cmu_args.headers = headers;
+  const bool declared_crc64nvme =
+      DeclareChecksum(cmu_args.headers, args.checksum);
+  std::string upload_id;
+  if (auto cmu_resp = CreateMultipartUpload(cmu_args)) {
+    upload_id = cmu_resp->upload_id;
+  } else {
+    return tl::make_unexpected(cmu_resp.error());
+  }
+
+  struct InflightPart {
+    unsigned int part_number;
+    size_t part_bytes;
+    std::future<Result<UploadPartResponse>> future;
+  };
+  std::deque<InflightPart> inflight;
+  std::list<Part> parts;
+  error::Error first_err;
+  double uploaded_bytes = 0;
+
+  auto finish = [&](InflightPart& ip) -> bool {
+    auto up_resp = executor_->Get(ip.future);
+    if (!up_resp) {
+      first_err = up_resp.error();
+      return false;
+    }
+    parts.push_back(UploadedPart(ip.part_number, ip.part_bytes, *up_resp, ""));
+    if (args.progressfunc != nullptr) {
+      uploaded_bytes += static_cast<double>(ip.part_bytes);
+      http::ProgressFunctionArgs actual_args;
+      actual_args.upload_total_bytes = static_cast<double>(object_size);
+      actual_args.uploaded_bytes = uploaded_bytes;
+      actual_args.userdata = args.progress_userdata;
+      if (!args.progressfunc(actual_args)) {
+        first_err = error::Error("aborted by progress function");
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (size_t i = 0; i < part_count; i++) {
+    if (inflight.size() >= max_inflight) {
+      InflightPart ip = std::move(inflight.front());
+      inflight.pop_front();
+      if (!finish(ip)) break;
+    }
+
+    const uint64_t offset = static_cast<uint64_t>(i) * part_size;
+    const size_t length = static_cast<size_t>(
+        std::min<uint64_t>(part_size, object_size - offset));
+
+    UploadPartArgs up_args;
+    up_args.bucket = args.bucket;
+    up_args.region = args.region;
+    up_args.object = args.object;
+    up_args.upload_id = upload_id;
+    up_args.part_number = static_cast<unsigned int>(i + 1);
+    up_args.buf = nullptr;
+    up_args.part_size = length;
+    up_args.payload_signing = args.payload_signing;
+    up_args.checksum = args.checksum;
+    if (headers.Contains("x-amz-content-sha256")) {
+      up_args.headers.Add("x-amz-content-sha256",
+                          headers.GetFront("x-amz-content-sha256"));
+    }
+    if (args.sse != nullptr) {
+      if (SseCustomerKey* ssec = dynamic_cast<SseCustomerKey*>(args.sse)) {
+        up_args.headers.AddAll(ssec->Headers());
+      }
+    }
+
+    InflightPart ip;
+    ip.part_number = up_args.part_number;
+    ip.part_bytes = length;
+    try {
+      // The part is read when its upload starts, so at most max_inflight
+      // part buffers are held at once.
+      ip.future = executor_->Submit(
+          [this, up_args, offset, &read_at]() -> Result<UploadPartResponse> {
+            std::string data(up_args.part_size, '\0');
+            if (error::Error err = read_at(data.data(), data.size(), offset)) {
+              return tl::make_unexpected(err);
+            }
+            UploadPartArgs part_args = up_args;
+            part_args.data = data;
+            if (part_args.checksum == ChecksumAlgorithm::kCrc64Nvme) {
+              part_args.checksum_crc64nvme =
+                  utils::Crc64NvmeBase64(data.data(), data.size());
+              part_args.headers.Add("x-amz-checksum-crc64nvme",
+                                    part_args.checksum_crc64nvme);
+            }
+            auto resp = UploadPart(part_args);
+            // The completion entry takes the locally computed checksum.
+            if (resp && !part_args.checksum_crc64nvme.empty()) {
+              resp->checksum_crc64nvme = part_args.checksum_crc64nvme;
+            }
+            return resp;
+          });
+    } catch (const std::system_error& e) {
+      first_err =
+          error::Error(std::string("unable to create thread: ") + e.what());
+      break;
+    }
+    inflight.push_back(std::move(ip));
+  }
+
+  // Parts in flight read through read_at; wait for all of them.
+  while (!inflight.empty()) {
+    InflightPart ip = std::move(inflight.front());
+    inflight.pop_front();
+    if (first_err) {
+      executor_->Wait(ip.future);
+    } else {
+      finish(ip);
+    }
+  }
+
+  Result<CompleteMultipartUploadResponse> cmu_resp =
+      tl::make_unexpected(first_err);
+  if (!first_err) {
+    CompleteMultipartUploadArgs cmpu_args;
+    cmpu_args.bucket = args.bucket;
+    cmpu_args.region = args.region;
+    cmpu_args.object = args.object;
+    cmpu_args.upload_id = upload_id;
+    cmpu_args.parts = std::move(parts);
+    SetCrc64Nvme(cmpu_args, declared_crc64nvme);
+    cmu_resp = CompleteMultipartUpload(cmpu_args);
+  }
+  if (!cmu_resp) {
+    AbortMultipartUploadArgs amu_args;
+    amu_args.bucket = std::move(args.bucket);
+    amu_args.region = std::move(args.region);
+    amu_args.object = std::move(args.object);
+    amu_args.upload_id = upload_id;
+    (void)AbortMultipartUpload(amu_args);
+    return tl::make_unexpected(cmu_resp.error());
+  }
+  return UploadObjectResponse(PutObjectResponse(std::move(*cmu_resp)));
+}
+
+Result<TransferObjectResponse> Client::TransferObject(BaseClient& source_client,
+                                                      TransferObjectArgs args) {
+  std::string upload_id;
+  auto resp = TransferObject(source_client, args, upload_id);
+  if (!resp && !upload_id.empty()) {
+    AbortMultipartUploadArgs amu_args;
+    amu_args.bucket = args.bucket;
+    amu_args.region = args.region;
+    amu_args.object = args.object;
+    amu_args.upload_id = upload_id;
+    (void)AbortMultipartUpload(amu_args);
+  }
+  return resp;
+}
+
+Result<TransferObjectResponse> Client::TransferObject(BaseClient& source_client,
+                                                      TransferObjectArgs args,
+                                                      std::string& upload_id) {
+  if (error::Error err = args.Validate()) {
+    return tl::make_unexpected(err);
+  }
+
+  if (args.sse != nullptr && args.sse->TlsRequired() && !base_url_.https) {
+    return error::make<TransferObjectResponse>(
+        "SSE operation must be performed over a secure connection");
+  }
+
+  // Parts kept from an earlier attempt were read from the source as it was
+  // then; source.match_etag pins that version, so a resumed upload is never
+  // completed from two versions of the source.
+  const bool resuming = !upload_id.empty();
+  if (resuming && args.source.match_etag.empty()) {
+    return error::make<TransferObjectResponse>(
+        "source.match_etag must be set to resume a transfer");
+  }
+
+  StatObjectArgs soargs = args.source;
+  soargs.offset.reset();
+  soargs.length.reset();
+  soargs.match_etag.clear();
+  auto stat_resp = source_client.StatObject(soargs);
+  if (!stat_resp) return tl::make_unexpected(stat_resp.error());
+  const std::string etag = stat_resp->etag;
+  const uint64_t object_size = stat_resp->size;
+
+  if (!args.source.match_etag.empty() &&
+      utils::Trim(args.source.match_etag, '"') != etag) {
+    if (resuming) {
+      AbortMultipartUploadArgs amu_args;
+      amu_args.bucket = args.bucket;
+      amu_args.region = args.region;
+      amu_args.object = args.object;
+      amu_args.upload_id = upload_id;
+      (void)AbortMultipartUpload(amu_args);
+      upload_id.clear();
+    }
+    return error::make<TransferObjectResponse>(
+        "source object changed; ETag " + etag + " does not match " +
+        args.source.match_etag);
+  }
+
+  if (args.preserve_tags && args.tags.empty()) {
+    GetObjectTagsArgs gt_args;
+    gt_args.bucket = args.source.bucket;
+    gt_args.region = args.source.region;
+    gt_args.object = args.source.object;
+    gt_args.version_id = args.source.version_id;
+    auto tags_resp = source_client.GetObjectTags(gt_args);
+    if (!tags_resp) return tl::make_unexpected(tags_resp.error());
+    args.tags = std::move(tags_resp->tags);
+  }
+
+  utils::Multimap headers = args.Headers();
+  if (args.preserve_metadata) {
+    for (const char* name :
+         {"Content-Type", "Cache-Control", "Content-Encoding",
+          "Content-Disposition", "Content-Language", "Expires"}) {
+      if (headers.Contains(name)) continue;
+      std::string value = stat_resp->headers.GetFront(name);
+      if (!value.empty()) headers.Add(name, value);
+    }
+    if (!args.user_metadata) {
+      for (const auto& entry : stat_resp->user_metadata) {
+        headers.Add("x-amz-meta-" + entry.key, entry.value);
+      }
+    }
+  }
+  if (!headers.Contains("Content-Type")) {
+    headers.Add("Content-Type", "application/octet-stream");
+  }
+
+  size_t part_size = args.part_size;
+  std::optional<size_t> part_count;
+  if (error::Error err = utils::CalcPartInfo(object_size, part_size,
+                                             part_count)) {
+    return tl::make_unexpected(err);
+  }
+
+  auto range_args = [&](size_t offset, size_t length, char* buf) {
+    GetObjectArgs get_args;
+    get_args.bucket = args.source.bucket;
+    get_args.region = args.source.region;
+    get_args.object = args.source.object;
+    get_args.version_id = args.source.version_id;
+    get_args.ssec = args.source.ssec;
+    get_args.match_etag = etag;
+    get_args.offset = offset;
+    get_args.length = length;
+    get_args.buf = buf;
+    get_args.size = length;
+    return get_args;
+  };
+
+  // A single part is fetched whole and sent as one PUT.
+  if (*part_count <= 1) {
+    std::vector<char> buf(static_cast<size_t>(object_size));
+    if (object_size > 0) {
+      auto get_resp = source_client.GetObject(
+          range_args(0, static_cast<size_t>(object_size), buf.data()));
+      if (!get_resp) return tl::make_unexpected(get_resp.error());
+      if (get_resp->size != object_size) {
+        return error::make<TransferObjectResponse>(
+            "source object changed size during transfer");
+      }
+    }
+    PutObjectApiArgs api_args;
+    api_args.extra_headers = args.extra_headers;
+    api_args.extra_query_params = args.extra_query_params;
+    api_args.bucket = args.bucket;
+    api_args.region = args.region;
+    api_args.object = args.object;
+    api_args.data = std::string_view(buf.data(), buf.size());
+    api_args.buf = nullptr;
+    api_args.size = buf.size();
+    api_args.headers = headers;
+    api_args.progressfunc = args.progressfunc;
+    api_args.progress_userdata = args.progress_userdata;
+    auto resp = BaseClient::PutObject(api_args);
+    if (!resp) return tl::make_unexpected(resp.error());
+    return TransferObjectResponse(std::move(*resp));
+  }
+
+  // Parts already uploaded under a resumed upload, keyed by part number.
+  std::map<unsigned int, Part> done;
+  if (upload_id.empty()) {
+    CreateMultipartUploadArgs cmu_args;
+    cmu_args.extra_query_params = args.extra_query_params;
+    cmu_args.bucket = args.bucket;
+    cmu_args.region = args.region;
+    cmu_args.object = args.object;
+    cmu_args.headers = headers;
+    if (auto cmu_resp = CreateMultipartUpload(cmu_args)) {
+      upload_id = cmu_resp->upload_id;
+    } else {
+      return tl::make_unexpected(cmu_resp.error());
+    }
+  } else {
+    ListPartsArgs lp_args;
+    lp_args.bucket = args.bucket;
+    lp_args.region = args.region;
+    lp_args.object = args.object;
+    lp_args.upload_id = upload_id;
+    while (true) {
+      auto lp_resp = ListParts(lp_args);
+      if (!lp_resp) return tl::make_unexpected(lp_resp.error());
+      for (auto& part : lp_resp->parts) done[part.number] = std::move(part);
+      if (!lp_resp->is_truncated) break;
+      lp_args.part_number_marker = lp_resp->next_part_number_marker;
+    }
+  }
+
+  const unsigned int max_inflight = static_cast<unsigned int>(std::min<size_t>(
+      ClampInflight(args.max_inflight_parts, kDefaultInflightParts),
+      *part_count));
+
+  utils::Multimap part_headers;
+  if (headers.Contains("x-amz-content-sha256")) {
+    part_headers.Add("x-amz-content-sha256",
+                     headers.GetFront("x-amz-content-sha256"));
+  }
+  if (args.sse != nullptr) {
+    if (SseCustomerKey* ssec = dynamic_cast<SseCustomerKey*>(args.sse)) {
+      part_headers.AddAll(ssec->Headers());
+    }
+  }
+
+  // Each pipeline fetches one range into a ring slot and uploads it from
+  // there; a slot is reused only after its pipeline has been collected.
+  std::vector<std::vector<char>> buf_pool(max_inflight);
+
+  struct InflightPart {
+    unsigned int part_number;
+    size_t part_bytes;
+    std::future<Result<UploadPartResponse>> future;
+  };
+  std::deque<InflightPart> inflight;
+  error::Error first_err;
+  double transferred_bytes = 0;
+
+  auto report_progress = [&](size_t part_bytes) -> bool {
+    if (args.progressfunc == nullptr) return true;
+    transferred_bytes += static_cast<double>(part_bytes);
+    http::ProgressFunctionArgs actual_args;
+    actual_args.upload_total_bytes = static_cast<double>(object_size);
+    actual_args.uploaded_bytes = transferred_bytes;
+    actual_args.userdata = args.progress_userdata;
+    if (!args.progressfunc(actual_args)) {
+      first_err = error::Error("aborted by progress function");
+      return false;
+    }
+    return true;
+  };
+
+  auto finish = [&](InflightPart& ip) -> bool {
+    auto up_resp = executor_->Get(ip.future);
+    if (!up_resp) {
+      first_err = up_resp.error();
+      return false;
+    }
+    done[ip.part_number] = Part(ip.part_number, std::move(up_resp->etag));
+    return report_progress(ip.part_bytes);
+  };
+
+  size_t launched = 0;
+  for (size_t i = 0; i < *part_count && !first_err; i++) {
+    const unsigned int part_number = static_cast<unsigned int>(i + 1);
+    const uint64_t offset = static_cast<uint64_t>(i) * part_size;
+    const size_t length = static_cast<size_t>(
+        std::min<uint64_t>(part_size, object_size - offset));
+
+    auto it = done.find(part_number);
+    if (it != done.end() && it->second.size == length) {
+      if (!report_progress(length)) break;
+      continue;
+    }
+
+    if (inflight.size() >= max_inflight) {
+      InflightPart ip = std::move(inflight.front());
+      inflight.pop_front();
+      if (!finish(ip)) break;
+    }
+
+    std::vector<char>& slot = buf_pool[launched % max_inflight];
+    launched++;
+    slot.resize(length);
+
+    GetObjectArgs get_args =
+        range_args(static_cast<size_t>(offset), length, slot.data());
+
+    UploadPartArgs up_args;
+    up_args.bucket = args.bucket;
+    up_args.region = args.region;
+    up_args.object = args.object;
+    up_args.upload_id = upload_id;
+    up_args.part_number = part_number;
+    up_args.data = std::string_view(slot.data(), length);
+    up_args.buf = nullptr;
+    up_args.part_size = length;
+    up_args.headers = part_headers;
+
+    InflightPart ip;
+    ip.part_number = part_number;
+    ip.part_bytes = length;
+    try {
+      ip.future = executor_->Submit(
+          [this, &source_client, get_args = std::move(get_args),
+           up_args = std::move(up_args)]() mutable
+          -> Result<UploadPartResponse> {
+            const size_t length = *get_args.length;
+            auto get_resp = source_client.GetObject(std::move(get_args));
+            if (!get_resp) return tl::make_unexpected(get_resp.error());
+            if (get_resp->size != length) {
+              return error::make<UploadPartResponse>(
+                  "short read of part " + std::to_string(up_args.part_number) +
+                  " from source");
+            }
+            return UploadPart(std::move(up_args));
+          });
+    } catch (const std::system_error& e) {
+      first_err =
+          error::Error(std::string("unable to create thread: ") + e.what());
+      break;
+    }
+    inflight.push_back(std::move(ip));
+  }
+
+  // Pipelines in flight use the ring; wait for all of them.
+  while (!inflight.empty()) {
+    InflightPart ip = std::move(inflight.front());
+    inflight.pop_front();
+    if (first_err) {
+      executor_->Wait(ip.future);
+    } else {
+      finish(ip);
+    }
+  }
+  if (first_err) return tl::make_unexpected(first_err);
+
+  CompleteMultipartUploadArgs cmpu_args;
+  cmpu_args.bucket = args.bucket;
+  cmpu_args.region = args.region;
+  cmpu_args.object = args.object;
+  cmpu_args.upload_id = upload_id;
+  for (auto& [number, part] : done) {
+    if (number > *part_count) continue;
+    cmpu_args.parts.push_back(Part(number, std::move(part.etag)));
+  }
+  auto cmu_resp = CompleteMultipartUpload(cmpu_args);
+  if (!cmu_resp) return tl::make_unexpected(cmu_resp.error());
+  upload_id.clear();
+  return TransferObjectResponse(PutObjectResponse(std::move(*cmu_resp)));
+}
+
 RemoveObjectsResult Client::RemoveObjects(RemoveObjectsArgs args) {
   if (error::Error err = args.Validate()) {
     return RemoveObjectsResult(err);
@@ -1713,57 +3238,58 @@ RemoveObjectsResult Client::RemoveObjects(RemoveObjectsArgs args) {
 
 std::future<Result<ComposeObjectResponse>> Client::ComposeObjectAsync(
     ComposeObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ComposeObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ComposeObject(std::move(args));
+  });
 }
 
 std::future<Result<CopyObjectResponse>> Client::CopyObjectAsync(
     CopyObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return CopyObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return CopyObject(std::move(args));
+  });
 }
 
 std::future<Result<DownloadObjectResponse>> Client::DownloadObjectAsync(
     DownloadObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return DownloadObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return DownloadObject(std::move(args));
+  });
 }
 
 std::future<Result<GetObjectResponse>> Client::GetObjectAsync(
     GetObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return Client::GetObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return Client::GetObject(std::move(args));
+  });
 }
 
 std::future<ListObjectsResult> Client::ListObjectsAsync(ListObjectsArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return ListObjects(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return ListObjects(std::move(args));
+  });
 }
 
 std::future<Result<PutObjectResponse>> Client::PutObjectAsync(
     PutObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return PutObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return PutObject(std::move(args));
+  });
 }
 
 std::future<Result<UploadObjectResponse>> Client::UploadObjectAsync(
     UploadObjectArgs args) {
-  return std::async(std::launch::async,
-                    [this, args = std::move(args)]() mutable {
-                      return UploadObject(std::move(args));
-                    });
+  return executor_->Submit([this, args = std::move(args)]() mutable {
+    return UploadObject(std::move(args));
+  });
+}
+
+std::future<Result<TransferObjectResponse>> Client::TransferObjectAsync(
+    BaseClient& source_client, TransferObjectArgs args) {
+  return executor_->Submit(
+      [this, &source_client, args = std::move(args)]() mutable {
+        return TransferObject(source_client, std::move(args));
+      });
 }
 
 }  // namespace minio::s3
@@ -17,13 +17,14 @@
 
 #include "miniocpp/credentials.h"
 
-#include <pugixml.hpp>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "miniocpp/error.h"
 #include "miniocpp/result.h"
 #include "miniocpp/utils.h"
+#include "miniocpp/xml.h"
 
 namespace minio::creds {
 
@@ -36,24 +37,39 @@ bool expired(const utils::UtcTime& expiration) {
 
 Result<Credentials> Credentials::ParseXML(std::string_view data,
                                           const std::string& root) {
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_string(data.data());
-  if (!result) {
-    return tl::make_unexpected(error::Error("unable to parse XML"));
-  }
-  auto credentials = xdoc.select_node((root + "/Credentials").c_str());
-
-  auto text = credentials.node().select_node("AccessKeyId/text()");
-  std::string access_key = text.node().value();
+  // root is the path of the element holding Credentials.
+  const std::string prefix = root + "/Credentials/";
+  std::string access_key;
+  std::string secret_key;
+  std::string session_token;
+  utils::UtcTime expiration;
 
-  text = credentials.node().select_node("SecretAccessKey/text()");
-  std::string secret_key = text.node().value();
+  xml::Reader reader;
+  reader.Feed(data);
+  reader.Close();
+  while (true) {
+    xml::Reader::Event event = reader.Next();
+    if (event == xml::Reader::Event::kEof) break;
+    if (event == xml::Reader::Event::kError) {
+      return tl::make_unexpected(
+          error::Error(std::string("unable to parse XML; ") + reader.Error()));
+    }
+    if (event != xml::Reader::Event::kText) continue;
 
-  text = credentials.node().select_node("SessionToken/text()");
-  std::string session_token = text.node().value();
-
-  text = credentials.node().select_node("Expiration/text()");
-  auto expiration = utils::UtcTime::FromISO8601UTC(text.node().value());
+    std::string_view path = reader.Path();
+    if (path.substr(0, prefix.size()) != prefix) continue;
+    std::string_view name = path.substr(prefix.size());
+    if (name == "AccessKeyId") {
+      access_key = reader.Text();
+    } else if (name == "SecretAccessKey") {
+      secret_key = reader.Text();
+    } else if (name == "SessionToken") {
+      session_token = reader.Text();
+    } else if (name == "Expiration") {
+      expiration =
+          utils::UtcTime::FromISO8601UTC(std::string(reader.Text()).c_str());
+    }
+  }
 
   return Credentials(error::SUCCESS, std::move(access_key),
                      std::move(secret_key), std::move(session_token),
@@ -0,0 +1,232 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "miniocpp/executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace minio::utils {
+
+struct Executor::Impl : std::enable_shared_from_this<Executor::Impl> {
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  unsigned int max_threads;
+  std::vector<std::unique_ptr<Queue>> local;  // One per worker slot.
+  Queue global;                               // Submissions from non-workers.
+
+  std::mutex mutex;  // Guards threads, sleeping and stop.
+  std::condition_variable cv;
+  std::vector<std::thread> threads;
+  unsigned int sleeping = 0;
+  bool stop = false;
+
+  std::atomic<unsigned int> started{0};
+  std::atomic<unsigned int> active{0};
+  std::atomic<size_t> queued{0};
+  std::atomic<size_t> max_queued{0};
+  std::atomic<uint64_t> submitted{0};
+  std::atomic<uint64_t> completed{0};
+  std::atomic<uint64_t> stolen{0};
+
+  explicit Impl(unsigned int max_threads) : max_threads(max_threads) {
+    local.reserve(max_threads);
+    for (unsigned int i = 0; i < max_threads; ++i) {
+      local.push_back(std::make_unique<Queue>());
+    }
+  }
+
+  static bool PopBack(Queue& q, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+  }
+
+  static bool PopFront(Queue& q, std::function<void()>& task) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.front());
+    q.tasks.pop_front();
+    return true;
+  }
+
+  // Pop takes the newest task of worker self, else the oldest submitted from
+  // outside, else steals the oldest task of another worker.
+  bool Pop(unsigned int self, std::function<void()>& task) {
+    if (queued.load() == 0) return false;
+    bool found = PopBack(*local[self], task) || PopFront(global, task);
+    if (!found) {
+      unsigned int n = started.load();
+      for (unsigned int i = 1; i < n && !found; ++i) {
+        found = PopFront(*local[(self + i) % n], task);
+      }
+      if (found) stolen++;
+    }
+    if (found) queued--;
+    return found;
+  }
+
+  void Run(std::function<void()>& task) {
+    active++;
+    task();
+    active--;
+    completed++;
+  }
+
+  void Spawn();
+  void Work(unsigned int self);
+};
+
+namespace {
+
+// The executor state and queue slot of the worker running on this thread.
+struct WorkerSlot {
+  const void* impl = nullptr;
+  unsigned int index = 0;
+};
+
+thread_local WorkerSlot current_worker;
+
+}  // namespace
+
+void Executor::Impl::Spawn() {
+  unsigned int index = static_cast<unsigned int>(threads.size());
+  // Workers keep the state alive in case the executor is destroyed by one of
+  // its own tasks.
+  threads.emplace_back(
+      [self = shared_from_this(), index]() { self->Work(index); });
+  started++;
+}
+
+void Executor::Impl::Work(unsigned int self) {
+  current_worker.impl = this;
+  current_worker.index = self;
+
+  std::function<void()> task;
+  while (true) {
+    if (Pop(self, task)) {
+      Run(task);
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stop && queued.load() == 0) return;
+    sleeping++;
+    cv.wait(lock, [this]() { return stop || queued.load() > 0; });
+    sleeping--;
+  }
+}
+
+unsigned int Executor::DefaultMaxThreads() {
+  unsigned int hw = std::thread::hardware_concurrency();
+  return std::max(8u, 2 * hw);
+}
+
+Executor::Executor(unsigned int max_threads)
+    : impl_(std::make_shared<Impl>(std::max(1u, max_threads))) {}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(impl_->mutex);
+    impl_->stop = true;
+  }
+  impl_->cv.notify_all();
+  for (auto& thread : impl_->threads) {
+    // The last owner may be released by a task running on a worker.
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
+void Executor::Post(std::function<void()> task) {
+  Impl& impl = *impl_;
+  std::unique_lock<std::mutex> lock(impl.mutex);
+  if (impl.threads.empty()) impl.Spawn();  // Nothing can run the task else.
+  lock.unlock();
+
+  // Count the task before it becomes visible so Pop never underflows queued.
+  size_t queued = ++impl.queued;
+  if (current_worker.impl == impl_.get()) {
+    std::lock_guard<std::mutex> qlock(impl.local[current_worker.index]->mutex);
+    impl.local[current_worker.index]->tasks.push_back(std::move(task));
+  } else {
+    std::lock_guard<std::mutex> qlock(impl.global.mutex);
+    impl.global.tasks.push_back(std::move(task));
+  }
+  impl.submitted++;
+  size_t max_queued = impl.max_queued.load();
+  while (queued > max_queued &&
+         !impl.max_queued.compare_exchange_weak(max_queued, queued)) {
+  }
+
+  lock.lock();
+  if (impl.sleeping == 0 && impl.threads.size() < impl.max_threads) {
+    try {
+      impl.Spawn();
+    } catch (const std::system_error&) {
+      // Running workers pick the task up.
+    }
+  }
+  lock.unlock();
+  impl.cv.notify_one();
+}
+
+bool Executor::IsWorker() const {
+  return current_worker.impl == impl_.get();
+}
+
+bool Executor::RunPending() {
+  std::function<void()> task;
+  if (!impl_->Pop(current_worker.index, task)) return false;
+  impl_->Run(task);
+  return true;
+}
+
+ExecutorStats Executor::Stats() const {
+  ExecutorStats stats;
+  stats.max_threads = impl_->max_threads;
+  stats.threads = impl_->started.load();
+  stats.active = impl_->active.load();
+  stats.queued = impl_->queued.load();
+  stats.max_queued = impl_->max_queued.load();
+  stats.submitted = impl_->submitted.load();
+  stats.completed = impl_->completed.load();
+  stats.stolen = impl_->stolen.load();
+  return stats;
+}
+
+}  // namespace minio::utils
@@ -22,8 +22,14 @@
 // header-only library's class layout depends on that macro, so every
 // translation unit must agree on it.
 #include <httplib.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <exception>
 #include <functional>
 #include <iosfwd>
@@ -31,6 +37,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -47,6 +54,7 @@
 #include <ws2tcpip.h>
 #else
 #include <arpa/inet.h>
+#include <poll.h>
 #endif
 
 namespace minio::http {
@@ -59,8 +67,308 @@ namespace {
 // enforces it as a read/write timeout, since it has no low-speed limit.
 constexpr long kStallTimeoutSecs = 60;
 
+// Largest piece of a streamed request body pulled from its body function at
+// once.
+constexpr size_t kBodyChunkSize = 64 * 1024;
+
+// IsConnectionHealthy reports whether an idle keep-alive connection can be
+// reused. An idle connection must have nothing to read; readability means the
+// server closed it (EOF) or sent unsolicited data, either way it is stale.
+// A client without an open socket is healthy: it simply connects on next use.
+bool IsConnectionHealthy(const httplib::Client& cli) {
+  if (!cli.is_socket_open()) return true;
+#ifdef _WIN32
+  WSAPOLLFD pfd{};
+  pfd.fd = cli.socket();
+  pfd.events = POLLRDNORM;
+  return WSAPoll(&pfd, 1, 0) == 0;
+#else
+  pollfd pfd{};
+  pfd.fd = cli.socket();
+  pfd.events = POLLIN;
+  return poll(&pfd, 1, 0) == 0;
+#endif
+}
+
+// TlsSession holds the most recent resumable session of one endpoint. It is
+// owned jointly by TlsContextCache and, through SSL_CTX ex data, by every
+// httplib client whose context it was attached to.
+struct TlsSession {
+  std::mutex mutex;
+  SSL_SESSION* session = nullptr;
+  std::shared_ptr<std::atomic<uint64_t>> full_handshakes;
+  std::shared_ptr<std::atomic<uint64_t>> resumed_handshakes;
+
+  ~TlsSession() {
+    if (session != nullptr) SSL_SESSION_free(session);
+  }
+};
+
+void FreeTlsSession(void* /* parent */, void* ptr, CRYPTO_EX_DATA* /* ad */,
+                    int /* idx */, long /* argl */, void* /* argp */) {
+  delete static_cast<std::shared_ptr<TlsSession>*>(ptr);
+}
+
+int TlsSessionIndex() {
+  static const int index =
+      SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, FreeTlsSession);
+  return index;
+}
+
+// Marks an SSL connection whose handshake was already counted; TLS 1.3
+// reports handshake completion again for every post-handshake ticket.
+int TlsCountedIndex() {
+  static const int index =
+      SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  return index;
+}
+
+TlsSession* GetTlsSession(const SSL* ssl) {
+  auto* ptr = static_cast<std::shared_ptr<TlsSession>*>(
+      SSL_CTX_get_ex_data(SSL_get_SSL_CTX(ssl), TlsSessionIndex()));
+  return ptr == nullptr ? nullptr : ptr->get();
+}
+
+// OnNewTlsSession keeps the latest session (including TLS 1.3 tickets) of the
+// endpoint; returning 1 takes ownership of the session.
+int OnNewTlsSession(SSL* ssl, SSL_SESSION* session) {
+  TlsSession* tls_session = GetTlsSession(ssl);
+  if (tls_session == nullptr) return 0;
+  std::lock_guard<std::mutex> lock(tls_session->mutex);
+  if (tls_session->session != nullptr) {
+    SSL_SESSION_free(tls_session->session);
+  }
+  tls_session->session = session;
+  return 1;
+}
+
+// OnTlsInfo offers the saved session before the ClientHello is written, as
+// httplib has no hook between SSL_new() and SSL_connect(), and counts how the
+// handshake completed.
+void OnTlsInfo(const SSL* ssl, int where, int /* ret */) {
+  TlsSession* tls_session = GetTlsSession(ssl);
+  if (tls_session == nullptr) return;
+
+  if ((where & SSL_CB_HANDSHAKE_START) && SSL_get_session(ssl) == nullptr) {
+    std::lock_guard<std::mutex> lock(tls_session->mutex);
+    if (tls_session->session != nullptr &&
+        SSL_SESSION_is_resumable(tls_session->session)) {
+      SSL_set_session(const_cast<SSL*>(ssl), tls_session->session);
+    }
+  }
+
+  if ((where & SSL_CB_HANDSHAKE_DONE) &&
+      SSL_get_ex_data(ssl, TlsCountedIndex()) == nullptr) {
+    static int counted = 1;
+    SSL_set_ex_data(const_cast<SSL*>(ssl), TlsCountedIndex(), &counted);
+    if (SSL_session_reused(const_cast<SSL*>(ssl))) {
+      ++*tls_session->resumed_handshakes;
+    } else {
+      ++*tls_session->full_handshakes;
+    }
+  }
+}
+
 }  // namespace
 
+struct TlsContextCache::Impl {
+  std::mutex mutex;
+  std::map<std::string, X509_STORE*> ca_stores;
+  std::map<std::string, std::shared_ptr<TlsSession>> sessions;
+  std::shared_ptr<std::atomic<uint64_t>> full_handshakes =
+      std::make_shared<std::atomic<uint64_t>>(0);
+  std::shared_ptr<std::atomic<uint64_t>> resumed_handshakes =
+      std::make_shared<std::atomic<uint64_t>>(0);
+
+  ~Impl() { ClearLocked(); }
+
+  void ClearLocked() {
+    for (auto& [file, store] : ca_stores) X509_STORE_free(store);
+    ca_stores.clear();
+    sessions.clear();
+  }
+
+  // GetCaStore returns a new reference to the store of ssl_cert_file, parsing
+  // the file on first use only. Caller must hold mutex.
+  X509_STORE* GetCaStore(const std::string& ssl_cert_file) {
+    auto itr = ca_stores.find(ssl_cert_file);
+    if (itr == ca_stores.end()) {
+      X509_STORE* store = X509_STORE_new();
+      if (store == nullptr) return nullptr;
+      if (X509_STORE_load_file(store, ssl_cert_file.c_str()) != 1) {
+        X509_STORE_free(store);
+        return nullptr;
+      }
+      itr = ca_stores.emplace(ssl_cert_file, store).first;
+    }
+    X509_STORE_up_ref(itr->second);
+    return itr->second;
+  }
+
+  // Configure attaches the shared CA store and the endpoint's session slot to
+  // a newly created https client. Returns false if the CA store could not be
+  // loaded, so the caller falls back to httplib's own loading.
+  bool Configure(httplib::Client& cli, const std::string& key,
+                 const std::string& ssl_cert_file) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool ca_store_set = false;
+    if (!ssl_cert_file.empty()) {
+      // httplib takes ownership of the reference.
+      if (X509_STORE* store = GetCaStore(ssl_cert_file)) {
+        cli.set_ca_cert_store(store);
+        ca_store_set = true;
+      }
+    }
+
+    SSL_CTX* ctx = cli.ssl_context();
+    if (ctx == nullptr) return ca_store_set;
+
+    std::shared_ptr<TlsSession>& tls_session = sessions[key];
+    if (!tls_session) {
+      tls_session = std::make_shared<TlsSession>();
+      tls_session->full_handshakes = full_handshakes;
+      tls_session->resumed_handshakes = resumed_handshakes;
+    }
+    SSL_CTX_set_ex_data(ctx, TlsSessionIndex(),
+                        new std::shared_ptr<TlsSession>(tls_session));
+    SSL_CTX_set_session_cache_mode(
+        ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ctx, OnNewTlsSession);
+    SSL_CTX_set_info_callback(ctx, OnTlsInfo);
+
+    return ca_store_set;
+  }
+};
+
+TlsContextCache::TlsContextCache() : impl_(std::make_unique<Impl>()) {}
+
+TlsContextCache::~TlsContextCache() = default;
+
+uint64_t TlsContextCache::FullHandshakes() const {
+  return impl_->full_handshakes->load();
+}
+
+uint64_t TlsContextCache::ResumedHandshakes() const {
+  return impl_->resumed_handshakes->load();
+}
+
+void TlsContextCache::Clear() {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->ClearLocked();
+}
+
+struct ConnectionPool::Impl {
+  using Clock = std::chrono::steady_clock;
+
+  struct IdleConnection {
+    std::unique_ptr<httplib::Client> client;
+    Clock::time_point idle_since;
+  };
+
+  mutable std::mutex mutex;
+  size_t max_idle_per_host;
+  std::chrono::seconds idle_timeout;
+  std::map<std::string, std::list<IdleConnection>> idle;
+  Clock::time_point last_sweep = Clock::now();
+
+  Impl(size_t max_idle_per_host, std::chrono::seconds idle_timeout)
+      : max_idle_per_host(max_idle_per_host), idle_timeout(idle_timeout) {}
+
+  // Sweep moves expired connections of all endpoints into evicted, so they
+  // are closed outside the lock. Caller must hold mutex.
+  void Sweep(Clock::time_point now, std::list<IdleConnection>& evicted) {
+    last_sweep = now;
+    for (auto itr = idle.begin(); itr != idle.end();) {
+      auto& conns = itr->second;
+      // Connections are ordered oldest first.
+      while (!conns.empty() && now - conns.front().idle_since >= idle_timeout) {
+        evicted.splice(evicted.end(), conns, conns.begin());
+      }
+      if (conns.empty()) {
+        itr = idle.erase(itr);
+      } else {
+        ++itr;
+      }
+    }
+  }
+
+  std::unique_ptr<httplib::Client> Acquire(const std::string& key) {
+    std::list<IdleConnection> evicted;
+    std::unique_ptr<httplib::Client> client;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      Sweep(Clock::now(), evicted);
+      auto itr = idle.find(key);
+      // Prefer the most recently used connection; it is the least likely to
+      // have been closed by the server.
+      while (itr != idle.end() && !itr->second.empty()) {
+        auto conn = std::move(itr->second.back());
+        itr->second.pop_back();
+        if (IsConnectionHealthy(*conn.client)) {
+          client = std::move(conn.client);
+          break;
+        }
+        evicted.push_back(std::move(conn));
+      }
+      if (itr != idle.end() && itr->second.empty()) idle.erase(itr);
+    }
+    return client;
+  }
+
+  void Release(const std::string& key,
+               std::unique_ptr<httplib::Client> client) {
+    // Connections the server closed are not worth keeping.
+    if (!client->is_socket_open()) return;
+
+    std::list<IdleConnection> evicted;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = Clock::now();
+    if (now - last_sweep >= idle_timeout) Sweep(now, evicted);
+    if (max_idle_per_host == 0) return;
+    auto& conns = idle[key];
+    conns.push_back(IdleConnection{std::move(client), now});
+    if (conns.size() > max_idle_per_host) {
+      evicted.splice(evicted.end(), conns, conns.begin());
+    }
+  }
+};
+
+ConnectionPool::ConnectionPool(size_t max_idle_per_host,
+                               std::chrono::seconds idle_timeout)
+    : impl_(std::make_unique<Impl>(max_idle_per_host, idle_timeout)) {}
+
+ConnectionPool::~ConnectionPool() = default;
+
+void ConnectionPool::SetMaxIdlePerHost(size_t max_idle_per_host) {
+  std::list<Impl::IdleConnection> evicted;
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->max_idle_per_host = max_idle_per_host;
+  for (auto& [key, conns] : impl_->idle) {
+    while (conns.size() > max_idle_per_host) {
+      evicted.splice(evicted.end(), conns, conns.begin());
+    }
+  }
+}
+
+void ConnectionPool::SetIdleTimeout(std::chrono::seconds idle_timeout) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->idle_timeout = idle_timeout;
+}
+
+size_t ConnectionPool::IdleCount() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  size_t count = 0;
+  for (const auto& [key, conns] : impl_->idle) count += conns.size();
+  return count;
+}
+
+void ConnectionPool::Clear() {
+  std::map<std::string, std::list<Impl::IdleConnection>> evicted;
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  evicted.swap(impl_->idle);
+}
+
 // MethodToString converts http Method enum to string.
 const char* MethodToString(Method method) noexcept {
   switch (method) {
@@ -186,6 +494,14 @@ error::Error Response::Error() const {
   return error::SUCCESS;
 }
 
+BodyFunction StreamBody(std::istream& stream) {
+  return [&stream](BodyFunctionArgs& args) -> bool {
+    stream.read(args.buffer, static_cast<std::streamsize>(args.size));
+    args.written = static_cast<size_t>(stream.gcount());
+    return args.written > 0;
+  };
+}
+
 Request::Request(Method method, Url url) {
   this->method = method;
   this->url = url;
@@ -200,32 +516,63 @@ Response Request::execute() {
   response.datafunc = datafunc;
   response.userdata = userdata;
 
-  // httplib::Client is bound to one endpoint and not thread-safe; build a
-  // fresh one per request.
+  // httplib::Client is bound to one endpoint and not thread-safe; take an
+  // idle one for this endpoint from the pool, or build a fresh one.
   std::string endpoint = (url.https ? "https://" : "http://") + url.host;
   if (url.port) endpoint += ":" + std::to_string(url.port);
 
-  auto client =
-      std::make_unique<httplib::Client>(endpoint, cert_file, key_file);
-  if (!client->is_valid()) {
-    response.error = "unable to create HTTP client for " + endpoint;
-    return response;
+  // Everything fixed at construction or connect time is part of the key.
+  std::string pool_key = endpoint + "\n" + nic_interface + "\n" +
+                         ssl_cert_file + "\n" + cert_file + "\n" + key_file +
+                         "\n" + (ignore_cert_check ? "1" : "0");
+
+  std::unique_ptr<httplib::Client> client;
+  if (pool) client = pool->impl_->Acquire(pool_key);
+  if (!client) {
+    client = std::make_unique<httplib::Client>(endpoint, cert_file, key_file);
+    if (!client->is_valid()) {
+      response.error = "unable to create HTTP client for " + endpoint;
+      return response;
+    }
+    client->set_keep_alive(true);
+    client->set_follow_location(false);
+    // Paths are pre-encoded by the caller (EncodePath).
+    client->set_path_encode(false);
+    if (!nic_interface.empty()) client->set_interface(nic_interface);
+    if (url.https) {
+      bool ca_store_set = false;
+      if (tls_cache) {
+        ca_store_set =
+            tls_cache->impl_->Configure(*client, pool_key, ssl_cert_file);
+      }
+      // An explicit CA bundle overrides IGNORE_CERT_CHECK, matching the curl
+      // backend: verification is enabled against the given CA file.
+      if (!ssl_cert_file.empty()) {
+        if (!ca_store_set) client->set_ca_cert_path(ssl_cert_file);
+        client->enable_server_certificate_verification(true);
+      } else {
+        client->enable_server_certificate_verification(!ignore_cert_check);
+      }
+    }
   }
   httplib::Client& cli = *client;
 
+  // Per-request settings are applied on every use, since a pooled client
+  // keeps whatever its previous request set.
   // httplib's default 5s read/write timeout is too short for S3 transfers;
   // use the 60s stall guard unless the caller set an explicit total timeout.
-  cli.set_keep_alive(true);
-  cli.set_follow_location(false);
-  // Paths are pre-encoded by the caller (EncodePath).
-  cli.set_path_encode(false);
   if (connect_timeout_secs > 0) {
     cli.set_connection_timeout(connect_timeout_secs, 0);
+  } else {
+    cli.set_connection_timeout(CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND, 0);
   }
   if (timeout_secs > 0) {
     // Total transfer deadline, like the old CURLOPT_TIMEOUT.
     cli.set_max_timeout(static_cast<time_t>(timeout_secs) * 1000);
+    cli.set_read_timeout(CPPHTTPLIB_READ_TIMEOUT_SECOND, 0);
+    cli.set_write_timeout(CPPHTTPLIB_WRITE_TIMEOUT_SECOND, 0);
   } else {
+    cli.set_max_timeout(0);
     cli.set_read_timeout(kStallTimeoutSecs, 0);
     cli.set_write_timeout(kStallTimeoutSecs, 0);
   }
@@ -235,24 +582,13 @@ Response Request::execute() {
           std::cerr << req.method << " " << req.path << " -> " << res.status
                     << std::endl;
         });
-  }
-  if (!nic_interface.empty()) cli.set_interface(nic_interface);
-  if (url.https) {
-    // An explicit CA bundle overrides IGNORE_CERT_CHECK, matching the curl
-    // backend: verification is enabled against the given CA file.
-    if (!ssl_cert_file.empty()) {
-      cli.set_ca_cert_path(ssl_cert_file);
-      cli.enable_server_certificate_verification(true);
-    } else {
-      cli.enable_server_certificate_verification(!ignore_cert_check);
-    }
+  } else {
+    cli.set_logger(nullptr);
   }
 
   httplib::Headers request_headers;
-  for (const auto& key : headers.Keys()) {
-    for (const auto& value : headers.Get(key)) {
-      request_headers.insert({key, value});
-    }
+  for (const auto& entry : headers) {
+    request_headers.emplace(entry.lower_key, entry.value);
   }
   // httplib sets Host itself when absent and derives Content-Length from the
   // body; the SigV4-signed Host must be sent verbatim.  An empty Expect
@@ -317,21 +653,56 @@ Response Request::execute() {
   // (the GET response handler gates this on the status; the POST overloads
   // have no response handler, so Select always streams and surfaces errors
   // through the event stream).
+  // With a receive buffer the body is copied straight from httplib's read
+  // buffer into the caller's memory, bounded by its size.
   bool datafunc_canceled = false;
+  bool buffer_overflow = false;
   bool stream_to_datafunc = true;
+  if (buffer != nullptr) buffer->received = 0;
   httplib::ContentReceiver content_receiver =
-      [this, &response, &datafunc_canceled, &stream_to_datafunc](
-          const char* data, size_t length) -> bool {
+      [this, &response, &datafunc_canceled, &buffer_overflow,
+       &stream_to_datafunc](const char* data, size_t length) -> bool {
     if (!stream_to_datafunc) {
       response.body.append(data, length);
       return true;
     }
-    DataFunctionArgs args(&response, std::string(data, length), userdata);
-    const bool cont = datafunc(args);
+    if (buffer != nullptr) {
+      if (length > buffer->size - buffer->received) {
+        buffer_overflow = true;
+        return false;
+      }
+      std::memcpy(buffer->data + buffer->received, data, length);
+      buffer->received += length;
+      return true;
+    }
+    DataFunctionArgs args(&response, userdata);
+    args.data = std::string_view(data, length);
+    if (!zero_copy) args.datachunk.assign(data, length);
+    const bool cont = datafunc(std::move(args));
     if (!cont) datafunc_canceled = true;
     return cont;
   };
 
+  // A streamed body is pulled from bodyfunc as httplib writes it, a chunk at
+  // a time, so only one chunk of it is ever in memory.
+  std::string body_chunk;
+  bool body_failed = false;
+  httplib::ContentProvider content_provider =
+      [this, &body_chunk, &body_failed](size_t offset, size_t length,
+                                        httplib::DataSink& sink) -> bool {
+    body_chunk.resize(std::min(length, kBodyChunkSize));
+    BodyFunctionArgs args;
+    args.buffer = body_chunk.data();
+    args.size = body_chunk.size();
+    args.offset = offset;
+    args.userdata = body_userdata;
+    if (!bodyfunc(args) || args.written == 0 || args.written > args.size) {
+      body_failed = true;
+      return false;
+    }
+    return sink.write(body_chunk.data(), args.written);
+  };
+
   httplib::Result res;
   httplib::ResponseHandler response_handler =
       [&response, &stream_to_datafunc](const httplib::Response& res) -> bool {
@@ -343,7 +714,7 @@ Response Request::execute() {
   };
   switch (method) {
     case Method::kGet:
-      if (datafunc != nullptr) {
+      if (datafunc != nullptr || buffer != nullptr) {
         res = cli.Get(path, request_headers, response_handler, content_receiver,
                       download_progress);
       } else {
@@ -360,14 +731,22 @@ Response Request::execute() {
         res = cli.Post(path, request_headers,
                        std::string(body.data(), body.size()), content_type,
                        content_receiver, download_progress);
+      } else if (bodyfunc != nullptr) {
+        res = cli.Post(path, request_headers, body_size, content_provider,
+                       content_type, upload_progress);
       } else {
         res = cli.Post(path, request_headers, body.data(), body.size(),
                        content_type, upload_progress);
       }
       break;
     case Method::kPut:
-      res = cli.Put(path, request_headers, body.data(), body.size(),
-                    content_type, upload_progress);
+      if (bodyfunc != nullptr) {
+        res = cli.Put(path, request_headers, body_size, content_provider,
+                      content_type, upload_progress);
+      } else {
+        res = cli.Put(path, request_headers, body.data(), body.size(),
+                      content_type, upload_progress);
+      }
       break;
     case Method::kDelete:
       res = cli.Delete(path, request_headers, download_progress);
@@ -380,23 +759,40 @@ Response Request::execute() {
     // captures the status via the response handler; httplib discards the
     // response when a POST receiver cancels, so report success there since
     // the caller ended the transfer itself.
+    // Either way the connection is in an unknown state; drop it.
     if (res.error() == httplib::Error::Canceled && datafunc_canceled) {
       if (response.status_code == 0) response.status_code = 200;
       report_speed();
       return response;
     }
+    if (body_failed) {
+      response.error = "unable to read request body; expected " +
+                       std::to_string(body_size) + " bytes";
+      report_speed();
+      return response;
+    }
+    if (res.error() == httplib::Error::Canceled && buffer_overflow) {
+      response.error = "response body exceeds receive buffer of " +
+                       std::to_string(buffer->size) + " bytes";
+      report_speed();
+      return response;
+    }
     response.error = httplib::to_string(res.error());
     report_speed();
     return response;
   }
 
+  // A complete exchange leaves the keep-alive connection reusable.
+  if (pool) pool->impl_->Release(pool_key, std::move(client));
+
   response.status_code = res->status;
   for (const auto& [key, value] : res->headers) {
     response.headers.Add(key, value);
   }
-  // With a data function the body is streamed to it; otherwise keep the
-  // buffered response body (including error payloads for non-2xx statuses).
-  if (datafunc == nullptr) response.body = res->body;
+  // With a data function or receive buffer the body is streamed to it;
+  // otherwise keep the buffered response body (including error payloads for
+  // non-2xx statuses).
+  if (datafunc == nullptr && buffer == nullptr) response.body = res->body;
 
   report_speed();
   return response;
@@ -404,6 +800,7 @@ Response Request::execute() {
 
 Response Request::Execute() {
   try {
+    if (transport) return transport->Execute(*this);
     return execute();
   } catch (const std::exception& e) {
     Response response;
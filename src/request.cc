@@ -17,14 +17,19 @@
 
 #include "miniocpp/request.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <iosfwd>
 #include <iostream>
+#include <memory>
 #include <ostream>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "miniocpp/credentials.h"
@@ -32,6 +37,7 @@
 #include "miniocpp/http.h"
 #include "miniocpp/providers.h"
 #include "miniocpp/signer.h"
+#include "miniocpp/types.h"
 #include "miniocpp/utils.h"
 
 namespace minio::s3 {
@@ -64,6 +70,13 @@ static const std::regex REGION_REGEX("^((?!_)(?!-)[a-z_\\d-]{1,63})$",
 
 static constexpr char EMPTY_SHA256[] =
     "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+static constexpr char UNSIGNED_PAYLOAD[] = "UNSIGNED-PAYLOAD";
+static constexpr char STREAMING_PAYLOAD[] =
+    "STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
+static constexpr char STREAMING_PAYLOAD_TRAILER[] =
+    "STREAMING-AWS4-HMAC-SHA256-PAYLOAD-TRAILER";
+static constexpr char STREAMING_UNSIGNED_TRAILER[] =
+    "STREAMING-UNSIGNED-PAYLOAD-TRAILER";
 
 static bool awsRegexMatch(std::string_view value, const std::regex& regex) {
   if (!std::regex_search(value.data(), regex)) return false;
@@ -296,6 +309,164 @@ error::Error BaseUrl::BuildUrl(http::Url& url, http::Method method,
   return error::SUCCESS;
 }
 
+namespace {
+
+// Size of the chunks of an aws-chunked body; S3 wants at least 8 KiB for all
+// but the last one.
+constexpr size_t kAwsChunkSize = 64 * 1024;
+constexpr size_t kSignatureLength = 64;
+constexpr char kChunkSignature[] = ";chunk-signature=";
+constexpr char kTrailerSignature[] = "x-amz-trailer-signature:";
+
+std::string HexSize(size_t n) {
+  static constexpr char digits[] = "0123456789abcdef";
+  std::string hex;
+  do {
+    hex.insert(hex.begin(), digits[n & 0xf]);
+    n >>= 4;
+  } while (n != 0);
+  return hex;
+}
+
+size_t ChecksumBase64Length(ChecksumAlgorithm algo) {
+  return (algo == ChecksumAlgorithm::kCrc32c) ? 8 : 12;
+}
+
+/**
+ * AwsChunkedBody encodes a body of size bytes pulled from source as
+ * aws-chunked: chunks of kAwsChunkSize bytes, each signed by signer when one
+ * is given, then an empty chunk and the checksum trailer when algo is set.
+ * Signed chunks are read kHashBatch at a time and hashed in parallel on
+ * executor when one is given; only the signatures themselves are chained.
+ */
+class AwsChunkedBody {
+ private:
+  static constexpr size_t kHashBatch = 16;
+
+  http::BodyFunction source_;
+  void* userdata_;
+  size_t size_;
+  std::unique_ptr<signer::ChunkSigner> signer_;
+  Checksum checksum_;
+  std::shared_ptr<utils::Executor> executor_;
+
+  size_t offset_ = 0;  // Body bytes pulled from source.
+  bool done_ = false;
+  std::vector<std::string> batch_;  // Chunks read but not yet encoded.
+  std::vector<std::string> hashes_;
+  size_t next_ = 0;    // Index of the next chunk of batch_ to encode.
+  std::string frame_;  // Encoded bytes not yet handed out.
+  size_t frame_offset_ = 0;
+
+  bool ReadBatch() {
+    size_t count = signer_ ? kHashBatch : 1;
+    size_t chunks = (size_ - offset_ + kAwsChunkSize - 1) / kAwsChunkSize;
+    batch_.resize(std::min(count, chunks));
+    next_ = 0;
+    for (std::string& data : batch_) {
+      size_t n = std::min(kAwsChunkSize, size_ - offset_);
+      data.resize(n);
+      for (size_t got = 0; got < n;) {
+        http::BodyFunctionArgs args;
+        args.buffer = data.data() + got;
+        args.size = n - got;
+        args.offset = offset_ + got;
+        args.userdata = userdata_;
+        if (!source_(args) || args.written == 0 || args.written > n - got) {
+          return false;
+        }
+        got += args.written;
+      }
+      offset_ += n;
+      checksum_.Update(data.data(), n);
+    }
+
+    if (signer_) {
+      std::vector<std::string_view> views(batch_.begin(), batch_.end());
+      hashes_ = utils::Sha256HashAll(views, executor_.get());
+    }
+    return true;
+  }
+
+  bool NextFrame() {
+    frame_.clear();
+    frame_offset_ = 0;
+    if (next_ == batch_.size() && offset_ == size_) {
+      done_ = true;
+      frame_ = "0";
+      if (signer_) frame_ += kChunkSignature + signer_->Sign("");
+      frame_ += "\r\n";
+      if (checksum_.Algorithm() != ChecksumAlgorithm::kNone) {
+        std::string trailer = ChecksumHeaderName(checksum_.Algorithm()) + ":" +
+                              checksum_.Base64();
+        frame_ += trailer + "\r\n";
+        if (signer_) {
+          frame_ += kTrailerSignature + signer_->SignTrailer(trailer + "\n");
+          frame_ += "\r\n";
+        }
+      }
+      frame_ += "\r\n";
+      return true;
+    }
+
+    if (next_ == batch_.size() && !ReadBatch()) return false;
+    const std::string& data = batch_[next_];
+    frame_ = HexSize(data.size());
+    if (signer_) frame_ += kChunkSignature + signer_->SignHash(hashes_[next_]);
+    frame_ += "\r\n";
+    frame_ += data;
+    frame_ += "\r\n";
+    next_++;
+    return true;
+  }
+
+ public:
+  AwsChunkedBody(http::BodyFunction source, void* userdata, size_t size,
+                 std::unique_ptr<signer::ChunkSigner> signer,
+                 ChecksumAlgorithm algo,
+                 std::shared_ptr<utils::Executor> executor)
+      : source_(std::move(source)),
+        userdata_(userdata),
+        size_(size),
+        signer_(std::move(signer)),
+        checksum_(algo),
+        executor_(std::move(executor)) {}
+
+  // EncodedSize returns the length of the encoding of a size bytes body.
+  static size_t EncodedSize(size_t size, bool is_signed,
+                            ChecksumAlgorithm algo) {
+    size_t signature =
+        is_signed ? sizeof(kChunkSignature) - 1 + kSignatureLength : 0;
+    auto chunk = [signature](size_t n) {
+      return HexSize(n).size() + signature + 2 + n + 2;
+    };
+    size_t length = (size / kAwsChunkSize) * chunk(kAwsChunkSize);
+    if (size % kAwsChunkSize != 0) length += chunk(size % kAwsChunkSize);
+    length += 1 + signature + 2;  // Final empty chunk.
+    if (algo != ChecksumAlgorithm::kNone) {
+      length += ChecksumHeaderName(algo).size() + 1 +
+                ChecksumBase64Length(algo) + 2;
+      if (is_signed) {
+        length += sizeof(kTrailerSignature) - 1 + kSignatureLength + 2;
+      }
+    }
+    return length + 2;
+  }
+
+  bool Read(http::BodyFunctionArgs& args) {
+    while (frame_offset_ == frame_.size()) {
+      if (done_ || !NextFrame()) return false;
+    }
+    size_t n = std::min(args.size, frame_.size() - frame_offset_);
+    frame_.copy(args.buffer, n, frame_offset_);
+    frame_offset_ += n;
+    args.written = n;
+    return true;
+  }
+};  // class AwsChunkedBody
+
+}  // namespace
+
 Request::Request(http::Method method, std::string region, BaseUrl& baseurl,
                  utils::Multimap extra_headers,
                  utils::Multimap extra_query_params)
@@ -317,17 +488,87 @@ void Request::BuildHeaders(http::Url& url, creds::Provider* const provider) {
   // just to compute a signing hash that TLS already authenticates.
   const bool caller_set_sha256 = headers.Contains("x-amz-content-sha256");
 
+  chunked_body_ = nullptr;
+  chunked_size_ = 0;
+  PayloadSigning mode = PayloadSigning::kAuto;
+  ChecksumAlgorithm algo = checksum;
+  bool trailer = false;
+  // A checksum header set by the caller, e.g. computed while reading the
+  // part, is sent as is.
+  if (algo != ChecksumAlgorithm::kNone &&
+      headers.Contains(ChecksumHeaderName(algo))) {
+    algo = ChecksumAlgorithm::kNone;
+  }
+
   switch (method) {
     case http::Method::kPut:
     case http::Method::kPost:
-      headers.Add("Content-Length", std::to_string(body.size()));
       if (!headers.Contains("Content-Type")) {
         headers.Add("Content-Type", "application/octet-stream");
       }
+      if (!caller_set_sha256) {
+        mode = payload_signing;
+        // A streamed body is only seen as it is sent; it can be neither
+        // hashed nor MD5-summed up front, so sign it chunk by chunk unless
+        // TLS already protects it.
+        if (mode == PayloadSigning::kAuto && bodyfunc != nullptr) {
+          mode = url.https ? PayloadSigning::kUnsigned
+                           : PayloadSigning::kStreaming;
+        }
+        if (mode == PayloadSigning::kStreaming && provider == nullptr) {
+          mode = PayloadSigning::kUnsigned;
+        }
+        if (mode == PayloadSigning::kUnsignedTrailer &&
+            algo == ChecksumAlgorithm::kNone) {
+          if (checksum == ChecksumAlgorithm::kNone) {
+            algo = ChecksumAlgorithm::kCrc64Nvme;
+          } else {
+            mode = PayloadSigning::kUnsigned;
+          }
+        }
+        // The checksum of a streamed or chunked body goes in a trailer.
+        trailer = algo != ChecksumAlgorithm::kNone &&
+                  (bodyfunc != nullptr || mode == PayloadSigning::kStreaming ||
+                   mode == PayloadSigning::kUnsignedTrailer);
+        if (trailer && mode == PayloadSigning::kUnsigned) {
+          mode = PayloadSigning::kUnsignedTrailer;
+        }
+      }
+
+      if (mode == PayloadSigning::kStreaming ||
+          mode == PayloadSigning::kUnsignedTrailer) {
+        size_t size = bodyfunc ? body_size : body.size();
+        chunked_size_ = AwsChunkedBody::EncodedSize(
+            size, mode == PayloadSigning::kStreaming,
+            trailer ? algo : ChecksumAlgorithm::kNone);
+        headers.Add("Content-Length", std::to_string(chunked_size_));
+        headers.Add("Content-Encoding", "aws-chunked");
+        headers.Add("x-amz-decoded-content-length", std::to_string(size));
+        if (trailer) headers.Add("x-amz-trailer", ChecksumHeaderName(algo));
+        if (mode == PayloadSigning::kUnsignedTrailer) {
+          sha256 = STREAMING_UNSIGNED_TRAILER;
+        } else {
+          sha256 = trailer ? STREAMING_PAYLOAD_TRAILER : STREAMING_PAYLOAD;
+        }
+        break;
+      }
+
+      headers.Add("Content-Length",
+                  std::to_string(bodyfunc ? body_size : body.size()));
+      if (algo != ChecksumAlgorithm::kNone && bodyfunc == nullptr) {
+        Checksum sum(algo);
+        sum.Update(body.data(), body.size());
+        headers.Add(ChecksumHeaderName(algo), sum.Base64());
+      }
       if (provider != nullptr) {
-        sha256 = caller_set_sha256 ? headers.GetFront("x-amz-content-sha256")
-                                   : utils::Sha256Hash(body);
-      } else if (!md5sum_added) {
+        if (caller_set_sha256) {
+          sha256 = headers.GetFront("x-amz-content-sha256");
+        } else if (bodyfunc != nullptr || mode == PayloadSigning::kUnsigned) {
+          sha256 = UNSIGNED_PAYLOAD;
+        } else {
+          sha256 = utils::Sha256Hash(body);
+        }
+      } else if (bodyfunc == nullptr && !md5sum_added) {
         md5sum = utils::Md5sumHash(body);
       }
       break;
@@ -346,14 +587,41 @@ void Request::BuildHeaders(http::Url& url, creds::Provider* const provider) {
   date = utils::UtcTime::Now();
   headers.Add("x-amz-date", date.ToAmzDate());
 
+  std::unique_ptr<signer::ChunkSigner> chunk_signer;
   if (provider != nullptr) {
     creds::Credentials creds = provider->Fetch();
     if (!creds.session_token.empty()) {
       headers.Add("X-Amz-Security-Token", creds.session_token);
     }
 
+    std::string signature;
     signer::SignV4S3(method, url.path, region, headers, query_params,
-                     creds.access_key, creds.secret_key, sha256, date);
+                     creds.access_key, creds.secret_key, sha256, date,
+                     &signature);
+    if (mode == PayloadSigning::kStreaming) {
+      chunk_signer = std::make_unique<signer::ChunkSigner>(
+          creds.secret_key, date, region, std::move(signature));
+    }
+  }
+
+  if (chunked_size_ != 0) {
+    http::BodyFunction source = bodyfunc;
+    void* userdata = body_userdata;
+    size_t size = body_size;
+    if (source == nullptr) {
+      size = body.size();
+      userdata = nullptr;
+      source = [data = body](http::BodyFunctionArgs& args) -> bool {
+        args.written = data.copy(args.buffer, args.size, args.offset);
+        return args.written > 0;
+      };
+    }
+    auto encoder = std::make_shared<AwsChunkedBody>(
+        std::move(source), userdata, size, std::move(chunk_signer),
+        trailer ? algo : ChecksumAlgorithm::kNone, executor);
+    chunked_body_ = [encoder](http::BodyFunctionArgs& args) -> bool {
+      return encoder->Read(args);
+    };
   }
 }
 
@@ -368,10 +636,20 @@ http::Request Request::ToHttpRequest(creds::Provider* const provider) {
   BuildHeaders(url, provider);
 
   http::Request request(method, url);
-  request.body = body;
+  if (chunked_body_ != nullptr) {
+    request.bodyfunc = chunked_body_;
+    request.body_size = chunked_size_;
+  } else {
+    request.body = body;
+    request.bodyfunc = bodyfunc;
+    request.body_userdata = body_userdata;
+    request.body_size = body_size;
+  }
   request.headers = headers;
   request.datafunc = datafunc;
   request.userdata = userdata;
+  request.zero_copy = zero_copy;
+  request.buffer = buffer;
   request.progressfunc = progressfunc;
   request.progress_userdata = progress_userdata;
   request.debug = debug;
@@ -17,19 +17,62 @@
 
 #include "miniocpp/response.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cstring>
+#include <ctime>
+#include <iterator>
 #include <list>
 #include <map>
-#include <pugixml.hpp>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "miniocpp/error.h"
 #include "miniocpp/types.h"
 #include "miniocpp/utils.h"
+#include "miniocpp/xml.h"
 
 namespace minio::s3 {
 
+namespace {
+
+template <typename T>
+void ParseNumber(std::string_view text, T& value) {
+  std::from_chars(text.data(), text.data() + text.size(), value);
+}
+
+utils::UtcTime ParseTime(std::string_view text) {
+  return utils::UtcTime::FromISO8601UTC(std::string(text).c_str());
+}
+
+bool ParseBool(std::string_view text) {
+  return utils::StringToBool(std::string(text));
+}
+
+std::string_view TrimQuotes(std::string_view text) {
+  while (!text.empty() && text.front() == '"') text.remove_prefix(1);
+  while (!text.empty() && text.back() == '"') text.remove_suffix(1);
+  return text;
+}
+
+constexpr xml::Field<Response> kErrorFields[] = {
+    {"Code", [](Response& r, std::string_view v) { r.code = v; }},
+    {"Message", [](Response& r, std::string_view v) { r.message = v; }},
+    {"Resource", [](Response& r, std::string_view v) { r.resource = v; }},
+    {"RequestId", [](Response& r, std::string_view v) { r.request_id = v; }},
+    {"HostId", [](Response& r, std::string_view v) { r.host_id = v; }},
+    {"BucketName",
+     [](Response& r, std::string_view v) { r.bucket_name = v; }},
+    {"Key", [](Response& r, std::string_view v) { r.object_name = v; }},
+};
+
+}  // namespace
+
 Response::Response() {}
 
 Response::~Response() {}
@@ -40,816 +83,874 @@ Result<Response> Response::ParseXML(std::string_view data, int status_code,
   resp.status_code = status_code;
   resp.headers = headers;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
+  if (xml::Decode(data, "Error", kErrorFields, resp)) {
     return error::make<Response>("unable to parse XML; " + std::string(data));
   }
 
-  auto root = xdoc.select_node("/Error");
-  pugi::xpath_node text;
-
-  text = root.node().select_node("Code/text()");
-  resp.code = text.node().value();
-
-  text = root.node().select_node("Message/text()");
-  resp.message = text.node().value();
-
-  text = root.node().select_node("Resource/text()");
-  resp.resource = text.node().value();
-
-  text = root.node().select_node("RequestId/text()");
-  resp.request_id = text.node().value();
+  return resp;
+}
 
-  text = root.node().select_node("HostId/text()");
-  resp.host_id = text.node().value();
+namespace {
 
-  text = root.node().select_node("BucketName/text()");
-  resp.bucket_name = text.node().value();
+constexpr xml::Field<std::list<Bucket>> kListBucketsFields[] = {
+    {"Buckets/Bucket", nullptr, [](std::list<Bucket>& b) { b.emplace_back(); }},
+    {"Buckets/Bucket/Name",
+     [](std::list<Bucket>& b, std::string_view v) { b.back().name = v; }},
+    {"Buckets/Bucket/CreationDate",
+     [](std::list<Bucket>& b, std::string_view v) {
+       b.back().creation_date = ParseTime(v);
+     }},
+};
 
-  text = root.node().select_node("Key/text()");
-  resp.object_name = text.node().value();
-
-  return resp;
-}
+}  // namespace
 
 Result<ListBucketsResponse> ListBucketsResponse::ParseXML(
     std::string_view data) {
   std::list<Bucket> buckets;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<ListBucketsResponse>("unable to parse XML");
+  if (error::Error err = xml::Decode(data, "ListAllMyBucketsResult",
+                                     kListBucketsFields, buckets)) {
+    return tl::make_unexpected(err);
   }
-  pugi::xpath_node_set xnodes =
-      xdoc.select_nodes("/ListAllMyBucketsResult/Buckets/Bucket");
-  for (auto xnode : xnodes) {
-    std::string name;
-    utils::UtcTime creation_date;
-    if (auto node = xnode.node().select_node("Name/text()").node()) {
-      name = node.value();
-    }
-    if (auto node = xnode.node().select_node("CreationDate/text()").node()) {
-      std::string value = node.value();
-      creation_date = utils::UtcTime::FromISO8601UTC(value.c_str());
-    }
 
-    buckets.push_back(Bucket(std::move(name), std::move(creation_date)));
+  return ListBucketsResponse(buckets);
+}
+
+namespace {
+
+constexpr xml::Field<ListPartsResponse> kListPartsFields[] = {
+    {"Bucket",
+     [](ListPartsResponse& r, std::string_view v) { r.bucket_name = v; }},
+    {"Key",
+     [](ListPartsResponse& r, std::string_view v) { r.object_name = v; }},
+    {"UploadId",
+     [](ListPartsResponse& r, std::string_view v) { r.upload_id = v; }},
+    {"PartNumberMarker",
+     [](ListPartsResponse& r, std::string_view v) {
+       ParseNumber(v, r.part_number_marker);
+     }},
+    {"NextPartNumberMarker",
+     [](ListPartsResponse& r, std::string_view v) {
+       ParseNumber(v, r.next_part_number_marker);
+     }},
+    {"MaxParts",
+     [](ListPartsResponse& r, std::string_view v) {
+       ParseNumber(v, r.max_parts);
+     }},
+    {"IsTruncated",
+     [](ListPartsResponse& r, std::string_view v) {
+       r.is_truncated = ParseBool(v);
+     }},
+    {"Part", nullptr, [](ListPartsResponse& r) { r.parts.emplace_back(); }},
+    {"Part/PartNumber",
+     [](ListPartsResponse& r, std::string_view v) {
+       ParseNumber(v, r.parts.back().number);
+     }},
+    {"Part/ETag",
+     [](ListPartsResponse& r, std::string_view v) {
+       r.parts.back().etag = TrimQuotes(v);
+     }},
+    {"Part/LastModified",
+     [](ListPartsResponse& r, std::string_view v) {
+       r.parts.back().last_modified = ParseTime(v);
+     }},
+    {"Part/Size",
+     [](ListPartsResponse& r, std::string_view v) {
+       ParseNumber(v, r.parts.back().size);
+     }},
+    {"Part/ChecksumCRC64NVME",
+     [](ListPartsResponse& r, std::string_view v) {
+       r.parts.back().checksum_crc64nvme = v;
+     }},
+};
+
+}  // namespace
+
+Result<ListPartsResponse> ListPartsResponse::ParseXML(std::string_view data) {
+  ListPartsResponse resp;
+
+  if (error::Error err =
+          xml::Decode(data, "ListPartsResult", kListPartsFields, resp)) {
+    return tl::make_unexpected(err);
   }
 
-  return ListBucketsResponse(buckets);
+  return resp;
 }
 
+namespace {
+
+using CompleteResponse = CompleteMultipartUploadResponse;
+
+constexpr xml::Field<CompleteResponse> kCompleteMultipartUploadFields[] = {
+    {"Bucket",
+     [](CompleteResponse& r, std::string_view v) { r.bucket_name = v; }},
+    {"Key",
+     [](CompleteResponse& r, std::string_view v) { r.object_name = v; }},
+    {"Location",
+     [](CompleteResponse& r, std::string_view v) { r.location = v; }},
+    {"ETag",
+     [](CompleteResponse& r, std::string_view v) { r.etag = TrimQuotes(v); }},
+    {"ChecksumCRC32",
+     [](CompleteResponse& r, std::string_view v) { r.checksumCRC32 = v; }},
+    {"ChecksumCRC32C",
+     [](CompleteResponse& r, std::string_view v) { r.checksumCRC32C = v; }},
+    {"ChecksumSHA1",
+     [](CompleteResponse& r, std::string_view v) { r.checksumSHA1 = v; }},
+    {"ChecksumSHA256",
+     [](CompleteResponse& r, std::string_view v) { r.checksumSHA256 = v; }},
+    {"ChecksumCRC64NVME",
+     [](CompleteResponse& r, std::string_view v) {
+       r.checksum_crc64nvme = v;
+     }},
+};
+
+}  // namespace
+
 Result<CompleteMultipartUploadResponse>
 CompleteMultipartUploadResponse::ParseXML(std::string_view data,
                                           std::string version_id) {
   CompleteMultipartUploadResponse resp;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<CompleteMultipartUploadResponse>("unable to parse XML");
+  if (error::Error err = xml::Decode(data, "CompleteMultipartUploadResult",
+                                     kCompleteMultipartUploadFields, resp)) {
+    return tl::make_unexpected(err);
   }
-  auto root = xdoc.select_node("/CompleteMultipartUploadResult");
-
-  pugi::xpath_node text;
-
-  text = root.node().select_node("Bucket/text()");
-  resp.bucket_name = text.node().value();
-
-  text = root.node().select_node("Key/text()");
-  resp.object_name = text.node().value();
-
-  text = root.node().select_node("Location/text()");
-  resp.location = text.node().value();
-
-  text = root.node().select_node("ETag/text()");
-  resp.etag = utils::Trim(text.node().value(), '"');
-
-  text = root.node().select_node("ChecksumCRC32/text()");
-  resp.checksumCRC32 = text.node().value();
-
-  text = root.node().select_node("ChecksumCRC32/text()");
-  resp.checksumCRC32C = text.node().value();
-
-  text = root.node().select_node("ChecksumSHA1/text()");
-  resp.checksumSHA1 = text.node().value();
-
-  text = root.node().select_node("ChecksumSHA256/text()");
-  resp.checksumSHA256 = text.node().value();
 
   resp.version_id = version_id;
 
   return resp;
 }
 
-Result<ListObjectsResponse> ListObjectsResponse::ParseXML(std::string_view data,
-                                                          bool version) {
-  ListObjectsResponse resp;
+namespace {
 
-  auto xdoc = std::make_shared<pugi::xml_document>();
-  pugi::xml_parse_result result = xdoc->load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<ListObjectsResponse>("unable to parse XML");
-  }
-  resp.doc_ = std::move(xdoc);
-  std::string xpath = version ? "/ListVersionsResult" : "/ListBucketResult";
-
-  auto root = resp.doc_->select_node(xpath.c_str());
-
-  pugi::xpath_node text;
-  std::string value;
-  const char* raw = nullptr;
-
-  // Helper to store an unescaped string or point into doc memory.
-  auto assign_unescaped = [&resp](std::string_view encoding_type,
-                                  const char* raw,
-                                  std::string_view& target) -> void {
-    if (encoding_type == "url") {
-      resp.owned_.emplace_back(utils::UriDecode(raw));
-      target = resp.owned_.back();
-    } else {
-      target = raw;
-    }
+// UriDecodeInPlace reverses percent-encoding of value, a view into a
+// writable page buffer, where it stands; '+' is not treated as space.
+std::string_view UriDecodeInPlace(std::string_view value) {
+  auto hex_value = [](char c) -> int {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return c - 'A' + 10;
   };
 
-  text = root.node().select_node("Name/text()");
-  resp.name = text.node().value();
-
-  text = root.node().select_node("EncodingType/text()");
-  resp.encoding_type = text.node().value();
-
-  text = root.node().select_node("Prefix/text()");
-  raw = text.node().value();
-  assign_unescaped(resp.encoding_type, raw, resp.prefix);
-
-  text = root.node().select_node("Delimiter/text()");
-  resp.delimiter = text.node().value();
-
-  text = root.node().select_node("IsTruncated/text()");
-  value = text.node().value();
-  if (!value.empty()) resp.is_truncated = utils::StringToBool(value);
-
-  text = root.node().select_node("MaxKeys/text()");
-  value = text.node().value();
-  if (!value.empty()) resp.max_keys = static_cast<unsigned>(std::stoul(value));
-
-  // ListBucketResult V1
-  {
-    text = root.node().select_node("Marker/text()");
-    raw = text.node().value();
-    assign_unescaped(resp.encoding_type, raw, resp.marker);
-
-    text = root.node().select_node("NextMarker/text()");
-    raw = text.node().value();
-    assign_unescaped(resp.encoding_type, raw, resp.next_marker);
+  char* begin = const_cast<char*>(value.data());
+  char* w = begin;
+  for (size_t i = 0; i < value.size(); i++) {
+    if (value[i] == '%' && i + 2 < value.size() &&
+        std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+        std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+      *w++ = static_cast<char>((hex_value(value[i + 1]) << 4) |
+                               hex_value(value[i + 2]));
+      i += 2;
+    } else {
+      *w++ = value[i];
+    }
   }
+  return std::string_view(begin, static_cast<size_t>(w - begin));
+}
 
-  // ListBucketResult V2
-  {
-    text = root.node().select_node("KeyCount/text()");
-    value = text.node().value();
-    if (!value.empty())
-      resp.key_count = static_cast<unsigned>(std::stoul(value));
-
-    text = root.node().select_node("StartAfter/text()");
-    raw = text.node().value();
-    assign_unescaped(resp.encoding_type, raw, resp.start_after);
+// TimeParser converts LastModified values like UtcTime::FromISO8601UTC.
+// mktime() looks up the local time zone on each call, and the keys of a page
+// are often written within the same hours, so the start of the last hour
+// seen is kept; the result is linear within an hour.
+class TimeParser {
+ public:
+  utils::UtcTime Parse(std::string_view text) {
+    char value[64];
+    size_t n = std::min(text.size(), sizeof(value) - 1);
+    std::memcpy(value, text.data(), n);
+    value[n] = '\0';
+
+    // YYYY-MM-DDTHH:MM:SS
+    static constexpr std::string_view kLayout = "0000-00-00T00:00:00";
+    bool matches = n >= kLayout.size();
+    for (size_t i = 0; matches && i < kLayout.size(); ++i) {
+      matches = kLayout[i] == '0' ? std::isdigit(value[i]) != 0
+                                  : value[i] == kLayout[i];
+    }
+    if (!matches) return utils::UtcTime::FromISO8601UTC(value);
 
-    text = root.node().select_node("ContinuationToken/text()");
-    resp.continuation_token = text.node().value();
+    auto number = [&value](size_t pos, size_t len) {
+      int result = 0;
+      for (size_t i = pos; i < pos + len; ++i) {
+        result = result * 10 + (value[i] - '0');
+      }
+      return result;
+    };
+    if (std::memcmp(hour_, value, sizeof(hour_)) != 0) {
+      std::tm t{};
+      t.tm_year = number(0, 4) - 1900;
+      t.tm_mon = number(5, 2) - 1;
+      t.tm_mday = number(8, 2);
+      t.tm_hour = number(11, 2);
+      hour_secs_ = std::mktime(&t);
+      std::memcpy(hour_, value, sizeof(hour_));
+    }
+    std::time_t secs = hour_secs_ + number(14, 2) * 60 + number(17, 2);
 
-    text = root.node().select_node("NextContinuationToken/text()");
-    resp.next_continuation_token = text.node().value();
+    unsigned long usecs = 0;
+    if (value[19] == '.') {
+      std::from_chars(value + 20, value + n, usecs);
+    }
+    return utils::UtcTime(secs, static_cast<long>(usecs));
   }
 
-  // ListVersionsResult
-  {
-    text = root.node().select_node("KeyMarker/text()");
-    raw = text.node().value();
-    assign_unescaped(resp.encoding_type, raw, resp.key_marker);
-
-    text = root.node().select_node("NextKeyMarker/text()");
-    raw = text.node().value();
-    assign_unescaped(resp.encoding_type, raw, resp.next_key_marker);
-
-    text = root.node().select_node("VersionIdMarker/text()");
-    resp.version_id_marker = text.node().value();
-
-    text = root.node().select_node("NextVersionIdMarker/text()");
-    resp.next_version_id_marker = text.node().value();
+ private:
+  char hour_[13] = {};  // YYYY-MM-DDTHH
+  std::time_t hour_secs_ = 0;
+};  // class TimeParser
+
+// SetItemField sets the field of item named by a child element of Contents,
+// Version, DeleteMarker or CommonPrefixes.
+void SetItemField(Item& item, std::string_view name, std::string_view text,
+                  TimeParser& times) {
+  if (name == "Key" || (item.is_prefix && name == "Prefix")) {
+    item.name = text;
+  } else if (name == "LastModified") {
+    item.last_modified = times.Parse(text);
+  } else if (name == "ETag") {
+    while (!text.empty() && text.front() == '"') text.remove_prefix(1);
+    while (!text.empty() && text.back() == '"') text.remove_suffix(1);
+    item.etag = text;
+  } else if (name == "Size") {
+    ParseNumber(text, item.size);
+  } else if (name == "StorageClass") {
+    item.storage_class = text;
+  } else if (name == "IsLatest") {
+    item.is_latest = utils::StringToBool(std::string(text));
+  } else if (name == "VersionId") {
+    item.version_id = text;
   }
+}
 
-  Item last_item;
-
-  auto populate = [&resp = resp, &last_item = last_item](
-                      std::list<Item>& items, pugi::xpath_node_set& contents,
-                      bool is_delete_marker) -> void {
-    const char* raw = nullptr;
-    for (auto content : contents) {
-      pugi::xpath_node text;
-      std::string value;
-      Item item;
-
-      text = content.node().select_node("ETag/text()");
-      resp.owned_.emplace_back(utils::Trim(text.node().value(), '"'));
-      item.etag = resp.owned_.back();
-
-      text = content.node().select_node("Key/text()");
-      raw = text.node().value();
-      if (resp.encoding_type == "url") {
-        resp.owned_.emplace_back(utils::UriDecode(raw));
-        item.name = resp.owned_.back();
-      } else {
-        item.name = raw;
-      }
-
-      text = content.node().select_node("LastModified/text()");
-      value = text.node().value();
-      item.last_modified = utils::UtcTime::FromISO8601UTC(value.c_str());
-
-      text = content.node().select_node("Owner/ID/text()");
-      item.owner_id = text.node().value();
-
-      text = content.node().select_node("Owner/DisplayName/text()");
-      item.owner_name = text.node().value();
-
-      text = content.node().select_node("Size/text()");
-      value = text.node().value();
-      if (!value.empty()) item.size = static_cast<size_t>(std::stoull(value));
-
-      text = content.node().select_node("StorageClass/text()");
-      item.storage_class = text.node().value();
-
-      text = content.node().select_node("IsLatest/text()");
-      value = text.node().value();
-      if (!value.empty()) item.is_latest = utils::StringToBool(value);
+// SetPageField sets the field of resp named by a child element of the
+// document element.
+void SetPageField(ListObjectsResponse& resp, std::string_view name,
+                  std::string_view text) {
+  if (name == "Name") {
+    resp.name = text;
+  } else if (name == "EncodingType") {
+    resp.encoding_type = text;
+  } else if (name == "Prefix") {
+    resp.prefix = text;
+  } else if (name == "Delimiter") {
+    resp.delimiter = text;
+  } else if (name == "IsTruncated") {
+    resp.is_truncated = utils::StringToBool(std::string(text));
+  } else if (name == "MaxKeys") {
+    ParseNumber(text, resp.max_keys);
+  } else if (name == "Marker") {
+    resp.marker = text;
+  } else if (name == "NextMarker") {
+    resp.next_marker = text;
+  } else if (name == "KeyCount") {
+    ParseNumber(text, resp.key_count);
+  } else if (name == "StartAfter") {
+    resp.start_after = text;
+  } else if (name == "ContinuationToken") {
+    resp.continuation_token = text;
+  } else if (name == "NextContinuationToken") {
+    resp.next_continuation_token = text;
+  } else if (name == "KeyMarker") {
+    resp.key_marker = text;
+  } else if (name == "NextKeyMarker") {
+    resp.next_key_marker = text;
+  } else if (name == "VersionIdMarker") {
+    resp.version_id_marker = text;
+  } else if (name == "NextVersionIdMarker") {
+    resp.next_version_id_marker = text;
+  }
+}
 
-      text = content.node().select_node("VersionId/text()");
-      item.version_id = text.node().value();
+}  // namespace
 
-      auto user_metadata = content.node().select_node("UserMetadata");
-      for (auto metadata = user_metadata.node().first_child(); metadata;
-           metadata = metadata.next_sibling()) {
-        item.user_metadata[metadata.name()] = metadata.child_value();
+Result<ListObjectsResponse> ListObjectsResponse::ParseXML(std::string data,
+                                                          bool version) {
+  ListObjectsResponse resp;
+  resp.page_ = std::make_shared<std::string>(std::move(data));
+  xml::Reader reader(resp.page_->data(), resp.page_->size());
+
+  const std::string_view root =
+      version ? "ListVersionsResult" : "ListBucketResult";
+  const std::string_view entry = version ? "Version" : "Contents";
+  // Entries are returned in the order versions or objects, common prefixes,
+  // delete markers.
+  std::vector<Item> prefixes;
+  std::vector<Item> delete_markers;
+  std::vector<Item>* items = nullptr;  // Where the open entry goes.
+  Item item;
+  std::string_view parent;  // Open child element of the entry.
+  bool matched = false;
+  TimeParser times;
+
+  while (true) {
+    xml::Reader::Event event = reader.Next();
+    if (event == xml::Reader::Event::kEof) break;
+    if (event == xml::Reader::Event::kError) {
+      return error::make<ListObjectsResponse>(
+          std::string("unable to parse XML; ") + reader.Error());
+    }
+    std::string_view name = reader.Name();
+    size_t depth = reader.Depth();
+    if (depth == 1) {
+      if (event == xml::Reader::Event::kStart) matched = name == root;
+      continue;
+    }
+    if (!matched) continue;
+
+    if (depth == 2) {
+      if (event == xml::Reader::Event::kText) {
+        if (items == nullptr) SetPageField(resp, name, reader.Text());
+      } else if (event == xml::Reader::Event::kStart) {
+        items = name == entry              ? &resp.contents
+                : name == "CommonPrefixes" ? &prefixes
+                : name == "DeleteMarker"   ? &delete_markers
+                                           : nullptr;
+        if (items == &resp.contents && resp.contents.capacity() == 0) {
+          // MaxKeys usually precedes the entries and bounds their count.
+          resp.contents.reserve(std::min(resp.max_keys, 10000u));
+        }
+        item = Item();
+        item.is_prefix = items == &prefixes;
+        item.is_delete_marker = items == &delete_markers;
+      } else if (items != nullptr) {
+        items->push_back(std::move(item));
+        items = nullptr;
       }
-
-      item.is_delete_marker = is_delete_marker;
-
-      items.push_back(item);
-      last_item = item;
+      continue;
     }
-  };
+    if (items == nullptr) continue;
 
-  auto contents = root.node().select_nodes(version ? "Version" : "Contents");
-  populate(resp.contents, contents, false);
-  // Only for ListObjectsV1.
-  if (resp.is_truncated && resp.next_marker.empty()) {
-    resp.owned_.emplace_back(last_item.name);
-    resp.next_marker = resp.owned_.back();
+    if (depth == 3) {
+      if (event == xml::Reader::Event::kStart) {
+        parent = name;
+      } else if (event == xml::Reader::Event::kText) {
+        SetItemField(item, name, reader.Text(), times);
+      }
+    } else if (depth == 4 && parent == "UserMetadata") {
+      if (event == xml::Reader::Event::kStart) {
+        item.user_metadata.emplace_back(name, std::string_view());
+      } else if (event == xml::Reader::Event::kText) {
+        item.user_metadata.back().second = reader.Text();
+      }
+    } else if (depth == 4 && parent == "Owner" &&
+               event == xml::Reader::Event::kText) {
+      if (name == "ID") item.owner_id = reader.Text();
+      if (name == "DisplayName") item.owner_name = reader.Text();
+    }
   }
 
-  auto common_prefixes = root.node().select_nodes("CommonPrefixes");
-  for (auto common_prefix : common_prefixes) {
-    Item item;
-    text = common_prefix.node().select_node("Prefix/text()");
-    raw = text.node().value();
-    if (resp.encoding_type == "url") {
-      resp.owned_.emplace_back(utils::UriDecode(raw));
-      item.name = resp.owned_.back();
-    } else {
-      item.name = raw;
+  // EncodingType may follow the keys it applies to.
+  if (resp.encoding_type == "url") {
+    for (std::string_view* value :
+         {&resp.prefix, &resp.marker, &resp.next_marker, &resp.start_after,
+          &resp.key_marker, &resp.next_key_marker}) {
+      *value = UriDecodeInPlace(*value);
     }
-    item.is_prefix = true;
+    for (auto* list : {&resp.contents, &prefixes, &delete_markers}) {
+      for (Item& i : *list) i.name = UriDecodeInPlace(i.name);
+    }
+  }
 
-    resp.contents.push_back(item);
+  // Only for ListObjectsV1.
+  if (resp.is_truncated && resp.next_marker.empty() && !resp.contents.empty()) {
+    resp.next_marker = resp.contents.back().name;
   }
 
-  auto delete_markers = root.node().select_nodes("DeleteMarker");
-  populate(resp.contents, delete_markers, true);
+  resp.contents.reserve(resp.contents.size() + prefixes.size() +
+                        delete_markers.size());
+  for (auto* list : {&prefixes, &delete_markers}) {
+    std::move(list->begin(), list->end(), std::back_inserter(resp.contents));
+  }
 
   return resp;
 }
+namespace {
+
+constexpr xml::Field<RemoveObjectsResponse> kDeleteResultFields[] = {
+    {"Deleted", nullptr,
+     [](RemoveObjectsResponse& r) { r.objects.emplace_back(); }},
+    {"Deleted/Key",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.objects.back().name = v;
+     }},
+    {"Deleted/VersionId",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.objects.back().version_id = v;
+     }},
+    {"Deleted/DeleteMarkerVersionId",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.objects.back().delete_marker_version_id = v;
+     }},
+    {"Deleted/DeleteMarker",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.objects.back().delete_marker = ParseBool(v);
+     }},
+    {"Error", nullptr,
+     [](RemoveObjectsResponse& r) { r.errors.emplace_back(); }},
+    {"Error/Key",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.errors.back().object_name = v;
+     }},
+    {"Error/VersionId",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.errors.back().version_id = v;
+     }},
+    {"Error/Code",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.errors.back().code = v;
+     }},
+    {"Error/Message",
+     [](RemoveObjectsResponse& r, std::string_view v) {
+       r.errors.back().message = v;
+     }},
+};
+
+}  // namespace
 
 Result<RemoveObjectsResponse> RemoveObjectsResponse::ParseXML(
     std::string_view data) {
   RemoveObjectsResponse resp;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<RemoveObjectsResponse>("unable to parse XML");
-  }
-  auto root = xdoc.select_node("/DeleteResult");
-
-  auto deletedList = root.node().select_nodes("Deleted");
-  for (auto deleted : deletedList) {
-    pugi::xpath_node text;
-    std::string value;
-    DeletedObject object;
-
-    text = deleted.node().select_node("Key/text()");
-    object.name = text.node().value();
-
-    text = deleted.node().select_node("VersionId/text()");
-    object.version_id = text.node().value();
-
-    text = deleted.node().select_node("DeleteMarkerVersionId/text()");
-    object.delete_marker_version_id = text.node().value();
-
-    text = deleted.node().select_node("DeleteMarker/text()");
-    value = text.node().value();
-    if (!value.empty()) object.delete_marker = utils::StringToBool(value);
-
-    resp.objects.push_back(object);
-  }
-
-  auto errorList = root.node().select_nodes("Error");
-  for (auto error : errorList) {
-    pugi::xpath_node text;
-    std::string value;
-    DeleteError err;
-
-    text = error.node().select_node("Key/text()");
-    err.object_name = text.node().value();
-
-    text = error.node().select_node("VersionId/text()");
-    err.version_id = text.node().value();
-
-    text = error.node().select_node("Code/text()");
-    err.code = text.node().value();
-
-    text = error.node().select_node("Message/text()");
-    err.message = text.node().value();
-
-    resp.errors.push_back(err);
+  if (error::Error err =
+          xml::Decode(data, "DeleteResult", kDeleteResultFields, resp)) {
+    return tl::make_unexpected(err);
   }
 
   return resp;
 }
 
-Result<GetBucketNotificationResponse> GetBucketNotificationResponse::ParseXML(
-    std::string_view data) {
-  NotificationConfig config;
-
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetBucketNotificationResponse>("unable to parse XML");
-  }
-  auto root = xdoc.select_node("/NotificationConfiguration");
-
-  auto populate = [](pugi::xpath_node& common) -> NotificationCommonConfig {
-    NotificationCommonConfig cfg;
-    pugi::xpath_node text;
-
-    auto events = common.node().select_nodes("Event");
-    for (auto event : events) cfg.events.push_back(event.node().value());
-
-    text = common.node().select_node("Id/text()");
-    cfg.id = text.node().value();
+std::unique_ptr<xml::Decoder<RemoveObjectsResponse>>
+RemoveObjectsResponse::NewDecoder(RemoveObjectsResponse& resp) {
+  return std::make_unique<xml::Decoder<RemoveObjectsResponse>>(
+      "DeleteResult", kDeleteResultFields, resp);
+}
 
-    if (common.node().select_node("Filter")) {
-      auto filters = common.node().select_nodes("Filter/S3Key/FilterRule");
-      for (auto filter : filters) {
-        text = filter.node().select_node("Name/text()");
-        auto name = text.node().value();
+namespace {
 
-        text = filter.node().select_node("Value/text()");
-        auto value = text.node().value();
+// NotificationState is the configuration being read and the filter rule of
+// its open entry.
+struct NotificationState {
+  NotificationConfig config;
+  NotificationCommonConfig* common = nullptr;  // Open entry.
+  std::string rule_name;
+  std::string rule_value;
+};  // struct NotificationState
+
+// Fields of NotificationConfiguration, applied below the document element.
+constexpr xml::Field<NotificationState> kNotificationFields[] = {
+    {"CloudFunctionConfiguration", nullptr,
+     [](NotificationState& s) {
+       s.common = &s.config.cloud_func_config_list.emplace_back();
+     }},
+    {"CloudFunctionConfiguration/CloudFunction",
+     [](NotificationState& s, std::string_view v) {
+       s.config.cloud_func_config_list.back().cloud_func = v;
+     }},
+    {"QueueConfiguration", nullptr,
+     [](NotificationState& s) {
+       s.common = &s.config.queue_config_list.emplace_back();
+     }},
+    {"QueueConfiguration/Queue",
+     [](NotificationState& s, std::string_view v) {
+       s.config.queue_config_list.back().queue = v;
+     }},
+    {"TopicConfiguration", nullptr,
+     [](NotificationState& s) {
+       s.common = &s.config.topic_config_list.emplace_back();
+     }},
+    {"TopicConfiguration/Topic",
+     [](NotificationState& s, std::string_view v) {
+       s.config.topic_config_list.back().topic = v;
+     }},
+};
+
+// Fields shared by all entries, applied below the open entry.
+constexpr xml::Field<NotificationState> kNotificationCommonFields[] = {
+    {"Event",
+     [](NotificationState& s, std::string_view v) {
+       s.common->events.emplace_back(v);
+     }},
+    {"Id", [](NotificationState& s, std::string_view v) { s.common->id = v; }},
+    {"Filter/S3Key/FilterRule", nullptr,
+     [](NotificationState& s) {
+       s.rule_name.clear();
+       s.rule_value.clear();
+     },
+     [](NotificationState& s) {
+       if (s.rule_name == "prefix") {
+         s.common->prefix_filter_rule = PrefixFilterRule(s.rule_value);
+       } else {
+         s.common->suffix_filter_rule = SuffixFilterRule(s.rule_value);
+       }
+     }},
+    {"Filter/S3Key/FilterRule/Name",
+     [](NotificationState& s, std::string_view v) { s.rule_name = v; }},
+    {"Filter/S3Key/FilterRule/Value",
+     [](NotificationState& s, std::string_view v) { s.rule_value = v; }},
+};
+
+}  // namespace
 
-        if (strcmp(name, "prefix") == 0) {
-          cfg.prefix_filter_rule = PrefixFilterRule(value);
-        } else {
-          cfg.suffix_filter_rule = SuffixFilterRule(value);
-        }
+Result<GetBucketNotificationResponse> GetBucketNotificationResponse::ParseXML(
+    std::string_view data) {
+  NotificationState state;
+
+  xml::Reader reader;
+  reader.Feed(data);
+  reader.Close();
+  bool matched = false;
+  while (true) {
+    xml::Reader::Event event = reader.Next();
+    if (event == xml::Reader::Event::kEof) break;
+    if (event == xml::Reader::Event::kError) {
+      return error::make<GetBucketNotificationResponse>(
+          std::string("unable to parse XML; ") + reader.Error());
+    }
+    if (reader.Depth() == 1) {
+      if (event == xml::Reader::Event::kStart) {
+        matched = reader.Name() == "NotificationConfiguration";
       }
+      continue;
     }
+    if (!matched) continue;
 
-    return cfg;
-  };
-
-  pugi::xpath_node text;
-  std::string value;
-
-  auto cloudfuncs = root.node().select_nodes("CloudFunctionConfiguration");
-  for (auto cloudfunc : cloudfuncs) {
-    CloudFuncConfig cfg;
-
-    text = cloudfunc.node().select_node("CloudFunction/text()");
-    cfg.cloud_func = text.node().value();
-
-    NotificationCommonConfig common = populate(cloudfunc);
-    cfg.events = common.events;
-    cfg.id = common.id;
-    cfg.prefix_filter_rule = common.prefix_filter_rule;
-    cfg.suffix_filter_rule = common.suffix_filter_rule;
-
-    config.cloud_func_config_list.push_back(cfg);
-  }
-
-  auto queues = root.node().select_nodes("QueueConfiguration");
-  for (auto queue : queues) {
-    QueueConfig cfg;
-
-    text = queue.node().select_node("Queue/text()");
-    cfg.queue = text.node().value();
-
-    NotificationCommonConfig common = populate(queue);
-    cfg.events = common.events;
-    cfg.id = common.id;
-    cfg.prefix_filter_rule = common.prefix_filter_rule;
-    cfg.suffix_filter_rule = common.suffix_filter_rule;
-
-    config.queue_config_list.push_back(cfg);
+    if (reader.Depth() == 2 && event == xml::Reader::Event::kStart) {
+      state.common = nullptr;
+    }
+    if (!xml::Apply(kNotificationFields, std::size(kNotificationFields),
+                    reader, 1, state, event) &&
+        state.common != nullptr) {
+      xml::Apply(kNotificationCommonFields,
+                 std::size(kNotificationCommonFields), reader, 2, state,
+                 event);
+    }
   }
 
-  auto topics = root.node().select_nodes("TopicConfiguration");
-  for (auto topic : topics) {
-    TopicConfig cfg;
-
-    text = topic.node().select_node("Topic/text()");
-    cfg.topic = text.node().value();
+  return GetBucketNotificationResponse(state.config);
+}
 
-    NotificationCommonConfig common = populate(topic);
-    cfg.events = common.events;
-    cfg.id = common.id;
-    cfg.prefix_filter_rule = common.prefix_filter_rule;
-    cfg.suffix_filter_rule = common.suffix_filter_rule;
+namespace {
 
-    config.topic_config_list.push_back(cfg);
-  }
+constexpr xml::Field<SseConfig> kEncryptionFields[] = {
+    {"Rule/ApplyServerSideEncryptionByDefault/SSEAlgorithm",
+     [](SseConfig& c, std::string_view v) { c.sse_algorithm = v; }},
+    {"Rule/ApplyServerSideEncryptionByDefault/KMSMasterKeyID",
+     [](SseConfig& c, std::string_view v) { c.kms_master_key_id = v; }},
+};
 
-  return GetBucketNotificationResponse(config);
-}
+}  // namespace
 
 Result<GetBucketEncryptionResponse> GetBucketEncryptionResponse::ParseXML(
     std::string_view data) {
   SseConfig config;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetBucketEncryptionResponse>("unable to parse XML");
+  if (error::Error err = xml::Decode(data, "ServerSideEncryptionConfiguration",
+                                     kEncryptionFields, config)) {
+    return tl::make_unexpected(err);
   }
-  auto root = xdoc.select_node(
-      "/ServerSideEncryptionConfiguration/Rule"
-      "/ApplyServerSideEncryptionByDefault");
-
-  pugi::xpath_node text = root.node().select_node("SSEAlgorithm/text()");
-  config.sse_algorithm = text.node().value();
-
-  text = root.node().select_node("KMSMasterKeyID/text()");
-  config.kms_master_key_id = text.node().value();
 
   return GetBucketEncryptionResponse(config);
 }
 
-Result<GetBucketReplicationResponse> GetBucketReplicationResponse::ParseXML(
-    std::string_view data) {
-  ReplicationConfig config;
-
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetBucketReplicationResponse>("unable to parse XML");
-  }
-  auto root = xdoc.select_node("/ReplicationConfiguration");
-
-  pugi::xpath_node text;
-  std::string value;
-
-  if (root.node().select_node("Role")) {
-    text = root.node().select_node("Role/text()");
-    config.role = text.node().value();
-  }
-
-  auto rules = root.node().select_nodes("Rule");
-  for (auto& rule : rules) {
-    ReplicationRule rrule;
-
-    text = rule.node().select_node("ID/text()");
-    rrule.id = text.node().value();
+namespace {
 
-    text = rule.node().select_node("Status/text()");
-    value = text.node().value();
-    rrule.status = (value == "Enabled");
+// RulesState is a configuration of rules being read and the tag of the
+// open And operator of a filter.
+template <typename Config>
+struct RulesState {
+  Config config;
+  Tag tag;
+};  // struct RulesState
 
-    auto destination = rule.node().select_node("Destination");
-
-    text = destination.node().select_node("Bucket/text()");
-    rrule.destination.bucket_arn = text.node().value();
-
-    text = destination.node().select_node("Account/text()");
-    rrule.destination.account = text.node().value();
-
-    text = destination.node().select_node("StorageClass/text()");
-    rrule.destination.storage_class = text.node().value();
-
-    if (destination.node().select_node("AccessControlTranslation")) {
-      rrule.destination.access_control_translation.Enable();
-      text = destination.node().select_node(
-          "AccessControlTranslation/Owner/text()");
-      rrule.destination.access_control_translation.owner = text.node().value();
-    }
-    if (destination.node().select_node("EncryptionConfiguration")) {
-      rrule.destination.encryption_config.Enable();
-      text = destination.node().select_node(
-          "EncryptionConfiguration/ReplicaKmsKeyID/text()");
-      rrule.destination.encryption_config.replica_kms_key_id =
-          text.node().value();
-    }
-    if (destination.node().select_node("Metrics")) {
-      rrule.destination.metrics.Enable();
-
-      text = destination.node().select_node(
-          "Metrics/EventThreshold/Minutes/text()");
-      value = text.node().value();
-      rrule.destination.metrics.event_threshold_minutes =
-          static_cast<unsigned>(std::stoul(value));
-
-      text = destination.node().select_node(
-          "Metrics/EventThreshold/Status/text()");
-      value = text.node().value();
-      rrule.destination.metrics.status = (value == "Enabled");
-    }
-    if (destination.node().select_node("ReplicationTime")) {
-      rrule.destination.replication_time.Enable();
-
-      text = destination.node().select_node("ReplicationTime/Time/text()");
-      value = text.node().value();
-      rrule.destination.replication_time.time_minutes =
-          static_cast<unsigned>(std::stoul(value));
-
-      text = destination.node().select_node("ReplicationTime/Status/text()");
-      value = text.node().value();
-      rrule.destination.replication_time.status = (value == "Enabled");
-    }
-
-    if (rule.node().select_node("DeleteMarkerReplication")) {
-      text = rule.node().select_node("DeleteMarkerReplication/Status/text()");
-      value = text.node().value();
-      rrule.delete_marker_replication_status = (value == "Enabled");
-    }
-
-    if (rule.node().select_node("ExistingObjectReplication")) {
-      text = rule.node().select_node("ExistingObjectReplication/Status/text()");
-      value = text.node().value();
-      rrule.existing_object_replication_status = (value == "Enabled");
-    }
-
-    if (rule.node().select_node("Filter")) {
-      auto filter = rule.node().select_node("Filter");
-
-      if (filter.node().select_node("And")) {
-        if (filter.node().select_node("And/Prefix")) {
-          text = filter.node().select_node("And/Prefix/text()");
-          rrule.filter.and_operator.prefix = Prefix(text.node().value());
-        }
-
-        if (filter.node().select_node("And/Tag")) {
-          auto tags = root.node().select_nodes("And/Tag");
-          for (auto& tag : tags) {
-            (void)tag;
-            text = filter.node().select_node("Key/text()");
-            std::string key = text.node().value();
-
-            text = filter.node().select_node("Value/text()");
-            std::string value = text.node().value();
-
-            rrule.filter.and_operator.tags[key] = value;
-          }
-        }
-      }
-
-      if (filter.node().select_node("Prefix")) {
-        text = filter.node().select_node("Prefix/text()");
-        rrule.filter.prefix = Prefix(text.node().value());
-      }
-
-      if (filter.node().select_node("Tag")) {
-        text = filter.node().select_node("Tag/Key/text()");
-        rrule.filter.tag.key = text.node().value();
+// Rule returns the rule being read.
+template <typename Config>
+auto& Rule(RulesState<Config>& s) {
+  return s.config.rules.back();
+}
 
-        text = filter.node().select_node("Tag/Value/text()");
-        rrule.filter.tag.value = text.node().value();
-      }
-    }
+using ReplicationState = RulesState<ReplicationConfig>;
+
+constexpr xml::Field<ReplicationState> kReplicationFields[] = {
+    {"Role",
+     [](ReplicationState& s, std::string_view v) { s.config.role = v; }},
+    {"Rule", nullptr,
+     [](ReplicationState& s) { s.config.rules.emplace_back(); }},
+    {"Rule/ID",
+     [](ReplicationState& s, std::string_view v) { Rule(s).id = v; }},
+    {"Rule/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).status = v == "Enabled";
+     }},
+    {"Rule/Destination/Bucket",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.bucket_arn = v;
+     }},
+    {"Rule/Destination/Account",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.account = v;
+     }},
+    {"Rule/Destination/StorageClass",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.storage_class = v;
+     }},
+    {"Rule/Destination/AccessControlTranslation", nullptr,
+     [](ReplicationState& s) {
+       Rule(s).destination.access_control_translation.Enable();
+     }},
+    {"Rule/Destination/AccessControlTranslation/Owner",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.access_control_translation.owner = v;
+     }},
+    {"Rule/Destination/EncryptionConfiguration", nullptr,
+     [](ReplicationState& s) {
+       Rule(s).destination.encryption_config.Enable();
+     }},
+    {"Rule/Destination/EncryptionConfiguration/ReplicaKmsKeyID",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.encryption_config.replica_kms_key_id = v;
+     }},
+    {"Rule/Destination/Metrics", nullptr,
+     [](ReplicationState& s) { Rule(s).destination.metrics.Enable(); }},
+    {"Rule/Destination/Metrics/EventThreshold/Minutes",
+     [](ReplicationState& s, std::string_view v) {
+       ParseNumber(v, Rule(s).destination.metrics.event_threshold_minutes);
+     }},
+    {"Rule/Destination/Metrics/EventThreshold/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.metrics.status = v == "Enabled";
+     }},
+    {"Rule/Destination/ReplicationTime", nullptr,
+     [](ReplicationState& s) {
+       Rule(s).destination.replication_time.Enable();
+     }},
+    {"Rule/Destination/ReplicationTime/Time/Minutes",
+     [](ReplicationState& s, std::string_view v) {
+       ParseNumber(v, Rule(s).destination.replication_time.time_minutes);
+     }},
+    {"Rule/Destination/ReplicationTime/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).destination.replication_time.status = v == "Enabled";
+     }},
+    {"Rule/DeleteMarkerReplication/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).delete_marker_replication_status = v == "Enabled";
+     }},
+    {"Rule/ExistingObjectReplication/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).existing_object_replication_status = v == "Enabled";
+     }},
+    {"Rule/Filter/And/Prefix",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).filter.and_operator.prefix = Prefix(std::string(v));
+     },
+     [](ReplicationState& s) {
+       Rule(s).filter.and_operator.prefix = Prefix("");
+     }},
+    {"Rule/Filter/And/Tag", nullptr,
+     [](ReplicationState& s) { s.tag = Tag(); },
+     [](ReplicationState& s) {
+       Rule(s).filter.and_operator.tags[s.tag.key] = s.tag.value;
+     }},
+    {"Rule/Filter/And/Tag/Key",
+     [](ReplicationState& s, std::string_view v) { s.tag.key = v; }},
+    {"Rule/Filter/And/Tag/Value",
+     [](ReplicationState& s, std::string_view v) { s.tag.value = v; }},
+    {"Rule/Filter/Prefix",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).filter.prefix = Prefix(std::string(v));
+     },
+     [](ReplicationState& s) { Rule(s).filter.prefix = Prefix(""); }},
+    {"Rule/Filter/Tag/Key",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).filter.tag.key = v;
+     }},
+    {"Rule/Filter/Tag/Value",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).filter.tag.value = v;
+     }},
+    {"Rule/Prefix",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).prefix = Prefix(std::string(v));
+     },
+     [](ReplicationState& s) { Rule(s).prefix = Prefix(""); }},
+    {"Rule/Priority",
+     [](ReplicationState& s, std::string_view v) {
+       int priority = 0;
+       ParseNumber(v, priority);
+       Rule(s).priority = priority;
+     }},
+    {"Rule/SourceSelectionCriteria", nullptr,
+     [](ReplicationState& s) {
+       Rule(s).source_selection_criteria.Enable();
+     }},
+    {"Rule/SourceSelectionCriteria/SseKmsEncryptedObjects/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).source_selection_criteria.sse_kms_encrypted_objects_status =
+           v == "Enabled";
+     }},
+    {"Rule/DeleteReplication/Status",
+     [](ReplicationState& s, std::string_view v) {
+       Rule(s).delete_replication_status = v == "Enabled";
+     }},
+};
+
+}  // namespace
 
-    if (rule.node().select_node("Prefix")) {
-      text = rule.node().select_node("Prefix/text()");
-      rrule.prefix = Prefix(text.node().value());
-    }
+Result<GetBucketReplicationResponse> GetBucketReplicationResponse::ParseXML(
+    std::string_view data) {
+  ReplicationState state;
 
-    if (rule.node().select_node("Priority")) {
-      text = rule.node().select_node("Priority/text()");
-      value = text.node().value();
-      rrule.priority = Integer(std::stoi(value));
-    }
+  if (error::Error err = xml::Decode(data, "ReplicationConfiguration",
+                                     kReplicationFields, state)) {
+    return tl::make_unexpected(err);
+  }
 
-    if (rule.node().select_node("SourceSelectionCriteria")) {
-      rrule.source_selection_criteria.Enable();
-      if (rule.node().select_node(
-              "SourceSelectionCriteria/SseKmsEncryptedObjects")) {
-        text = rule.node().select_node(
-            "SourceSelectionCriteria/SseKmsEncryptedObjects/Status/text()");
-        value = text.node().value();
-        rrule.source_selection_criteria.sse_kms_encrypted_objects_status =
-            (value == "Enabled");
-      }
-    }
+  return GetBucketReplicationResponse(state.config);
+}
 
-    if (rule.node().select_node("DeleteReplication")) {
-      text = rule.node().select_node("DeleteReplication/Status/text()");
-      value = text.node().value();
-      rrule.delete_replication_status = (value == "Enabled");
-    }
+namespace {
 
-    config.rules.push_back(rrule);
-  }
+using LifecycleState = RulesState<LifecycleConfig>;
 
-  return GetBucketReplicationResponse(config);
+// ParseInteger parses text into an optional integer field.
+void ParseInteger(std::string_view text, Integer& value) {
+  int number = 0;
+  ParseNumber(text, number);
+  value = number;
 }
 
+constexpr xml::Field<LifecycleState> kLifecycleFields[] = {
+    {"Rule", nullptr,
+     [](LifecycleState& s) { s.config.rules.emplace_back(); }},
+    {"Rule/AbortIncompleteMultipartUpload/DaysAfterInitiation",
+     [](LifecycleState& s, std::string_view v) {
+       ParseInteger(
+           v, Rule(s).abort_incomplete_multipart_upload_days_after_initiation);
+     }},
+    {"Rule/Expiration/Date",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).expiration_date = ParseTime(v);
+     }},
+    {"Rule/Expiration/Days",
+     [](LifecycleState& s, std::string_view v) {
+       ParseInteger(v, Rule(s).expiration_days);
+     }},
+    {"Rule/Expiration/ExpiredObjectDeleteMarker",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).expiration_expired_object_delete_marker = ParseBool(v);
+     }},
+    {"Rule/Filter/And/Prefix",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).filter.and_operator.prefix = Prefix(std::string(v));
+     },
+     [](LifecycleState& s) {
+       Rule(s).filter.and_operator.prefix = Prefix("");
+     }},
+    {"Rule/Filter/And/Tag", nullptr, [](LifecycleState& s) { s.tag = Tag(); },
+     [](LifecycleState& s) {
+       Rule(s).filter.and_operator.tags[s.tag.key] = s.tag.value;
+     }},
+    {"Rule/Filter/And/Tag/Key",
+     [](LifecycleState& s, std::string_view v) { s.tag.key = v; }},
+    {"Rule/Filter/And/Tag/Value",
+     [](LifecycleState& s, std::string_view v) { s.tag.value = v; }},
+    {"Rule/Filter/Prefix",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).filter.prefix = Prefix(std::string(v));
+     },
+     [](LifecycleState& s) { Rule(s).filter.prefix = Prefix(""); }},
+    {"Rule/Filter/Tag/Key",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).filter.tag.key = v;
+     }},
+    {"Rule/Filter/Tag/Value",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).filter.tag.value = v;
+     }},
+    {"Rule/ID", [](LifecycleState& s, std::string_view v) { Rule(s).id = v; }},
+    {"Rule/NoncurrentVersionExpiration/NoncurrentDays",
+     [](LifecycleState& s, std::string_view v) {
+       ParseInteger(v, Rule(s).noncurrent_version_expiration_noncurrent_days);
+     }},
+    {"Rule/NoncurrentVersionTransition/NoncurrentDays",
+     [](LifecycleState& s, std::string_view v) {
+       ParseInteger(v, Rule(s).noncurrent_version_transition_noncurrent_days);
+     }},
+    {"Rule/NoncurrentVersionTransition/StorageClass",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).noncurrent_version_transition_storage_class = v;
+     }},
+    {"Rule/Status",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).status = v == "Enabled";
+     }},
+    {"Rule/Transition/Date",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).transition_date = ParseTime(v);
+     }},
+    {"Rule/Transition/Days",
+     [](LifecycleState& s, std::string_view v) {
+       ParseInteger(v, Rule(s).transition_days);
+     }},
+    {"Rule/Transition/StorageClass",
+     [](LifecycleState& s, std::string_view v) {
+       Rule(s).transition_storage_class = v;
+     }},
+};
+
+}  // namespace
+
 Result<GetBucketLifecycleResponse> GetBucketLifecycleResponse::ParseXML(
     std::string_view data) {
-  LifecycleConfig config;
+  LifecycleState state;
 
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetBucketLifecycleResponse>("unable to parse XML");
+  if (error::Error err = xml::Decode(data, "LifecycleConfiguration",
+                                     kLifecycleFields, state)) {
+    return tl::make_unexpected(err);
   }
-  auto root = xdoc.select_node("/LifecycleConfiguration");
-
-  pugi::xpath_node text;
-  std::string value;
-
-  auto rules = root.node().select_nodes("Rule");
-  for (auto& rule : rules) {
-    LifecycleRule lrule;
-
-    if (rule.node().select_node("AbortIncompleteMultipartUpload")) {
-      text = rule.node().select_node(
-          "AbortIncompleteMultipartUpload/DaysAfterInitiation/text()");
-      value = text.node().value();
-      lrule.abort_incomplete_multipart_upload_days_after_initiation =
-          std::stoi(value);
-    }
-
-    if (rule.node().select_node("Expiration")) {
-      if (rule.node().select_node("Expiration/Date")) {
-        text = rule.node().select_node("Expiration/Date/text()");
-        lrule.expiration_date =
-            utils::UtcTime::FromISO8601UTC(text.node().value());
-      }
-
-      if (rule.node().select_node("Expiration/Days")) {
-        text = rule.node().select_node("Expiration/Days/text()");
-        value = text.node().value();
-        lrule.expiration_days = std::stoi(value);
-      }
-
-      if (rule.node().select_node("Expiration/ExpiredObjectDeleteMarker")) {
-        text = rule.node().select_node(
-            "Expiration/ExpiredObjectDeleteMarker/text()");
-        lrule.expiration_expired_object_delete_marker =
-            utils::BoolToString(text.node().value());
-      }
-    }
-
-    auto filter = rule.node().select_node("Filter");
-    if (filter.node().select_node("And")) {
-      if (filter.node().select_node("And/Prefix")) {
-        text = filter.node().select_node("And/Prefix/text()");
-        lrule.filter.and_operator.prefix = Prefix(text.node().value());
-      }
-
-      if (filter.node().select_node("And/Tag")) {
-        auto tags = root.node().select_nodes("And/Tag");
-        for (auto& tag : tags) {
-          (void)tag;
-          text = filter.node().select_node("Key/text()");
-          std::string key = text.node().value();
-
-          text = filter.node().select_node("Value/text()");
-          std::string value = text.node().value();
-
-          lrule.filter.and_operator.tags[key] = value;
-        }
-      }
-    }
-    if (filter.node().select_node("Prefix")) {
-      text = filter.node().select_node("Prefix/text()");
-      lrule.filter.prefix = Prefix(text.node().value());
-    }
-    if (filter.node().select_node("Tag")) {
-      text = filter.node().select_node("Tag/Key/text()");
-      lrule.filter.tag.key = text.node().value();
-
-      text = filter.node().select_node("Tag/Value/text()");
-      lrule.filter.tag.value = text.node().value();
-    }
-
-    text = rule.node().select_node("ID/text()");
-    lrule.id = text.node().value();
-
-    if (rule.node().select_node("NoncurrentVersionExpiration")) {
-      text = rule.node().select_node(
-          "NoncurrentVersionExpiration/NoncurrentDays/text()");
-      value = text.node().value();
-      lrule.noncurrent_version_expiration_noncurrent_days = std::stoi(value);
-    }
-
-    if (rule.node().select_node("NoncurrentVersionTransition")) {
-      text = rule.node().select_node(
-          "NoncurrentVersionTransition/NoncurrentDays/text()");
-      value = text.node().value();
-      lrule.noncurrent_version_transition_noncurrent_days = std::stoi(value);
-
-      text = rule.node().select_node(
-          "NoncurrentVersionTransition/StorageClass/text()");
-      lrule.noncurrent_version_transition_storage_class = text.node().value();
-    }
 
-    text = rule.node().select_node("Status/text()");
-    value = text.node().value();
-    lrule.status = (value == "Enabled");
-
-    if (rule.node().select_node("Transition")) {
-      if (rule.node().select_node("Transition/Date")) {
-        text = rule.node().select_node("Transition/Date/text()");
-        lrule.transition_date =
-            utils::UtcTime::FromISO8601UTC(text.node().value());
-      }
+  return GetBucketLifecycleResponse(state.config);
+}
 
-      if (rule.node().select_node("Transition/Days")) {
-        text = rule.node().select_node("Transition/Days/text()");
-        value = text.node().value();
-        lrule.transition_days = std::stoi(value);
-      }
+namespace {
 
-      text = rule.node().select_node("Transition/StorageClass/text()");
-      lrule.transition_storage_class = text.node().value();
-    }
+// TagsState is a tag set being read and its open tag.
+struct TagsState {
+  std::map<std::string, std::string> tags;
+  Tag tag;
+};  // struct TagsState
 
-    config.rules.push_back(lrule);
-  }
+constexpr xml::Field<TagsState> kTaggingFields[] = {
+    {"TagSet/Tag", nullptr, [](TagsState& s) { s.tag = Tag(); },
+     [](TagsState& s) { s.tags[s.tag.key] = s.tag.value; }},
+    {"TagSet/Tag/Key",
+     [](TagsState& s, std::string_view v) { s.tag.key = v; }},
+    {"TagSet/Tag/Value",
+     [](TagsState& s, std::string_view v) { s.tag.value = v; }},
+};
 
-  return GetBucketLifecycleResponse(config);
-}
+}  // namespace
 
 Result<GetBucketTagsResponse> GetBucketTagsResponse::ParseXML(
     std::string_view data) {
-  std::map<std::string, std::string> map;
-
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetBucketTagsResponse>("unable to parse XML");
-  }
-  auto tags = xdoc.select_nodes("/Tagging/TagSet/Tag");
-
-  pugi::xpath_node text;
+  TagsState state;
 
-  for (auto& tag : tags) {
-    text = tag.node().select_node("Key/text()");
-    std::string key = text.node().value();
-
-    text = tag.node().select_node("Value/text()");
-    std::string value = text.node().value();
-
-    map[key] = value;
+  if (error::Error err = xml::Decode(data, "Tagging", kTaggingFields, state)) {
+    return tl::make_unexpected(err);
   }
 
-  return map;
+  return std::move(state.tags);
 }
 
 Result<GetObjectTagsResponse> GetObjectTagsResponse::ParseXML(
     std::string_view data) {
-  std::map<std::string, std::string> map;
-
-  pugi::xml_document xdoc;
-  pugi::xml_parse_result result = xdoc.load_buffer(data.data(), data.size());
-  if (!result) {
-    return error::make<GetObjectTagsResponse>("unable to parse XML");
-  }
-  auto tags = xdoc.select_nodes("/Tagging/TagSet/Tag");
-
-  pugi::xpath_node text;
-
-  for (auto& tag : tags) {
-    text = tag.node().select_node("Key/text()");
-    std::string key = text.node().value();
-
-    text = tag.node().select_node("Value/text()");
-    std::string value = text.node().value();
+  TagsState state;
 
-    map[key] = value;
+  if (error::Error err = xml::Decode(data, "Tagging", kTaggingFields, state)) {
+    return tl::make_unexpected(err);
   }
 
-  return map;
+  return std::move(state.tags);
 }
 
 }  // namespace minio::s3
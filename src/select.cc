@@ -17,17 +17,52 @@
 
 #include "miniocpp/select.h"
 
+#include <charconv>
 #include <map>
-#include <pugixml.hpp>
+#include <optional>
 #include <string>
+#include <string_view>
 
 #include "miniocpp/error.h"
 #include "miniocpp/http.h"
 #include "miniocpp/types.h"
 #include "miniocpp/utils.h"
+#include "miniocpp/xml.h"
 
 namespace minio::s3 {
 
+namespace {
+
+// SelectStats holds the counters of a Progress or Stats event.
+struct SelectStats {
+  std::optional<long long> bytes_scanned;
+  std::optional<long long> bytes_processed;
+  std::optional<long long> bytes_returned;
+};  // struct SelectStats
+
+long long ParseCount(std::string_view text) {
+  long long value = 0;
+  std::from_chars(text.data(), text.data() + text.size(), value);
+  return value;
+}
+
+constexpr xml::Field<SelectStats> kSelectStatsFields[] = {
+    {"BytesScanned",
+     [](SelectStats& s, std::string_view v) {
+       s.bytes_scanned = ParseCount(v);
+     }},
+    {"BytesProcessed",
+     [](SelectStats& s, std::string_view v) {
+       s.bytes_processed = ParseCount(v);
+     }},
+    {"BytesReturned",
+     [](SelectStats& s, std::string_view v) {
+       s.bytes_returned = ParseCount(v);
+     }},
+};
+
+}  // namespace
+
 void SelectHandler::Reset() {
   prelude_.clear();
   prelude_read_ = false;
@@ -181,38 +216,17 @@ bool SelectHandler::process(const http::DataFunctionArgs& /* args */,
 
   if (headers[":event-type"] == "Progress" ||
       headers[":event-type"] == "Stats") {
-    pugi::xml_document xdoc;
-    pugi::xml_parse_result result = xdoc.load_string(payload.data());
-    if (!result) {
+    SelectStats stats;
+    if (xml::Decode(payload, headers[":event-type"], kSelectStatsFields,
+                    stats)) {
       done_ = true;
       result_func_(
           SelectResult(error::Error("unable to parse XML; " + payload)));
       return false;
     }
 
-    std::string xpath;
-    xpath = "/" + headers[":event-type"];
-    auto root = xdoc.select_node(xpath.c_str());
-    pugi::xpath_node text;
-    std::string value;
-    std::optional<long long> bytes_scanned;
-    std::optional<long long> bytes_processed;
-    std::optional<long long> bytes_returned;
-
-    text = root.node().select_node("BytesScanned/text()");
-    value = text.node().value();
-    if (!value.empty()) bytes_scanned = std::stoll(value);
-
-    text = root.node().select_node("BytesProcessed/text()");
-    value = text.node().value();
-    if (!value.empty()) bytes_processed = std::stoll(value);
-
-    text = root.node().select_node("BytesReturned/text()");
-    value = text.node().value();
-    if (!value.empty()) bytes_returned = std::stoll(value);
-
-    cont = result_func_(
-        SelectResult(bytes_scanned, bytes_processed, bytes_returned));
+    cont = result_func_(SelectResult(stats.bytes_scanned, stats.bytes_processed,
+                                     stats.bytes_returned));
     Reset();
     done_ = !cont;
     return cont;
@@ -234,7 +248,7 @@ bool SelectHandler::process(const http::DataFunctionArgs& /* args */,
 bool SelectHandler::DataFunction(const http::DataFunctionArgs& args) {
   if (done_) return false;
 
-  response_ += args.datachunk;
+  response_ += args.Chunk();
 
   while (true) {
     bool cont = false;
@@ -22,6 +22,7 @@
 
 #include <array>
 #include <charconv>
+#include <cstddef>
 #include <cstdio>
 #include <string>
 #include <type_traits>
@@ -74,13 +75,57 @@ std::string HmacHash(std::string_view key, std::string_view data) {
   return std::string{reinterpret_cast<char const*>(hash.data()), hash_len};
 }
 
+namespace {
+
+// SigningKeyEntry is a derived signing key and the inputs it was derived from.
+struct SigningKeyEntry {
+  std::string secret_key;
+  std::string date;
+  std::string region;
+  std::string service_name;
+  std::string signing_key;
+};
+
+// Signing keys change once per UTC day per region/service, so each thread
+// keeps the few it used last; lookups need no synchronization. An entry of an
+// older date or a rotated secret key never matches and is overwritten in
+// round-robin order.
+constexpr std::size_t kSigningKeyCacheSize = 4;
+
+struct SigningKeyCache {
+  std::array<SigningKeyEntry, kSigningKeyCacheSize> entries;
+  std::size_t next = 0;
+};
+
+}  // namespace
+
 std::string GetSigningKey(const std::string& secret_key,
                           const utils::UtcTime& date, std::string_view region,
                           std::string_view service_name) {
-  std::string date_key = HmacHash("AWS4" + secret_key, date.ToSignerDate());
+  thread_local SigningKeyCache cache;
+
+  std::string signer_date = date.ToSignerDate();
+  for (const auto& entry : cache.entries) {
+    if (!entry.signing_key.empty() && entry.date == signer_date &&
+        entry.region == region && entry.service_name == service_name &&
+        entry.secret_key == secret_key) {
+      return entry.signing_key;
+    }
+  }
+
+  std::string date_key = HmacHash("AWS4" + secret_key, signer_date);
   std::string date_region_key = HmacHash(date_key, region);
   std::string date_region_service_key = HmacHash(date_region_key, service_name);
-  return HmacHash(date_region_service_key, "aws4_request");
+  std::string signing_key = HmacHash(date_region_service_key, "aws4_request");
+
+  SigningKeyEntry& entry = cache.entries[cache.next];
+  cache.next = (cache.next + 1) % kSigningKeyCacheSize;
+  entry.secret_key = secret_key;
+  entry.date = std::move(signer_date);
+  entry.region = std::string(region);
+  entry.service_name = std::string(service_name);
+  entry.signing_key = signing_key;
+  return signing_key;
 }
 
 std::string GetSignature(std::string_view signing_key,
@@ -109,25 +154,38 @@ std::string GetAuthorization(const std::string& access_key,
          "SignedHeaders=" + signed_headers + ", " + "Signature=" + signature;
 }
 
-utils::Multimap SignV4(const std::string& service_name, http::Method method,
-                       const std::string& uri, const std::string& region,
-                       utils::Multimap& headers, utils::Multimap query_params,
-                       const std::string& access_key,
-                       const std::string& secret_key,
-                       const std::string& content_sha256,
-                       const utils::UtcTime& date) {
+utils::Multimap& SignV4(const std::string& service_name, http::Method method,
+                        const std::string& uri, const std::string& region,
+                        utils::Multimap& headers,
+                        const utils::Multimap& query_params,
+                        const std::string& access_key,
+                        const std::string& secret_key,
+                        const std::string& content_sha256,
+                        const utils::UtcTime& date, std::string* signature) {
+  // Canonicalization writes into per-thread buffers reused across requests.
+  thread_local std::string signed_headers;
+  thread_local std::string canonical_headers;
+  thread_local std::string canonical_request;
+  signed_headers.clear();
+  canonical_headers.clear();
+  canonical_request.clear();
+
   std::string scope = GetScope(date, region, service_name);
 
-  std::string signed_headers;
-  std::string canonical_headers;
+  // See GetCanonicalRequestHash() for the layout.
   headers.GetCanonicalHeaders(signed_headers, canonical_headers);
-
-  std::string canonical_query_string = query_params.GetCanonicalQueryString();
-
-  std::string methodstring = http::MethodToString(method);
-  std::string canonical_request_hash = GetCanonicalRequestHash(
-      methodstring, uri, canonical_query_string, canonical_headers,
-      signed_headers, content_sha256);
+  canonical_request += http::MethodToString(method);
+  canonical_request += '\n';
+  canonical_request += uri;
+  canonical_request += '\n';
+  query_params.GetCanonicalQueryString(canonical_request);
+  canonical_request += '\n';
+  canonical_request += canonical_headers;
+  canonical_request += "\n\n";
+  canonical_request += signed_headers;
+  canonical_request += '\n';
+  canonical_request += content_sha256;
+  std::string canonical_request_hash = utils::Sha256Hash(canonical_request);
 
   std::string string_to_sign =
       GetStringToSign(date, scope, canonical_request_hash);
@@ -135,39 +193,38 @@ utils::Multimap SignV4(const std::string& service_name, http::Method method,
   std::string signing_key =
       GetSigningKey(secret_key, date, region, service_name);
 
-  std::string signature = GetSignature(signing_key, string_to_sign);
+  std::string request_signature = GetSignature(signing_key, string_to_sign);
 
   std::string authorization =
-      GetAuthorization(access_key, scope, signed_headers, signature);
+      GetAuthorization(access_key, scope, signed_headers, request_signature);
 
   headers.Add("Authorization", authorization);
+  if (signature != nullptr) *signature = std::move(request_signature);
   return headers;
 }
 
-utils::Multimap SignV4S3(http::Method method, const std::string& uri,
-                         const std::string& region, utils::Multimap& headers,
-                         utils::Multimap query_params,
-                         const std::string& access_key,
-                         const std::string& secret_key,
-                         const std::string& content_sha256,
-                         const utils::UtcTime& date) {
-  std::string service_name = "s3";
-  return SignV4(service_name, method, uri, region, headers,
-                std::move(query_params), access_key, secret_key, content_sha256,
-                date);
-}
-
-utils::Multimap SignV4STS(http::Method method, const std::string& uri,
+utils::Multimap& SignV4S3(http::Method method, const std::string& uri,
                           const std::string& region, utils::Multimap& headers,
-                          utils::Multimap query_params,
+                          const utils::Multimap& query_params,
                           const std::string& access_key,
                           const std::string& secret_key,
                           const std::string& content_sha256,
-                          const utils::UtcTime& date) {
+                          const utils::UtcTime& date, std::string* signature) {
+  std::string service_name = "s3";
+  return SignV4(service_name, method, uri, region, headers, query_params,
+                access_key, secret_key, content_sha256, date, signature);
+}
+
+utils::Multimap& SignV4STS(http::Method method, const std::string& uri,
+                           const std::string& region, utils::Multimap& headers,
+                           const utils::Multimap& query_params,
+                           const std::string& access_key,
+                           const std::string& secret_key,
+                           const std::string& content_sha256,
+                           const utils::UtcTime& date) {
   std::string service_name = "sts";
-  return SignV4(service_name, method, uri, region, headers,
-                std::move(query_params), access_key, secret_key, content_sha256,
-                date);
+  return SignV4(service_name, method, uri, region, headers, query_params,
+                access_key, secret_key, content_sha256, date);
 }
 
 utils::Multimap PresignV4(http::Method method, const std::string& host,
@@ -202,6 +259,111 @@ utils::Multimap PresignV4(http::Method method, const std::string& host,
   return query_params;
 }
 
+Presigner::Presigner(const std::string& host, const std::string& region,
+                     const utils::Multimap& query_params,
+                     const std::string& access_key,
+                     const std::string& secret_key, const utils::UtcTime& date,
+                     unsigned int expires)
+    : host_(host) {
+  std::string service_name = "s3";
+  std::string scope = GetScope(date, region, service_name);
+
+  utils::Multimap params = query_params;
+  params.Add("X-Amz-Algorithm", "AWS4-HMAC-SHA256");
+  params.Add("X-Amz-Credential", access_key + "/" + scope);
+  params.Add("X-Amz-Date", date.ToAmzDate());
+  params.Add("X-Amz-Expires", std::to_string(expires));
+  params.Add("X-Amz-SignedHeaders", "host");
+
+  // Split the canonical query string where a per-URL versionId sorts in, as
+  // Multimap orders parameters by their unencoded key.
+  std::string canonical_query_string = params.GetCanonicalQueryString();
+  size_t start = 0;
+  while (start < canonical_query_string.size()) {
+    size_t end = canonical_query_string.find('&', start);
+    if (end == std::string::npos) end = canonical_query_string.size();
+    std::string param = canonical_query_string.substr(start, end - start);
+    std::string key = utils::UriDecode(param.substr(0, param.find('=')));
+    std::string& query =
+        (key <= "versionId") ? query_before_version_ : query_after_version_;
+    if (!query.empty()) query += '&';
+    query += param;
+    start = end + 1;
+  }
+
+  string_to_sign_prefix_ =
+      "AWS4-HMAC-SHA256\n" + date.ToAmzDate() + "\n" + scope + "\n";
+  signing_key_ = GetSigningKey(secret_key, date, region, service_name);
+}
+
+void Presigner::Sign(http::Method method, const std::string& uri,
+                     const std::string& version_id,
+                     std::string& query_string) {
+  query_string.assign(query_before_version_);
+  if (!version_id.empty()) {
+    if (!query_string.empty()) query_string += '&';
+    query_string += "versionId=";
+    query_string += utils::UriEncode(version_id);
+  }
+  if (!query_after_version_.empty()) {
+    if (!query_string.empty()) query_string += '&';
+    query_string += query_after_version_;
+  }
+
+  // See GetCanonicalRequestHash(); presigned URLs sign only the host header.
+  buffer_.assign(http::MethodToString(method));
+  buffer_ += '\n';
+  buffer_ += uri;
+  buffer_ += '\n';
+  buffer_ += query_string;
+  buffer_ += "\nhost:";
+  buffer_ += host_;
+  buffer_ += "\n\nhost\nUNSIGNED-PAYLOAD";
+  std::string canonical_request_hash = utils::Sha256Hash(buffer_);
+
+  buffer_.assign(string_to_sign_prefix_);
+  buffer_ += canonical_request_hash;
+
+  query_string += "&X-Amz-Signature=";
+  query_string += GetSignature(signing_key_, buffer_);
+}
+
+ChunkSigner::ChunkSigner(const std::string& secret_key,
+                         const utils::UtcTime& date, const std::string& region,
+                         std::string seed_signature)
+    : signing_key_(GetSigningKey(secret_key, date, region, "s3")),
+      date_scope_(date.ToAmzDate() + "\n" + GetScope(date, region, "s3") +
+                  "\n"),
+      previous_(std::move(seed_signature)) {}
+
+const std::string& ChunkSigner::Sign(std::string_view chunk) {
+  return SignHash(utils::Sha256Hash(chunk));
+}
+
+const std::string& ChunkSigner::SignHash(std::string_view chunk_sha256) {
+  // StringToSign =
+  //   "AWS4-HMAC-SHA256-PAYLOAD" + '\n' + AmzDate + '\n' + Scope + '\n' +
+  //   PreviousSignature + '\n' + Hash("") + '\n' + Hash(ChunkData)
+  buffer_ = "AWS4-HMAC-SHA256-PAYLOAD\n";
+  buffer_ += date_scope_;
+  buffer_ += previous_;
+  buffer_ +=
+      "\ne3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\n";
+  buffer_ += chunk_sha256;
+  previous_ = GetSignature(signing_key_, buffer_);
+  return previous_;
+}
+
+const std::string& ChunkSigner::SignTrailer(std::string_view trailer) {
+  buffer_ = "AWS4-HMAC-SHA256-TRAILER\n";
+  buffer_ += date_scope_;
+  buffer_ += previous_;
+  buffer_ += '\n';
+  buffer_ += utils::Sha256Hash(trailer);
+  previous_ = GetSignature(signing_key_, buffer_);
+  return previous_;
+}
+
 std::string PostPresignV4(const std::string& string_to_sign,
                           const std::string& secret_key,
                           const utils::UtcTime& date,
@@ -0,0 +1,225 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "miniocpp/statcache.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "miniocpp/response.h"
+
+namespace minio::s3 {
+
+struct StatCache::Impl {
+  using Clock = std::chrono::steady_clock;
+  // Bucket, object and version ID; all versions of an object are adjacent.
+  using Key = std::tuple<std::string, std::string, std::string>;
+  // Bucket and object.
+  using Object = std::pair<std::string, std::string>;
+
+  // Objects invalidated more recently than this many are forgotten, and a
+  // response looked up before the oldest of them is not stored.
+  static constexpr size_t kMaxInvalidated = 4096;
+
+  struct Entry {
+    Key key;
+    StatObjectResponse resp;
+    Clock::time_point fetched;  // When the server last confirmed resp.
+  };
+
+  mutable std::mutex mutex;
+  size_t max_entries;
+  std::chrono::seconds ttl;
+  bool revalidate = true;
+  std::list<Entry> lru;  // Most recently used first.
+  std::map<Key, std::list<Entry>::iterator> entries;
+  // Bumped by every invalidation. The generation of the last invalidation of
+  // an object is kept, so a response fetched before it is not stored after
+  // it, while the lookups of other objects are unaffected. Lookups older than
+  // floor, e.g. than a Clear(), are not stored at all.
+  uint64_t generation = 0;
+  uint64_t floor = 0;
+  std::map<Object, uint64_t> invalidated;
+  std::map<uint64_t, Object> invalidations;  // By generation; oldest first.
+  StatCacheStats stats;
+
+  Impl(size_t max_entries, std::chrono::seconds ttl)
+      : max_entries(max_entries), ttl(ttl) {}
+
+  // Trim drops the least recently used entries beyond max_entries. Caller
+  // must hold mutex.
+  void Trim() {
+    while (lru.size() > max_entries) {
+      entries.erase(lru.back().key);
+      lru.pop_back();
+      stats.evictions++;
+    }
+  }
+
+  // Stale tells whether object was invalidated after a lookup at generation
+  // g. Caller must hold mutex.
+  bool Stale(const std::string& bucket, const std::string& object,
+             uint64_t g) const {
+    if (g < floor) return true;
+    auto itr = invalidated.find(Object(bucket, object));
+    return itr != invalidated.end() && itr->second > g;
+  }
+
+  // Erase drops the entry at itr. Caller must hold mutex.
+  void Erase(std::map<Key, std::list<Entry>::iterator>::iterator itr) {
+    lru.erase(itr->second);
+    entries.erase(itr);
+  }
+};  // struct StatCache::Impl
+
+StatCache::StatCache(size_t max_entries, std::chrono::seconds ttl)
+    : impl_(std::make_unique<Impl>(max_entries, ttl)) {}
+
+StatCache::~StatCache() = default;
+
+void StatCache::SetMaxEntries(size_t max_entries) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->max_entries = max_entries;
+  impl_->Trim();
+}
+
+void StatCache::SetTtl(std::chrono::seconds ttl) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->ttl = ttl;
+}
+
+void StatCache::SetRevalidate(bool revalidate) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->revalidate = revalidate;
+}
+
+void StatCache::Invalidate(const std::string& bucket,
+                           const std::string& object) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  uint64_t generation = ++impl_->generation;
+  impl_->stats.invalidations++;
+  auto [last, inserted] =
+      impl_->invalidated.try_emplace(Impl::Object(bucket, object), generation);
+  if (!inserted) {
+    impl_->invalidations.erase(last->second);
+    last->second = generation;
+  }
+  impl_->invalidations.emplace(generation, last->first);
+  if (impl_->invalidations.size() > Impl::kMaxInvalidated) {
+    auto oldest = impl_->invalidations.begin();
+    impl_->floor = oldest->first;
+    impl_->invalidated.erase(oldest->second);
+    impl_->invalidations.erase(oldest);
+  }
+
+  auto itr = impl_->entries.lower_bound(Impl::Key(bucket, object, ""));
+  while (itr != impl_->entries.end() && std::get<0>(itr->first) == bucket &&
+         std::get<1>(itr->first) == object) {
+    impl_->Erase(itr++);
+  }
+}
+
+void StatCache::Clear() {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->floor = ++impl_->generation;
+  impl_->invalidated.clear();
+  impl_->invalidations.clear();
+  impl_->entries.clear();
+  impl_->lru.clear();
+}
+
+StatCacheStats StatCache::Stats() const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  StatCacheStats stats = impl_->stats;
+  stats.entries = impl_->lru.size();
+  return stats;
+}
+
+StatCache::Lookup StatCache::Find(const std::string& bucket,
+                                  const std::string& object,
+                                  const std::string& version_id,
+                                  StatObjectResponse& resp,
+                                  uint64_t& generation) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  generation = impl_->generation;
+  auto itr = impl_->entries.find(Impl::Key(bucket, object, version_id));
+  if (itr == impl_->entries.end()) {
+    impl_->stats.misses++;
+    return Lookup::kMiss;
+  }
+
+  Impl::Entry& entry = *itr->second;
+  if (Impl::Clock::now() - entry.fetched >= impl_->ttl) {
+    if (!impl_->revalidate) {
+      impl_->Erase(itr);
+      impl_->stats.misses++;
+      return Lookup::kMiss;
+    }
+    impl_->stats.revalidations++;
+    resp = entry.resp;
+    return Lookup::kStale;
+  }
+
+  impl_->lru.splice(impl_->lru.begin(), impl_->lru, itr->second);
+  impl_->stats.hits++;
+  resp = entry.resp;
+  return Lookup::kHit;
+}
+
+void StatCache::Store(const std::string& bucket, const std::string& object,
+                      const std::string& version_id,
+                      const StatObjectResponse& resp, uint64_t generation) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  if (impl_->Stale(bucket, object, generation) || impl_->max_entries == 0) {
+    return;
+  }
+
+  Impl::Key key(bucket, object, version_id);
+  auto fetched = Impl::Clock::now();
+  auto itr = impl_->entries.find(key);
+  if (itr != impl_->entries.end()) {
+    itr->second->resp = resp;
+    itr->second->fetched = fetched;
+    impl_->lru.splice(impl_->lru.begin(), impl_->lru, itr->second);
+    return;
+  }
+  impl_->lru.push_front(Impl::Entry{key, resp, fetched});
+  impl_->entries.emplace(std::move(key), impl_->lru.begin());
+  impl_->Trim();
+}
+
+void StatCache::Refresh(const std::string& bucket, const std::string& object,
+                        const std::string& version_id, uint64_t generation) {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->stats.not_modified++;
+  if (impl_->Stale(bucket, object, generation)) return;
+
+  auto itr = impl_->entries.find(Impl::Key(bucket, object, version_id));
+  if (itr == impl_->entries.end()) return;
+  itr->second->fetched = Impl::Clock::now();
+  impl_->lru.splice(impl_->lru.begin(), impl_->lru, itr->second);
+}
+
+}  // namespace minio::s3
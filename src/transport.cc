@@ -0,0 +1,1297 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "miniocpp/http.h"
+#include "miniocpp/utils.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <openssl/x509v3.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+namespace minio::http {
+
+void Transport::Submit(Request request, Callback done) {
+  Response response = Execute(request);
+  done(std::move(response));
+}
+
+#ifdef __linux__
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Same limits as the cpp-httplib transport: its default connect timeout, and
+// the stall guard that aborts a transfer making no progress.
+constexpr auto kConnectTimeout = std::chrono::seconds(300);
+constexpr auto kStallTimeout = std::chrono::seconds(60);
+constexpr auto kIdleTimeout = std::chrono::seconds(30);
+constexpr auto kDnsTtl = std::chrono::seconds(30);
+constexpr size_t kMaxIdlePerHost = 16;
+constexpr size_t kReadSize = 64 * 1024;
+constexpr size_t kTlsRecordSize = 16 * 1024;
+constexpr size_t kMaxHeaderSize = 64 * 1024;
+constexpr size_t kBodyChunkSize = 64 * 1024;
+// Reads per readiness event, so one busy connection cannot starve the rest.
+constexpr int kReadsPerEvent = 16;
+
+// Connection is one TCP connection, with its TLS state for https. OpenSSL
+// never touches the socket: it reads ciphertext from rbio and writes it to
+// wbio, and the loop moves bytes between the BIOs and the socket.
+struct Connection {
+  int fd = -1;
+  SSL* ssl = nullptr;
+  BIO* rbio = nullptr;
+  BIO* wbio = nullptr;
+  std::string pending;  // Ciphertext the socket has not accepted yet.
+  size_t pending_off = 0;
+  Clock::time_point idle_since;
+
+  Connection() = default;
+  ~Connection() {
+    if (ssl != nullptr) SSL_free(ssl);  // Frees both BIOs.
+    if (fd >= 0) close(fd);
+  }
+
+  Connection(const Connection&) = delete;
+  Connection& operator=(const Connection&) = delete;
+};  // struct Connection
+
+// Exchange is one request/response on a connection.
+struct Exchange {
+  enum class State { kConnect, kHandshake, kSend, kReceive };
+  enum class BodyMode { kNone, kLength, kChunked, kClose };
+  enum class ChunkState { kSize, kData, kDataEnd, kTrailer };
+
+  Request req;
+  Transport::Callback done;
+  Response response;
+
+  std::string key;  // Endpoint and TLS settings; connections are reused by it.
+  std::string host;  // Without IPv6 brackets.
+  std::unique_ptr<Connection> conn;
+  State state = State::kConnect;
+  bool reused = false;
+  bool retried = false;
+  bool finished = false;
+  std::vector<sockaddr_storage> addrs;
+  std::vector<socklen_t> addr_lens;
+  size_t addr_index = 0;
+
+  std::string head;  // Serialized request line and headers.
+  size_t head_off = 0;
+  size_t body_off = 0;
+  std::string chunk;  // Last piece pulled from a streamed body.
+  size_t chunk_start = 0;  // Body offset of chunk.
+  bool pulled = false;
+
+  std::string in;  // Plaintext received but not parsed yet.
+  bool head_done = false;
+  bool received_any = false;
+  BodyMode body_mode = BodyMode::kNone;
+  ChunkState chunk_state = ChunkState::kSize;
+  size_t remaining = 0;
+  size_t body_total = 0;
+  size_t body_received = 0;
+  bool stream = false;
+  bool keep_alive = true;
+  bool canceled = false;
+  bool overflow = false;
+
+  Clock::time_point start;
+  Clock::time_point last_activity;
+  Clock::time_point deadline = Clock::time_point::max();
+
+  Exchange(Request req, Transport::Callback done)
+      : req(std::move(req)), done(std::move(done)) {}
+};  // struct Exchange
+
+struct DnsEntry {
+  std::vector<sockaddr_storage> addrs;
+  std::vector<socklen_t> addr_lens;
+  Clock::time_point expires;
+};  // struct DnsEntry
+
+bool IsIpAddress(const std::string& host) {
+  in6_addr addr6;
+  in_addr addr4;
+  return inet_pton(AF_INET6, host.c_str(), &addr6) == 1 ||
+         inet_pton(AF_INET, host.c_str(), &addr4) == 1;
+}
+
+std::string TlsError(SSL* ssl) {
+  long verify = SSL_get_verify_result(ssl);
+  if (verify != X509_V_OK) {
+    return std::string("SSL server verification failed: ") +
+           X509_verify_cert_error_string(verify);
+  }
+  unsigned long code = ERR_get_error();
+  ERR_clear_error();
+  if (code == 0) return "SSL connection failed";
+  char buf[256];
+  ERR_error_string_n(code, buf, sizeof(buf));
+  return std::string("SSL connection failed: ") + buf;
+}
+
+// thread_local marker of the loop running on this thread, so Execute() can
+// refuse to block the loop it would wait on.
+thread_local const void* current_loop_owner = nullptr;
+
+class Loop {
+ public:
+  explicit Loop(const void* owner) : owner_(owner) {
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    evfd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epfd_ < 0 || evfd_ < 0) {
+      int err = errno;
+      if (epfd_ >= 0) close(epfd_);
+      if (evfd_ >= 0) close(evfd_);
+      errno = err;
+      throw std::system_error(errno, std::generic_category(),
+                              "unable to create event loop");
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    epoll_ctl(epfd_, EPOLL_CTL_ADD, evfd_, &ev);
+  }
+
+  ~Loop() {
+    for (auto& [key, ctx] : contexts_) SSL_CTX_free(ctx);
+    for (auto& [key, session] : sessions_) SSL_SESSION_free(session);
+    if (evfd_ >= 0) close(evfd_);
+    if (epfd_ >= 0) close(epfd_);
+  }
+
+  Loop(const Loop&) = delete;
+  Loop& operator=(const Loop&) = delete;
+
+  void Post(std::unique_ptr<Exchange> x) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      incoming_.push_back(std::move(x));
+    }
+    Wake();
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    Wake();
+  }
+
+  void Run();
+
+ private:
+  const void* owner_;
+  int epfd_ = -1;
+  int evfd_ = -1;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Exchange>> incoming_;
+  bool stop_ = false;
+
+  std::unordered_map<Exchange*, std::unique_ptr<Exchange>> active_;
+  std::vector<Exchange*> finished_;
+  std::map<std::string, std::vector<std::unique_ptr<Connection>>> idle_;
+  std::map<std::string, SSL_CTX*> contexts_;
+  std::map<std::string, SSL_SESSION*> sessions_;
+  std::map<std::string, DnsEntry> dns_;
+  Clock::time_point last_sweep_ = Clock::now();
+
+  void Wake() {
+    uint64_t one = 1;
+    ssize_t n = write(evfd_, &one, sizeof(one));
+    (void)n;
+  }
+
+  void Start(std::unique_ptr<Exchange> owned);
+  void Connect(Exchange& x);
+  void OnConnected(Exchange& x);
+  void Handshake(Exchange& x);
+  void Send(Exchange& x);
+  bool NextBody(Exchange& x, const char*& data, size_t& length);
+  void OnReadable(Exchange& x);
+  void Consume(Exchange& x, const char* data, size_t length);
+  bool ParseHead(Exchange& x);
+  void Body(Exchange& x, const char* data, size_t length);
+  bool Deliver(Exchange& x, const char* data, size_t length);
+  void Complete(Exchange& x);
+  void Fail(Exchange& x, std::string error);
+  void Finish(Exchange& x);
+  void OnEof(Exchange& x);
+
+  bool Resolve(Exchange& x, std::string& error);
+  SSL_CTX* Context(const Request& req, std::string& error);
+  int FlushTls(Connection& c);
+  void Watch(Exchange& x, bool write, bool add);
+  void Unwatch(Connection& c);
+  void Sweep(Clock::time_point now);
+};  // class Loop
+
+void Loop::Run() {
+  current_loop_owner = owner_;
+  std::vector<epoll_event> events(256);
+  while (true) {
+    std::vector<std::unique_ptr<Exchange>> incoming;
+    bool stop = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      incoming.swap(incoming_);
+      stop = stop_;
+    }
+    if (stop) {
+      for (auto& x : incoming) active_.emplace(x.get(), std::move(x));
+      std::vector<Exchange*> all;
+      for (auto& [ptr, x] : active_) all.push_back(ptr);
+      for (Exchange* x : all) Fail(*x, "transport shut down");
+      active_.clear();
+      idle_.clear();
+      return;
+    }
+    for (auto& x : incoming) Start(std::move(x));
+    for (Exchange* x : finished_) active_.erase(x);
+    finished_.clear();
+
+    int n = epoll_wait(epfd_, events.data(), static_cast<int>(events.size()),
+                       1000);
+    for (int i = 0; i < n; i++) {
+      auto* x = static_cast<Exchange*>(events[i].data.ptr);
+      if (x == nullptr) {
+        uint64_t count;
+        ssize_t r = read(evfd_, &count, sizeof(count));
+        (void)r;
+        continue;
+      }
+      if (x->finished) continue;
+      const uint32_t ev = events[i].events;
+      if (x->state == Exchange::State::kConnect) {
+        if (ev & (EPOLLOUT | EPOLLERR | EPOLLHUP)) OnConnected(*x);
+        continue;
+      }
+      if (ev & (EPOLLIN | EPOLLERR | EPOLLHUP)) OnReadable(*x);
+      if (!x->finished && (ev & EPOLLOUT)) {
+        if (x->state == Exchange::State::kHandshake) {
+          Handshake(*x);
+        } else {
+          Send(*x);
+        }
+      }
+    }
+    // Exchanges finished in this batch are freed only now; later events of
+    // the batch may still point at them.
+    for (Exchange* x : finished_) active_.erase(x);
+    finished_.clear();
+
+    auto now = Clock::now();
+    if (now - last_sweep_ >= std::chrono::seconds(1)) Sweep(now);
+  }
+}
+
+void Loop::Start(std::unique_ptr<Exchange> owned) {
+  Exchange& x = *owned;
+  active_.emplace(owned.get(), std::move(owned));
+
+  const Request& req = x.req;
+  x.start = x.last_activity = Clock::now();
+  if (req.timeout_secs > 0) {
+    x.deadline = x.start + std::chrono::seconds(req.timeout_secs);
+  }
+  x.response.datafunc = req.datafunc;
+  x.response.userdata = req.userdata;
+  if (req.buffer != nullptr) req.buffer->received = 0;
+
+  x.host = req.url.host;
+  if (x.host.size() > 2 && x.host.front() == '[' && x.host.back() == ']') {
+    x.host = x.host.substr(1, x.host.size() - 2);
+  }
+  std::string endpoint =
+      (req.url.https ? "https://" : "http://") + req.url.host;
+  if (req.url.port) endpoint += ":" + std::to_string(req.url.port);
+  x.key = endpoint + "\n" + req.nic_interface + "\n" + req.ssl_cert_file +
+          "\n" + req.cert_file + "\n" + req.key_file + "\n" +
+          (req.ignore_cert_check ? "1" : "0");
+
+  std::string path = req.url.path;
+  if (path.empty()) {
+    path = "/";
+  } else if (path.front() != '/') {
+    path = "/" + path;
+  }
+  if (!req.url.query_string.empty()) path += "?" + req.url.query_string;
+
+  x.head = std::string(MethodToString(req.method)) + " " + path +
+           " HTTP/1.1\r\n";
+  if (!req.headers.Contains("Host")) {
+    x.head += "host: " + req.url.HostHeaderValue() + "\r\n";
+  }
+  for (const auto& entry : req.headers) {
+    if (entry.lower_key == "content-length" || entry.lower_key == "expect") {
+      continue;
+    }
+    x.head += entry.lower_key + ": " + entry.value + "\r\n";
+  }
+  if (req.method == Method::kPut || req.method == Method::kPost ||
+      req.BodySize() > 0) {
+    x.head += "content-length: " + std::to_string(req.BodySize()) + "\r\n";
+  }
+  x.head += "\r\n";
+
+  // Reuse the most recent idle connection that the server has not closed.
+  auto itr = idle_.find(x.key);
+  while (itr != idle_.end() && !itr->second.empty()) {
+    std::unique_ptr<Connection> conn = std::move(itr->second.back());
+    itr->second.pop_back();
+    char c;
+    ssize_t r = recv(conn->fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      x.conn = std::move(conn);
+      break;
+    }
+  }
+  if (itr != idle_.end() && itr->second.empty()) idle_.erase(itr);
+
+  if (x.conn) {
+    x.reused = true;
+    x.state = Exchange::State::kSend;
+    Watch(x, true, true);
+    return;
+  }
+
+  std::string error;
+  if (!Resolve(x, error)) {
+    Fail(x, error);
+    return;
+  }
+  Connect(x);
+}
+
+bool Loop::Resolve(Exchange& x, std::string& error) {
+  const Request& req = x.req;
+  unsigned int port = req.url.port ? req.url.port : (req.url.https ? 443 : 80);
+  std::string key = x.host + ":" + std::to_string(port);
+  auto now = Clock::now();
+  auto itr = dns_.find(key);
+  if (itr == dns_.end() || itr->second.expires <= now) {
+    // getaddrinfo blocks; entries are cached so it runs once per endpoint
+    // and TTL rather than per request.
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    int rc = getaddrinfo(x.host.c_str(), std::to_string(port).c_str(), &hints,
+                         &result);
+    if (rc != 0) {
+      error = "unable to resolve " + x.host + ": " + gai_strerror(rc);
+      return false;
+    }
+    DnsEntry entry;
+    for (addrinfo* ai = result; ai != nullptr; ai = ai->ai_next) {
+      sockaddr_storage addr{};
+      std::memcpy(&addr, ai->ai_addr, ai->ai_addrlen);
+      entry.addrs.push_back(addr);
+      entry.addr_lens.push_back(ai->ai_addrlen);
+    }
+    freeaddrinfo(result);
+    entry.expires = now + kDnsTtl;
+    itr = dns_.insert_or_assign(key, std::move(entry)).first;
+  }
+  x.addrs = itr->second.addrs;
+  x.addr_lens = itr->second.addr_lens;
+  x.addr_index = 0;
+  if (x.addrs.empty()) {
+    error = "unable to resolve " + x.host;
+    return false;
+  }
+  return true;
+}
+
+void Loop::Connect(Exchange& x) {
+  const Request& req = x.req;
+  std::string error = "Could not establish connection";
+  while (x.addr_index < x.addrs.size()) {
+    const auto& addr = x.addrs[x.addr_index];
+    socklen_t len = x.addr_lens[x.addr_index];
+    x.addr_index++;
+
+    auto conn = std::make_unique<Connection>();
+    conn->fd =
+        socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (conn->fd < 0) {
+      error = std::string("unable to create socket: ") + std::strerror(errno);
+      continue;
+    }
+    int one = 1;
+    setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (!req.nic_interface.empty()) {
+      // A local IP address binds the source; anything else names a device.
+      sockaddr_storage local{};
+      socklen_t local_len = 0;
+      auto* in4 = reinterpret_cast<sockaddr_in*>(&local);
+      auto* in6 = reinterpret_cast<sockaddr_in6*>(&local);
+      if (inet_pton(AF_INET, req.nic_interface.c_str(), &in4->sin_addr) == 1) {
+        in4->sin_family = AF_INET;
+        local_len = sizeof(sockaddr_in);
+      } else if (inet_pton(AF_INET6, req.nic_interface.c_str(),
+                           &in6->sin6_addr) == 1) {
+        in6->sin6_family = AF_INET6;
+        local_len = sizeof(sockaddr_in6);
+      }
+      int rc = local_len > 0
+                   ? bind(conn->fd, reinterpret_cast<sockaddr*>(&local),
+                          local_len)
+                   : setsockopt(conn->fd, SOL_SOCKET, SO_BINDTODEVICE,
+                                req.nic_interface.c_str(),
+                                static_cast<socklen_t>(
+                                    req.nic_interface.size()));
+      if (rc != 0) {
+        error = "unable to bind to " + req.nic_interface + ": " +
+                std::strerror(errno);
+        continue;
+      }
+    }
+
+    int rc = connect(conn->fd, reinterpret_cast<const sockaddr*>(&addr), len);
+    if (rc != 0 && errno != EINPROGRESS) {
+      error = std::string("Could not establish connection: ") +
+              std::strerror(errno);
+      continue;
+    }
+    x.conn = std::move(conn);
+    x.state = Exchange::State::kConnect;
+    Watch(x, true, true);
+    return;
+  }
+  Fail(x, error);
+}
+
+void Loop::OnConnected(Exchange& x) {
+  int err = 0;
+  socklen_t len = sizeof(err);
+  getsockopt(x.conn->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+  if (err != 0) {
+    Unwatch(*x.conn);
+    x.conn.reset();
+    if (x.addr_index < x.addrs.size()) {
+      Connect(x);
+    } else {
+      Fail(x, std::string("Could not establish connection: ") +
+                  std::strerror(err));
+    }
+    return;
+  }
+  x.last_activity = Clock::now();
+
+  if (!x.req.url.https) {
+    x.state = Exchange::State::kSend;
+    Send(x);
+    return;
+  }
+
+  std::string error;
+  SSL_CTX* ctx = Context(x.req, error);
+  if (ctx == nullptr) {
+    Fail(x, error);
+    return;
+  }
+  Connection& c = *x.conn;
+  c.ssl = SSL_new(ctx);
+  c.rbio = BIO_new(BIO_s_mem());
+  c.wbio = BIO_new(BIO_s_mem());
+  if (c.ssl == nullptr || c.rbio == nullptr || c.wbio == nullptr) {
+    if (c.rbio != nullptr && c.ssl == nullptr) BIO_free(c.rbio);
+    if (c.wbio != nullptr && c.ssl == nullptr) BIO_free(c.wbio);
+    Fail(x, "unable to create SSL connection");
+    return;
+  }
+  SSL_set_bio(c.ssl, c.rbio, c.wbio);
+  SSL_set_connect_state(c.ssl);
+  const bool ip = IsIpAddress(x.host);
+  if (!ip) SSL_set_tlsext_host_name(c.ssl, x.host.c_str());
+  if (!x.req.ssl_cert_file.empty() || !x.req.ignore_cert_check) {
+    if (ip) {
+      X509_VERIFY_PARAM_set1_ip_asc(SSL_get0_param(c.ssl), x.host.c_str());
+    } else {
+      SSL_set1_host(c.ssl, x.host.c_str());
+    }
+  }
+  auto itr = sessions_.find(x.key);
+  if (itr != sessions_.end()) SSL_set_session(c.ssl, itr->second);
+
+  x.state = Exchange::State::kHandshake;
+  Handshake(x);
+}
+
+SSL_CTX* Loop::Context(const Request& req, std::string& error) {
+  std::string key = req.ssl_cert_file + "\n" + req.cert_file + "\n" +
+                    req.key_file + "\n" + (req.ignore_cert_check ? "1" : "0");
+  auto itr = contexts_.find(key);
+  if (itr != contexts_.end()) return itr->second;
+
+  SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+  if (ctx == nullptr) {
+    error = "unable to create SSL context";
+    return nullptr;
+  }
+  SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+  SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE |
+                            SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+  // An explicit CA bundle overrides IGNORE_CERT_CHECK, as in the cpp-httplib
+  // transport.
+  if (!req.ssl_cert_file.empty() || !req.ignore_cert_check) {
+    int rc = req.ssl_cert_file.empty()
+                 ? SSL_CTX_set_default_verify_paths(ctx)
+                 : SSL_CTX_load_verify_locations(
+                       ctx, req.ssl_cert_file.c_str(), nullptr);
+    if (rc != 1) {
+      SSL_CTX_free(ctx);
+      error = "unable to load CA certificates from " + req.ssl_cert_file;
+      return nullptr;
+    }
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+  } else {
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, nullptr);
+  }
+  if (!req.cert_file.empty() &&
+      (SSL_CTX_use_certificate_chain_file(ctx, req.cert_file.c_str()) != 1 ||
+       SSL_CTX_use_PrivateKey_file(ctx, req.key_file.c_str(),
+                                   SSL_FILETYPE_PEM) != 1)) {
+    SSL_CTX_free(ctx);
+    error = "unable to load client certificate " + req.cert_file;
+    return nullptr;
+  }
+  SSL_CTX_set_session_cache_mode(
+      ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  contexts_.emplace(key, ctx);
+  return ctx;
+}
+
+// FlushTls moves ciphertext from wbio to the socket. Returns 1 when all of
+// it was sent, 0 when the socket is full and -1 on error.
+int Loop::FlushTls(Connection& c) {
+  char buf[kTlsRecordSize];
+  int n;
+  while ((n = BIO_read(c.wbio, buf, sizeof(buf))) > 0) {
+    c.pending.append(buf, static_cast<size_t>(n));
+  }
+  while (c.pending_off < c.pending.size()) {
+    ssize_t sent = send(c.fd, c.pending.data() + c.pending_off,
+                        c.pending.size() - c.pending_off, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    c.pending_off += static_cast<size_t>(sent);
+  }
+  c.pending.clear();
+  c.pending_off = 0;
+  return 1;
+}
+
+void Loop::Handshake(Exchange& x) {
+  Connection& c = *x.conn;
+  int rc = SSL_do_handshake(c.ssl);
+  int flushed = FlushTls(c);
+  if (flushed < 0) {
+    Fail(x, std::string("SSL connection failed: ") + std::strerror(errno));
+    return;
+  }
+  if (rc == 1) {
+    x.state = Exchange::State::kSend;
+    Send(x);
+    return;
+  }
+  int err = SSL_get_error(c.ssl, rc);
+  if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) {
+    Fail(x, TlsError(c.ssl));
+    return;
+  }
+  Watch(x, flushed == 0, false);
+}
+
+// NextBody returns the unsent part of the body the loop may send now, pulling
+// the next chunk of a streamed body once the previous one is out. length is
+// 0 when the whole body is sent; false means the exchange failed.
+bool Loop::NextBody(Exchange& x, const char*& data, size_t& length) {
+  const Request& req = x.req;
+  if (req.bodyfunc == nullptr) {
+    data = req.body.data() + x.body_off;
+    length = req.body.size() - x.body_off;
+    return true;
+  }
+  if (x.body_off == x.chunk_start + x.chunk.size() &&
+      x.body_off < req.body_size) {
+    x.pulled = true;
+    x.chunk.resize(std::min(kBodyChunkSize, req.body_size - x.body_off));
+    BodyFunctionArgs args;
+    args.buffer = x.chunk.data();
+    args.size = x.chunk.size();
+    args.offset = x.body_off;
+    args.userdata = req.body_userdata;
+    bool ok;
+    try {
+      ok = req.bodyfunc(args);
+    } catch (const std::exception& e) {
+      Fail(x, std::string("HTTP error: ") + e.what());
+      return false;
+    }
+    if (!ok || args.written == 0 || args.written > args.size) {
+      Fail(x, "unable to read request body; expected " +
+                  std::to_string(req.body_size) + " bytes");
+      return false;
+    }
+    x.chunk.resize(args.written);
+    x.chunk_start = x.body_off;
+  }
+  data = x.chunk.data() + (x.body_off - x.chunk_start);
+  length = x.chunk_start + x.chunk.size() - x.body_off;
+  return true;
+}
+
+void Loop::Send(Exchange& x) {
+  Connection& c = *x.conn;
+  const Request& req = x.req;
+  const size_t body_size = req.BodySize();
+  const size_t body_before = x.body_off;
+
+  if (c.ssl == nullptr) {
+    // Plaintext goes out straight from the head and the body.
+    while (x.head_off < x.head.size() || x.body_off < body_size) {
+      const char* body;
+      size_t length;
+      if (!NextBody(x, body, length)) return;
+      iovec iov[2];
+      int count = 0;
+      if (x.head_off < x.head.size()) {
+        iov[count].iov_base = x.head.data() + x.head_off;
+        iov[count].iov_len = x.head.size() - x.head_off;
+        count++;
+      }
+      if (length > 0) {
+        iov[count].iov_base = const_cast<char*>(body);
+        iov[count].iov_len = length;
+        count++;
+      }
+      msghdr msg{};
+      msg.msg_iov = iov;
+      msg.msg_iovlen = static_cast<size_t>(count);
+      ssize_t sent = sendmsg(c.fd, &msg, MSG_NOSIGNAL);
+      if (sent < 0) {
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        Fail(x, std::string("Failed to write connection: ") +
+                    std::strerror(errno));
+        return;
+      }
+      size_t n = static_cast<size_t>(sent);
+      size_t from_head = std::min(n, x.head.size() - x.head_off);
+      x.head_off += from_head;
+      x.body_off += n - from_head;
+    }
+  } else {
+    // Encrypt a record at a time, only once the previous ones are on the
+    // wire, so at most one record of ciphertext is buffered.
+    while (true) {
+      int flushed = FlushTls(c);
+      if (flushed < 0) {
+        Fail(x, std::string("Failed to write connection: ") +
+                    std::strerror(errno));
+        return;
+      }
+      if (flushed == 0) break;
+      const char* data;
+      size_t length;
+      bool from_head = x.head_off < x.head.size();
+      if (from_head) {
+        data = x.head.data() + x.head_off;
+        length = x.head.size() - x.head_off;
+      } else if (!NextBody(x, data, length)) {
+        return;
+      }
+      if (length == 0) break;
+      length = std::min(length, kTlsRecordSize);
+      int rc = SSL_write(c.ssl, data, static_cast<int>(length));
+      if (rc <= 0) {
+        Fail(x, TlsError(c.ssl));
+        return;
+      }
+      if (from_head) {
+        x.head_off += static_cast<size_t>(rc);
+      } else {
+        x.body_off += static_cast<size_t>(rc);
+      }
+    }
+  }
+
+  if (x.body_off != body_before) {
+    x.last_activity = Clock::now();
+    if (req.progressfunc != nullptr) {
+      ProgressFunctionArgs args;
+      args.upload_total_bytes = static_cast<double>(body_size);
+      args.uploaded_bytes = static_cast<double>(x.body_off);
+      args.userdata = req.progress_userdata;
+      if (!req.progressfunc(args)) {
+        Fail(x, "Operation canceled");
+        return;
+      }
+    }
+  }
+
+  bool done = x.head_off == x.head.size() && x.body_off == body_size &&
+              c.pending.empty();
+  if (done) x.state = Exchange::State::kReceive;
+  Watch(x, !done, false);
+}
+
+void Loop::OnReadable(Exchange& x) {
+  char buf[kReadSize];
+  for (int i = 0; i < kReadsPerEvent && !x.finished; i++) {
+    ssize_t n = recv(x.conn->fd, buf, sizeof(buf), 0);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      if (x.head_done || x.received_any || !x.reused || x.retried ||
+          x.pulled) {
+        Fail(x, std::string("Failed to read connection: ") +
+                    std::strerror(errno));
+      } else {
+        OnEof(x);
+      }
+      return;
+    }
+    if (n == 0) {
+      OnEof(x);
+      return;
+    }
+    x.last_activity = Clock::now();
+
+    Connection& c = *x.conn;
+    if (c.ssl == nullptr) {
+      Consume(x, buf, static_cast<size_t>(n));
+      continue;
+    }
+
+    BIO_write(c.rbio, buf, static_cast<int>(n));
+    if (x.state == Exchange::State::kHandshake) {
+      Handshake(x);
+      continue;
+    }
+    char plain[kReadSize];
+    while (!x.finished) {
+      int r = SSL_read(c.ssl, plain, sizeof(plain));
+      if (r > 0) {
+        Consume(x, plain, static_cast<size_t>(r));
+        continue;
+      }
+      int err = SSL_get_error(c.ssl, r);
+      if (err == SSL_ERROR_ZERO_RETURN) {
+        OnEof(x);
+        return;
+      }
+      if (err != SSL_ERROR_WANT_READ) {
+        Fail(x, TlsError(c.ssl));
+        return;
+      }
+      break;
+    }
+    // Reads can produce handshake messages, e.g. TLS 1.3 key updates.
+    if (!x.finished && FlushTls(c) < 0) {
+      Fail(x, std::string("Failed to write connection: ") +
+                  std::strerror(errno));
+      return;
+    }
+  }
+}
+
+void Loop::OnEof(Exchange& x) {
+  if (x.head_done && x.body_mode == Exchange::BodyMode::kClose) {
+    Complete(x);
+    return;
+  }
+  // A reused keep-alive connection may have been closed by the server just
+  // as the request was sent; retry once on a fresh connection, unless part
+  // of a streamed body is already gone.
+  if (x.reused && !x.retried && !x.received_any && !x.pulled) {
+    Unwatch(*x.conn);
+    x.conn.reset();
+    x.reused = false;
+    x.retried = true;
+    x.head_off = 0;
+    x.body_off = 0;
+    std::string error;
+    if (!Resolve(x, error)) {
+      Fail(x, error);
+      return;
+    }
+    Connect(x);
+    return;
+  }
+  Fail(x, "Failed to read connection");
+}
+
+void Loop::Consume(Exchange& x, const char* data, size_t length) {
+  x.received_any = true;
+  if (x.head_done && x.body_mode != Exchange::BodyMode::kChunked) {
+    Body(x, data, length);
+    return;
+  }
+  x.in.append(data, length);
+  if (!x.head_done) {
+    if (!ParseHead(x)) return;
+    if (x.finished) return;
+    if (x.body_mode == Exchange::BodyMode::kNone) {
+      Complete(x);
+      return;
+    }
+  }
+  if (x.body_mode == Exchange::BodyMode::kChunked) {
+    Body(x, nullptr, 0);  // Parsed out of x.in.
+    return;
+  }
+  std::string rest;
+  rest.swap(x.in);
+  if (!rest.empty()) Body(x, rest.data(), rest.size());
+}
+
+// ParseHead parses the status line and headers once they are complete in
+// x.in, leaving the remaining bytes there. Interim 1xx responses are skipped.
+bool Loop::ParseHead(Exchange& x) {
+  while (true) {
+    size_t end = x.in.find("\r\n\r\n");
+    if (end == std::string::npos) {
+      if (x.in.size() > kMaxHeaderSize) Fail(x, "response header too large");
+      return false;
+    }
+    std::string_view head(x.in.data(), end);
+    size_t eol = head.find("\r\n");
+    std::string_view status_line = head.substr(0, eol);
+    size_t sp = status_line.find(' ');
+    int status = 0;
+    if (sp != std::string_view::npos && status_line.size() >= sp + 4) {
+      status = std::atoi(std::string(status_line.substr(sp + 1, 3)).c_str());
+    }
+    if (status_line.substr(0, 5) != "HTTP/" || status < 100) {
+      Fail(x, "invalid HTTP response");
+      return false;
+    }
+    if (status < 200) {
+      x.in.erase(0, end + 4);
+      continue;
+    }
+
+    Response& response = x.response;
+    response.status_code = status;
+    std::string content_length;
+    std::string transfer_encoding;
+    std::string connection;
+    size_t pos = eol == std::string_view::npos ? head.size() : eol + 2;
+    while (pos < head.size()) {
+      size_t next = head.find("\r\n", pos);
+      if (next == std::string_view::npos) next = head.size();
+      std::string_view line = head.substr(pos, next - pos);
+      pos = next + 2;
+      size_t colon = line.find(':');
+      if (colon == std::string_view::npos) continue;
+      std::string key(line.substr(0, colon));
+      std::string value(line.substr(colon + 1));
+      value = utils::Trim(value);
+      std::string lower = utils::ToLower(key);
+      if (lower == "content-length") content_length = value;
+      if (lower == "transfer-encoding") {
+        transfer_encoding = utils::ToLower(value);
+      }
+      if (lower == "connection") connection = utils::ToLower(value);
+      response.headers.Add(std::move(key), std::move(value));
+    }
+    x.in.erase(0, end + 4);
+    x.head_done = true;
+
+    if (x.req.debug) {
+      std::cerr << MethodToString(x.req.method) << " " << x.req.url.path
+                << " -> " << status << std::endl;
+    }
+
+    if (connection == "close") x.keep_alive = false;
+    if (x.req.method == Method::kHead || status == 204 || status == 304) {
+      x.body_mode = Exchange::BodyMode::kNone;
+    } else if (transfer_encoding.find("chunked") != std::string::npos) {
+      x.body_mode = Exchange::BodyMode::kChunked;
+    } else if (!content_length.empty()) {
+      x.body_total = std::strtoull(content_length.c_str(), nullptr, 10);
+      x.remaining = x.body_total;
+      x.body_mode = x.remaining == 0 ? Exchange::BodyMode::kNone
+                                     : Exchange::BodyMode::kLength;
+    } else {
+      x.body_mode = Exchange::BodyMode::kClose;
+      x.keep_alive = false;
+    }
+
+    // Same delivery rules as the cpp-httplib transport: 2xx GET bodies go to
+    // the receive buffer or data function, other GET bodies are buffered, and
+    // POST with a data function always streams.
+    const bool ok = status >= 200 && status <= 299;
+    if (x.req.method == Method::kGet) {
+      x.stream = ok && (x.req.datafunc != nullptr || x.req.buffer != nullptr);
+    } else {
+      x.stream = x.req.method == Method::kPost && x.req.datafunc != nullptr;
+    }
+    return true;
+  }
+}
+
+void Loop::Body(Exchange& x, const char* data, size_t length) {
+  switch (x.body_mode) {
+    case Exchange::BodyMode::kNone:
+      return;
+    case Exchange::BodyMode::kClose:
+      Deliver(x, data, length);
+      return;
+    case Exchange::BodyMode::kLength: {
+      size_t n = std::min(length, x.remaining);
+      if (!Deliver(x, data, n)) return;
+      x.remaining -= n;
+      if (n < length) x.keep_alive = false;  // Server sent more than it said.
+      if (x.remaining == 0) Complete(x);
+      return;
+    }
+    case Exchange::BodyMode::kChunked:
+      break;
+  }
+
+  // Chunked bodies are parsed out of x.in.
+  size_t pos = 0;
+  while (!x.finished) {
+    if (x.chunk_state == Exchange::ChunkState::kData) {
+      size_t n = std::min(x.in.size() - pos, x.remaining);
+      if (n == 0) break;
+      if (!Deliver(x, x.in.data() + pos, n)) return;
+      pos += n;
+      x.remaining -= n;
+      if (x.remaining == 0) x.chunk_state = Exchange::ChunkState::kDataEnd;
+      continue;
+    }
+    size_t eol = x.in.find("\r\n", pos);
+    if (eol == std::string::npos) break;
+    std::string line = x.in.substr(pos, eol - pos);
+    pos = eol + 2;
+    if (x.chunk_state == Exchange::ChunkState::kDataEnd) {
+      x.chunk_state = Exchange::ChunkState::kSize;
+    } else if (x.chunk_state == Exchange::ChunkState::kSize) {
+      x.remaining = std::strtoull(line.c_str(), nullptr, 16);
+      x.chunk_state = x.remaining == 0 ? Exchange::ChunkState::kTrailer
+                                       : Exchange::ChunkState::kData;
+    } else if (line.empty()) {
+      x.in.clear();
+      Complete(x);
+      return;
+    }
+  }
+  if (!x.finished) x.in.erase(0, pos);
+}
+
+bool Loop::Deliver(Exchange& x, const char* data, size_t length) {
+  if (length == 0) return true;
+  const Request& req = x.req;
+  x.body_received += length;
+
+  if (!x.stream) {
+    x.response.body.append(data, length);
+  } else if (req.buffer != nullptr) {
+    if (length > req.buffer->size - req.buffer->received) {
+      x.overflow = true;
+      Complete(x);
+      return false;
+    }
+    std::memcpy(req.buffer->data + req.buffer->received, data, length);
+    req.buffer->received += length;
+  } else {
+    DataFunctionArgs args(&x.response, req.userdata);
+    args.data = std::string_view(data, length);
+    if (!req.zero_copy) args.datachunk.assign(data, length);
+    bool cont;
+    try {
+      cont = req.datafunc(std::move(args));
+    } catch (const std::exception& e) {
+      Fail(x, std::string("HTTP error: ") + e.what());
+      return false;
+    }
+    if (!cont) {
+      x.canceled = true;
+      Complete(x);
+      return false;
+    }
+  }
+
+  if (req.progressfunc != nullptr) {
+    ProgressFunctionArgs args;
+    args.download_total_bytes = static_cast<double>(x.body_total);
+    args.downloaded_bytes = static_cast<double>(x.body_received);
+    args.userdata = req.progress_userdata;
+    if (!req.progressfunc(args)) {
+      Fail(x, "Operation canceled");
+      return false;
+    }
+  }
+  return true;
+}
+
+void Loop::Complete(Exchange& x) {
+  if (x.overflow) {
+    x.response.error = "response body exceeds receive buffer of " +
+                       std::to_string(x.req.buffer->size) + " bytes";
+  }
+  // A caller-initiated cancel, an unread body or a request not fully sent,
+  // e.g. a PUT the server answered before reading its body, leaves the
+  // connection in an unknown state; only a fully exchanged request keeps it.
+  bool reusable = x.keep_alive && !x.canceled && !x.overflow &&
+                  x.body_mode != Exchange::BodyMode::kClose &&
+                  x.head_off == x.head.size() &&
+                  x.body_off == x.req.BodySize() && x.conn->pending.empty();
+  if (reusable && x.conn->ssl != nullptr) {
+    SSL_SESSION* session = SSL_get1_session(x.conn->ssl);
+    if (session != nullptr && SSL_SESSION_is_resumable(session)) {
+      SSL_SESSION*& slot = sessions_[x.key];
+      if (slot != nullptr) SSL_SESSION_free(slot);
+      slot = session;
+    } else if (session != nullptr) {
+      SSL_SESSION_free(session);
+    }
+  }
+  if (reusable) {
+    Unwatch(*x.conn);
+    x.conn->idle_since = Clock::now();
+    auto& conns = idle_[x.key];
+    conns.push_back(std::move(x.conn));
+    if (conns.size() > kMaxIdlePerHost) conns.erase(conns.begin());
+  }
+  Finish(x);
+}
+
+void Loop::Fail(Exchange& x, std::string error) {
+  x.response.error = std::move(error);
+  Finish(x);
+}
+
+void Loop::Finish(Exchange& x) {
+  if (x.finished) return;
+  x.finished = true;
+  if (x.conn) {
+    Unwatch(*x.conn);
+    x.conn.reset();
+  }
+
+  const Request& req = x.req;
+  if (req.progressfunc != nullptr) {
+    const double elapsed =
+        std::chrono::duration<double>(Clock::now() - x.start).count();
+    ProgressFunctionArgs args;
+    if (elapsed > 0) {
+      args.download_speed = static_cast<double>(x.body_received) / elapsed;
+      args.upload_speed = static_cast<double>(x.body_off) / elapsed;
+    }
+    args.userdata = req.progress_userdata;
+    try {
+      req.progressfunc(args);
+    } catch (const std::exception&) {
+    }
+  }
+
+  // The completion callback is the waiter, so an exception from it has
+  // nobody left to go to; it terminates, as from any thread function.
+  [&x]() noexcept { x.done(std::move(x.response)); }();
+  finished_.push_back(&x);
+}
+
+void Loop::Watch(Exchange& x, bool write, bool add) {
+  epoll_event ev{};
+  ev.events = EPOLLIN | (write ? EPOLLOUT : 0u);
+  ev.data.ptr = &x;
+  epoll_ctl(epfd_, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, x.conn->fd, &ev);
+}
+
+void Loop::Unwatch(Connection& c) {
+  epoll_ctl(epfd_, EPOLL_CTL_DEL, c.fd, nullptr);
+}
+
+void Loop::Sweep(Clock::time_point now) {
+  last_sweep_ = now;
+  std::vector<Exchange*> expired;
+  for (auto& [ptr, x] : active_) {
+    if (x->finished) continue;
+    bool connecting = x->state == Exchange::State::kConnect ||
+                      x->state == Exchange::State::kHandshake;
+    std::chrono::seconds connect_timeout = kConnectTimeout;
+    if (x->req.connect_timeout_secs > 0) {
+      connect_timeout = std::chrono::seconds(x->req.connect_timeout_secs);
+    }
+    if (now >= x->deadline ||
+        (connecting && now - x->last_activity >= connect_timeout) ||
+        (!connecting && x->req.timeout_secs <= 0 &&
+         now - x->last_activity >= kStallTimeout)) {
+      expired.push_back(ptr);
+    }
+  }
+  for (Exchange* x : expired) {
+    Fail(*x, x->state == Exchange::State::kConnect
+                 ? "Connection timed out while trying to connect"
+                 : "Read timeout");
+  }
+
+  for (auto itr = idle_.begin(); itr != idle_.end();) {
+    auto& conns = itr->second;
+    conns.erase(std::remove_if(conns.begin(), conns.end(),
+                               [now](const std::unique_ptr<Connection>& c) {
+                                 return now - c->idle_since >= kIdleTimeout;
+                               }),
+                conns.end());
+    itr = conns.empty() ? idle_.erase(itr) : std::next(itr);
+  }
+  for (auto itr = dns_.begin(); itr != dns_.end();) {
+    itr = itr->second.expires <= now ? dns_.erase(itr) : std::next(itr);
+  }
+}
+
+}  // namespace
+
+struct EventLoopTransport::Impl {
+  std::vector<std::unique_ptr<Loop>> loops;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> next{0};
+  std::shared_ptr<std::atomic<size_t>> inflight =
+      std::make_shared<std::atomic<size_t>>(0);
+};  // struct EventLoopTransport::Impl
+
+EventLoopTransport::EventLoopTransport(unsigned int threads)
+    : impl_(std::make_unique<Impl>()) {
+  threads = std::max(1u, threads);
+  for (unsigned int i = 0; i < threads; i++) {
+    impl_->loops.push_back(std::make_unique<Loop>(impl_.get()));
+  }
+  try {
+    for (auto& loop : impl_->loops) {
+      impl_->threads.emplace_back([l = loop.get()]() { l->Run(); });
+    }
+  } catch (const std::system_error&) {
+    for (auto& loop : impl_->loops) loop->Stop();
+    for (auto& thread : impl_->threads) thread.join();
+    throw;
+  }
+}
+
+EventLoopTransport::~EventLoopTransport() {
+  for (auto& loop : impl_->loops) loop->Stop();
+  for (auto& thread : impl_->threads) thread.join();
+}
+
+void EventLoopTransport::Submit(Request request, Callback done) {
+  auto x = std::make_unique<Exchange>(
+      std::move(request), [inflight = impl_->inflight,
+                           done = std::move(done)](Response response) {
+        (*inflight)--;
+        done(std::move(response));
+      });
+  (*impl_->inflight)++;
+  size_t index = impl_->next++ % impl_->loops.size();
+  impl_->loops[index]->Post(std::move(x));
+}
+
+Response EventLoopTransport::Execute(Request& request) {
+  if (current_loop_owner == impl_.get()) {
+    Response response;
+    response.error =
+        "EventLoopTransport::Execute called from its own loop thread";
+    return response;
+  }
+  std::promise<Response> promise;
+  std::future<Response> future = promise.get_future();
+  Request copy = request;
+  copy.transport = nullptr;
+  Submit(std::move(copy), [&promise](Response response) {
+    promise.set_value(std::move(response));
+  });
+  return future.get();
+}
+
+size_t EventLoopTransport::Inflight() const { return impl_->inflight->load(); }
+
+#else  // __linux__
+
+struct EventLoopTransport::Impl {};
+
+EventLoopTransport::EventLoopTransport(unsigned int /* threads */)
+    : impl_(std::make_unique<Impl>()) {}
+
+EventLoopTransport::~EventLoopTransport() = default;
+
+void EventLoopTransport::Submit(Request /* request */, Callback done) {
+  Response response;
+  response.error = "EventLoopTransport is only supported on Linux";
+  done(std::move(response));
+}
+
+Response EventLoopTransport::Execute(Request& request) {
+  std::promise<Response> promise;
+  std::future<Response> future = promise.get_future();
+  Submit(request, [&promise](Response response) {
+    promise.set_value(std::move(response));
+  });
+  return future.get();
+}
+
+size_t EventLoopTransport::Inflight() const { return 0; }
+
+#endif  // __linux__
+
+}  // namespace minio::http
@@ -29,6 +29,52 @@
 
 namespace minio::s3 {
 
+std::string ChecksumHeaderName(ChecksumAlgorithm algorithm) {
+  return "x-amz-checksum-" +
+         utils::ToLower(ChecksumAlgorithmToString(algorithm));
+}
+
+void Checksum::Update(const char* data, size_t len) {
+  switch (algorithm_) {
+    case ChecksumAlgorithm::kCrc32c:
+      crc_ = utils::Crc32c(data, len, static_cast<uint32_t>(crc_));
+      break;
+    case ChecksumAlgorithm::kCrc64Nvme:
+      crc_ = utils::Crc64Nvme(data, len, crc_);
+      break;
+    default:
+      break;
+  }
+}
+
+std::string Checksum::Base64() const {
+  if (algorithm_ == ChecksumAlgorithm::kCrc64Nvme) {
+    return utils::Crc64NvmeBase64(crc_);
+  }
+  char be[4];
+  for (int i = 0; i < 4; ++i) {
+    be[i] = static_cast<char>((crc_ >> (24 - i * 8)) & 0xff);
+  }
+  return utils::Base64Encode(std::string_view(be, sizeof(be)));
+}
+
+error::Error Checksum::Verify(const utils::Multimap& headers) const {
+  std::string expected = headers.GetFront(ChecksumHeaderName(algorithm_));
+  // A composite checksum ("<checksum of part checksums>-<parts>") covers the
+  // parts, not the bytes.
+  if (expected.empty() || utils::Contains(expected, '-') ||
+      headers.GetFront("x-amz-checksum-type") == "COMPOSITE") {
+    return error::SUCCESS;
+  }
+  std::string actual = Base64();
+  if (actual != expected) {
+    return error::Error(std::string(ChecksumAlgorithmToString(algorithm_)) +
+                        " mismatch; expected: " + expected +
+                        ", got: " + actual);
+  }
+  return error::SUCCESS;
+}
+
 RetentionMode StringToRetentionMode(std::string_view str) noexcept {
   if (str == "GOVERNANCE") return RetentionMode::kGovernance;
   if (str == "COMPLIANCE") return RetentionMode::kCompliance;
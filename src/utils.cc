@@ -17,10 +17,10 @@
 
 #include "miniocpp/utils.h"
 
-#include <charconv>
 #include <optional>
 
 #include "miniocpp/error.h"
+#include "miniocpp/executor.h"
 
 #ifdef _WIN32
 #define _CRT_SECURE_NO_WARNINGS
@@ -31,6 +31,17 @@
 #include <unistd.h>
 #endif
 
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
 // CPPHTTPLIB_OPENSSL_SUPPORT is set target-wide in CMakeLists.txt so every
 // translation unit compiles httplib.h with the same macro set.
 #include <httplib.h>
@@ -45,6 +56,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <clocale>
@@ -54,6 +66,7 @@
 #include <cstdlib>
 #include <ctime>
 #include <exception>
+#include <future>
 #include <iomanip>
 #include <ios>
 #include <iosfwd>
@@ -63,11 +76,11 @@
 #include <map>
 #include <memory>
 #include <ostream>
-#include <pugixml.hpp>
 #include <regex>
 #include <sstream>
 #include <streambuf>
 #include <string>
+#include <system_error>
 #include <type_traits>
 #include <vector>
 
@@ -275,21 +288,81 @@ std::string EncodePath(const std::string& path) {
 }
 
 std::string XMLEncode(const std::string& value) {
-  pugi::xml_document doc;
-  doc.append_child(pugi::node_pcdata).set_value(value.c_str());
-  std::ostringstream out;
-  doc.print(out);
-  return out.str();
+  std::string out;
+  XMLEncodeTo(out, value);
+  return out;
 }
 
-std::string Sha256Hash(std::string_view str) {
-  EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+void XMLEncodeTo(std::string& out, std::string_view value) {
+  // Escapes as pugixml does text: &, <, > and control characters other than
+  // tab, line feed and carriage return.
+  auto special = [](unsigned char c) {
+    return c == '&' || c == '<' || c == '>' ||
+           (c < 32 && c != '\t' && c != '\n' && c != '\r');
+  };
+  size_t start = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    auto c = static_cast<unsigned char>(value[i]);
+    if (!special(c)) continue;
+    out.append(value, start, i - start);
+    start = i + 1;
+    switch (c) {
+      case '&':
+        out += "&amp;";
+        break;
+      case '<':
+        out += "&lt;";
+        break;
+      case '>':
+        out += "&gt;";
+        break;
+      default:
+        out += "&#";
+        out += static_cast<char>('0' + c / 10);
+        out += static_cast<char>('0' + c % 10);
+        out += ';';
+    }
+  }
+  out.append(value, start, value.size() - start);
+}
+
+namespace {
+
+// Sha256Digest is fetched once; under OpenSSL 3 EVP_sha256() makes every
+// EVP_DigestInit_ex look the implementation up again.
+const EVP_MD* Sha256Digest() {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  static const EVP_MD* md = [] {
+    const EVP_MD* fetched = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+    return fetched != nullptr ? fetched : EVP_sha256();
+  }();
+  return md;
+#else
+  return EVP_sha256();
+#endif
+}
+
+struct EvpMdCtxDeleter {
+  void operator()(EVP_MD_CTX* ctx) const { EVP_MD_CTX_free(ctx); }
+};
+
+// Sha256Context returns the digest context of the calling thread, reused by
+// every hash computed on it.
+EVP_MD_CTX* Sha256Context() {
+  thread_local std::unique_ptr<EVP_MD_CTX, EvpMdCtxDeleter> ctx(
+      EVP_MD_CTX_new());
   if (ctx == nullptr) {
     std::cerr << "failed to create EVP_MD_CTX" << std::endl;
     std::terminate();
   }
+  return ctx.get();
+}
+
+}  // namespace
 
-  if (1 != EVP_DigestInit_ex(ctx, EVP_sha256(), nullptr)) {
+std::string Sha256Hash(std::string_view str) {
+  EVP_MD_CTX* ctx = Sha256Context();
+  if (1 != EVP_DigestInit_ex(ctx, Sha256Digest(), nullptr)) {
     std::cerr << "failed to init SHA-256 digest" << std::endl;
     std::terminate();
   }
@@ -299,36 +372,60 @@ std::string Sha256Hash(std::string_view str) {
     std::terminate();
   }
 
-  unsigned int length = static_cast<unsigned>(EVP_MD_size(EVP_sha256()));
-  unsigned char* digest = (unsigned char*)OPENSSL_malloc(length);
-  if (digest == nullptr) {
-    std::cerr << "failed to allocate memory for hash value" << std::endl;
-    std::terminate();
-  }
-
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int length = 0;
   if (1 != EVP_DigestFinal_ex(ctx, digest, &length)) {
-    OPENSSL_free(digest);
     std::cerr << "failed to finalize digest" << std::endl;
     std::terminate();
   }
 
-  EVP_MD_CTX_destroy(ctx);
-
-  std::string hash;
-  hash.resize(length * 2);
-  char* out = hash.data();
+  static constexpr char kHex[] = "0123456789abcdef";
+  std::string hash(length * 2, '\0');
   for (unsigned int i = 0; i < length; ++i) {
-    if (auto [ptr, ec] = std::to_chars(out, out + 2, digest[i], 16);
-        ptr - out == 1) {
-      out[1] = out[0];
-      out[0] = '0';
-    }
-    out += 2;
+    hash[2 * i] = kHex[digest[i] >> 4];
+    hash[2 * i + 1] = kHex[digest[i] & 0xf];
   }
+  return hash;
+}
 
-  OPENSSL_free(digest);
+std::vector<std::string> Sha256HashAll(
+    const std::vector<std::string_view>& buffers, Executor* executor) {
+  std::vector<std::string> hashes(buffers.size());
+  if (executor == nullptr || buffers.size() < 2) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      hashes[i] = Sha256Hash(buffers[i]);
+    }
+    return hashes;
+  }
 
-  return hash;
+  // Workers and the calling thread claim buffers, and the caller hashes
+  // every buffer no worker has started on. It thus only waits for hashes in
+  // progress, never for a task queued behind busy workers: the caller may be
+  // a thread those workers wait on, e.g. an event loop thread driving their
+  // requests. A task run after its buffer was claimed returns untouched.
+  auto claimed = std::make_shared<std::vector<std::atomic<bool>>>(
+      buffers.size());
+  std::vector<std::future<void>> futures(buffers.size());
+  for (size_t i = 1; i < buffers.size(); ++i) {
+    try {
+      futures[i] = executor->Submit([claimed, &hashes, &buffers, i]() {
+        if ((*claimed)[i].exchange(true)) return;
+        hashes[i] = Sha256Hash(buffers[i]);
+      });
+    } catch (const std::system_error&) {
+      break;
+    }
+  }
+  std::vector<bool> mine(buffers.size(), false);
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    if ((*claimed)[i].exchange(true)) continue;
+    mine[i] = true;
+    hashes[i] = Sha256Hash(buffers[i]);
+  }
+  for (size_t i = 1; i < buffers.size(); ++i) {
+    if (!mine[i]) futures[i].wait();
+  }
+  return hashes;
 }
 
 std::string Base64Encode(std::string_view str) {
@@ -348,6 +445,19 @@ std::string Base64Encode(std::string_view str) {
   return base64_encoded;
 }
 
+std::string Base64Decode(std::string_view str) {
+  if (str.empty() || str.size() % 4 != 0) return "";
+  std::string decoded(str.size() / 4 * 3, '\0');
+  int n = EVP_DecodeBlock(reinterpret_cast<unsigned char*>(decoded.data()),
+                          reinterpret_cast<const unsigned char*>(str.data()),
+                          static_cast<int>(str.size()));
+  if (n < 0) return "";
+  // EVP_DecodeBlock counts the padding as zero bytes.
+  size_t padding = (str.back() == '=') + (str[str.size() - 2] == '=');
+  decoded.resize(static_cast<size_t>(n) - padding);
+  return decoded;
+}
+
 std::string Md5sumHash(std::string_view str) {
   EVP_MD_CTX* ctx = EVP_MD_CTX_create();
   if (ctx == nullptr) {
@@ -388,38 +498,275 @@ std::string Md5sumHash(std::string_view str) {
 
 namespace {
 
-// NVMe CRC64 reflected lookup table for polynomial 0xad93d23594c93659.
-// Built lazily once; thread-safe via the C++11 static-init guarantee.
-const std::array<uint64_t, 256>& Crc64NvmeTable() {
-  static const std::array<uint64_t, 256> kTable = []() {
-    constexpr uint64_t kPoly = 0x9a6c9329ac4bc9b5ULL;  // reflected polynomial
-    std::array<uint64_t, 256> table{};
+// CRC-64/NVME in reflected form: bit i of a value is the coefficient of
+// x^(63-i), so x^0 is the top bit.
+constexpr uint64_t kCrc64NvmePoly = 0x9a6c9329ac4bc9b5ULL;
+
+// Crc64MulX returns a * x modulo the polynomial.
+constexpr uint64_t Crc64MulX(uint64_t a) {
+  return (a & 1) ? (a >> 1) ^ kCrc64NvmePoly : a >> 1;
+}
+
+// Crc64MulMod returns a * b modulo the polynomial.
+constexpr uint64_t Crc64MulMod(uint64_t a, uint64_t b) {
+  uint64_t product = 0;
+  for (uint64_t m = 1ULL << 63; m != 0; m >>= 1) {
+    if (a & m) product ^= b;
+    b = Crc64MulX(b);
+  }
+  return product;
+}
+
+// Crc64XPowMod returns x^n modulo the polynomial.
+constexpr uint64_t Crc64XPowMod(uint64_t n) {
+  uint64_t result = 1ULL << 63;
+  uint64_t square = 1ULL << 62;  // x^(2^k) for the current bit k of n.
+  for (; n != 0; n >>= 1) {
+    if (n & 1) result = Crc64MulMod(result, square);
+    square = Crc64MulMod(square, square);
+  }
+  return result;
+}
+
+// Slice-by-8 tables: kCrc64Tables[k][b] is the CRC register after byte b
+// followed by k zero bytes.
+using Crc64Tables = std::array<std::array<uint64_t, 256>, 8>;
+
+const Crc64Tables& Crc64NvmeTables() {
+  static const Crc64Tables kTables = []() {
+    Crc64Tables tables{};
     for (uint32_t i = 0; i < 256; ++i) {
       uint64_t crc = static_cast<uint64_t>(i);
-      for (int j = 0; j < 8; ++j) {
-        crc = (crc & 1ULL) ? (crc >> 1) ^ kPoly : (crc >> 1);
+      for (int j = 0; j < 8; ++j) crc = Crc64MulX(crc);
+      tables[0][i] = crc;
+    }
+    for (size_t k = 1; k < tables.size(); ++k) {
+      for (uint32_t i = 0; i < 256; ++i) {
+        uint64_t crc = tables[k - 1][i];
+        tables[k][i] = (crc >> 8) ^ tables[0][crc & 0xff];
       }
-      table[i] = crc;
     }
-    return table;
+    return tables;
+  }();
+  return kTables;
+}
+
+// The kernels below take and return the raw CRC register, without the
+// initial and final inversion.
+
+uint64_t Crc64SliceBy8(uint64_t crc, const unsigned char* p, size_t len) {
+  const Crc64Tables& t = Crc64NvmeTables();
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word = 0;
+    for (int i = 7; i >= 0; --i) word = (word << 8) | p[i];
+    crc ^= word;
+    crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+          t[5][(crc >> 16) & 0xff] ^ t[4][(crc >> 24) & 0xff] ^
+          t[3][(crc >> 32) & 0xff] ^ t[2][(crc >> 40) & 0xff] ^
+          t[1][(crc >> 48) & 0xff] ^ t[0][crc >> 56];
+  }
+  for (; len > 0; ++p, --len) crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+  return crc;
+}
+
+// The carry-less multiply kernels fold the data 64 bytes at a time into
+// four 128-bit accumulators, then fold those into one and finish it with
+// the tables. A carry-less product of two reflected 64-bit values comes out
+// multiplied by x, so folding 128 bits forward over n bits multiplies the
+// low half by x^(n+63) and the high half by x^(n-1).
+constexpr uint64_t kFold512Low = Crc64XPowMod(512 + 63);
+constexpr uint64_t kFold512High = Crc64XPowMod(512 - 1);
+constexpr uint64_t kFold128Low = Crc64XPowMod(128 + 63);
+constexpr uint64_t kFold128High = Crc64XPowMod(128 - 1);
+
+#if (defined(__x86_64__) || defined(_M_X64)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define MINIO_CPP_CRC64_CLMUL 1
+
+__attribute__((target("pclmul,sse2"))) inline __m128i Crc64Fold(__m128i x,
+                                                                 __m128i k) {
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x00),
+                       _mm_clmulepi64_si128(x, k, 0x11));
+}
+
+__attribute__((target("pclmul,sse2"))) uint64_t Crc64Clmul(
+    uint64_t crc, const unsigned char* p, size_t len) {
+  if (len < 64) return Crc64SliceBy8(crc, p, len);
+
+  auto load = [](const unsigned char* at) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+  };
+  const __m128i k512 = _mm_set_epi64x(static_cast<int64_t>(kFold512High),
+                                      static_cast<int64_t>(kFold512Low));
+  const __m128i k128 = _mm_set_epi64x(static_cast<int64_t>(kFold128High),
+                                      static_cast<int64_t>(kFold128Low));
+
+  __m128i x0 = _mm_xor_si128(load(p),
+                             _mm_cvtsi64_si128(static_cast<int64_t>(crc)));
+  __m128i x1 = load(p + 16);
+  __m128i x2 = load(p + 32);
+  __m128i x3 = load(p + 48);
+  for (p += 64, len -= 64; len >= 64; p += 64, len -= 64) {
+    x0 = _mm_xor_si128(Crc64Fold(x0, k512), load(p));
+    x1 = _mm_xor_si128(Crc64Fold(x1, k512), load(p + 16));
+    x2 = _mm_xor_si128(Crc64Fold(x2, k512), load(p + 32));
+    x3 = _mm_xor_si128(Crc64Fold(x3, k512), load(p + 48));
+  }
+
+  __m128i x = _mm_xor_si128(Crc64Fold(x0, k128), x1);
+  x = _mm_xor_si128(Crc64Fold(x, k128), x2);
+  x = _mm_xor_si128(Crc64Fold(x, k128), x3);
+  for (; len >= 16; p += 16, len -= 16) {
+    x = _mm_xor_si128(Crc64Fold(x, k128), load(p));
+  }
+
+  unsigned char folded[16];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(folded), x);
+  return Crc64SliceBy8(Crc64SliceBy8(0, folded, sizeof(folded)), p, len);
+}
+
+bool Crc64ClmulSupported() { return __builtin_cpu_supports("pclmul"); }
+
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define MINIO_CPP_CRC64_CLMUL 1
+
+#ifdef __clang__
+#define MINIO_CPP_TARGET_PMULL __attribute__((target("aes")))
+#else
+#define MINIO_CPP_TARGET_PMULL __attribute__((target("+crypto")))
+#endif
+
+MINIO_CPP_TARGET_PMULL inline uint8x16_t Crc64Fold(uint8x16_t x,
+                                                   poly64x2_t k) {
+  poly64x2_t v = vreinterpretq_p64_u8(x);
+  poly128_t low = vmull_p64(vgetq_lane_p64(v, 0), vgetq_lane_p64(k, 0));
+  poly128_t high = vmull_high_p64(v, k);
+  return veorq_u8(vreinterpretq_u8_p128(low), vreinterpretq_u8_p128(high));
+}
+
+MINIO_CPP_TARGET_PMULL uint64_t Crc64Clmul(uint64_t crc,
+                                           const unsigned char* p,
+                                           size_t len) {
+  if (len < 64) return Crc64SliceBy8(crc, p, len);
+
+  const poly64x2_t k512 = vreinterpretq_p64_u64(
+      vcombine_u64(vcreate_u64(kFold512Low), vcreate_u64(kFold512High)));
+  const poly64x2_t k128 = vreinterpretq_p64_u64(
+      vcombine_u64(vcreate_u64(kFold128Low), vcreate_u64(kFold128High)));
+
+  uint8x16_t x0 = veorq_u8(
+      vld1q_u8(p), vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(crc),
+                                                     vcreate_u64(0))));
+  uint8x16_t x1 = vld1q_u8(p + 16);
+  uint8x16_t x2 = vld1q_u8(p + 32);
+  uint8x16_t x3 = vld1q_u8(p + 48);
+  for (p += 64, len -= 64; len >= 64; p += 64, len -= 64) {
+    x0 = veorq_u8(Crc64Fold(x0, k512), vld1q_u8(p));
+    x1 = veorq_u8(Crc64Fold(x1, k512), vld1q_u8(p + 16));
+    x2 = veorq_u8(Crc64Fold(x2, k512), vld1q_u8(p + 32));
+    x3 = veorq_u8(Crc64Fold(x3, k512), vld1q_u8(p + 48));
+  }
+
+  uint8x16_t x = veorq_u8(Crc64Fold(x0, k128), x1);
+  x = veorq_u8(Crc64Fold(x, k128), x2);
+  x = veorq_u8(Crc64Fold(x, k128), x3);
+  for (; len >= 16; p += 16, len -= 16) {
+    x = veorq_u8(Crc64Fold(x, k128), vld1q_u8(p));
+  }
+
+  unsigned char folded[16];
+  vst1q_u8(folded, x);
+  return Crc64SliceBy8(Crc64SliceBy8(0, folded, sizeof(folded)), p, len);
+}
+
+bool Crc64ClmulSupported() {
+#if defined(__APPLE__)
+  return true;
+#elif defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif
+
+using Crc64Kernel = uint64_t (*)(uint64_t, const unsigned char*, size_t);
+
+struct Crc64Dispatch {
+  Crc64Kernel kernel = Crc64SliceBy8;
+  const char* name = "slice-by-8";
+};
+
+// Picked once, on first use, from what the CPU supports.
+const Crc64Dispatch& Crc64NvmeDispatch() {
+  static const Crc64Dispatch kDispatch = []() {
+    Crc64Dispatch dispatch;
+#ifdef MINIO_CPP_CRC64_CLMUL
+    if (Crc64ClmulSupported()) {
+      dispatch.kernel = Crc64Clmul;
+#if defined(__aarch64__)
+      dispatch.name = "pmull";
+#else
+      dispatch.name = "pclmulqdq";
+#endif
+    }
+#endif
+    return dispatch;
   }();
-  return kTable;
+  return kDispatch;
 }
 
 }  // namespace
 
-uint64_t Crc64Nvme(const char* data, size_t len) {
-  const auto& table = Crc64NvmeTable();
-  uint64_t crc = 0xffffffffffffffffULL;
+uint64_t Crc64Nvme(const char* data, size_t len, uint64_t crc) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  return ~Crc64NvmeDispatch().kernel(~crc, p, len);
+}
+
+uint64_t Crc64NvmePortable(const char* data, size_t len, uint64_t crc) {
+  const auto* p = reinterpret_cast<const unsigned char*>(data);
+  return ~Crc64SliceBy8(~crc, p, len);
+}
+
+const char* Crc64NvmeKernel() { return Crc64NvmeDispatch().name; }
+
+uint64_t Crc64NvmeCombine(uint64_t crc1, uint64_t crc2, uint64_t len2) {
+  // Appending len2 bytes multiplies the CRC of the first part by x^(8*len2);
+  // the initial and final inversions cancel out in the XOR.
+  uint64_t shift = 1ULL << 63;
+  uint64_t square = Crc64XPowMod(8);  // x^(8*2^k) for the current bit k.
+  for (; len2 != 0; len2 >>= 1) {
+    if (len2 & 1) shift = Crc64MulMod(shift, square);
+    square = Crc64MulMod(square, square);
+  }
+  return Crc64MulMod(shift, crc1) ^ crc2;
+}
+
+uint32_t Crc32c(const char* data, size_t len, uint32_t crc) {
+  static const std::array<uint32_t, 256> kTable = []() {
+    constexpr uint32_t kPoly = 0x82f63b78;  // reflected polynomial
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int j = 0; j < 8; ++j) c = (c & 1) ? (c >> 1) ^ kPoly : (c >> 1);
+      table[i] = c;
+    }
+    return table;
+  }();
+  crc ^= 0xffffffffU;
   const auto* p = reinterpret_cast<const unsigned char*>(data);
   for (size_t i = 0; i < len; ++i) {
-    crc = table[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    crc = kTable[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
   }
-  return crc ^ 0xffffffffffffffffULL;
+  return crc ^ 0xffffffffU;
 }
 
 std::string Crc64NvmeBase64(const char* data, size_t len) {
-  const uint64_t crc = Crc64Nvme(data, len);
+  return Crc64NvmeBase64(Crc64Nvme(data, len));
+}
+
+std::string Crc64NvmeBase64(uint64_t crc) {
   // S3 expects big-endian bytes of the CRC value, base64-encoded.
   unsigned char be[8];
   for (int i = 0; i < 8; ++i) {
@@ -429,6 +776,14 @@ std::string Crc64NvmeBase64(const char* data, size_t len) {
       std::string_view(reinterpret_cast<const char*>(be), sizeof(be)));
 }
 
+bool ParseCrc64NvmeBase64(std::string_view value, uint64_t& crc) {
+  std::string be = Base64Decode(value);
+  if (be.size() != 8) return false;
+  crc = 0;
+  for (char c : be) crc = (crc << 8) | static_cast<unsigned char>(c);
+  return true;
+}
+
 std::string FormatTime(const std::tm& time, const char* format) {
   char buf[128];
   std::strftime(buf, 128, format, &time);
@@ -557,108 +912,162 @@ int UtcTime::Compare(const UtcTime& rhs) const {
   return 0;
 }
 
+namespace {
+
+// EqualsLower returns whether lower equals key compared case-insensitively;
+// lower must already be lower-cased.
+bool EqualsLower(std::string_view lower, std::string_view key) {
+  if (lower.size() != key.size()) return false;
+  for (size_t i = 0; i < key.size(); ++i) {
+    if (lower[i] != static_cast<char>(std::tolower(
+                        static_cast<unsigned char>(key[i])))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// AppendWithoutExtraSpaces appends s to out with runs of spaces collapsed to
+// one and leading/trailing spaces dropped.
+void AppendWithoutExtraSpaces(std::string& out, const std::string& s) {
+  bool in_space = false;
+  bool empty = true;
+  for (char c : s) {
+    if (c != ' ') {
+      if (in_space && !empty) out += ' ';
+      out += c;
+      in_space = false;
+      empty = false;
+    } else {
+      in_space = true;
+    }
+  }
+}
+
+}  // namespace
+
+void Multimap::Insert(Entry entry) {
+  if (entries_.capacity() == 0) entries_.reserve(kInitialCapacity);
+  auto itr = std::lower_bound(
+      entries_.begin(), entries_.end(), entry,
+      [](const Entry& a, const Entry& b) {
+        int cmp = a.key.compare(b.key);
+        return cmp < 0 || (cmp == 0 && a.value < b.value);
+      });
+  if (itr != entries_.end() && itr->key == entry.key &&
+      itr->value == entry.value) {
+    return;
+  }
+  entries_.insert(itr, std::move(entry));
+}
+
 void Multimap::Add(std::string key, std::string value) {
-  map_[key].insert(std::move(value));
-  keys_[ToLower(key)].insert(std::move(key));
+  Entry entry;
+  entry.lower_key = ToLower(key);
+  entry.key = std::move(key);
+  entry.value = std::move(value);
+  Insert(std::move(entry));
 }
 
 void Multimap::AddAll(const Multimap& headers) {
-  auto m = headers.map_;
-  for (auto& [key, values] : m) {
-    map_[key].insert(values.begin(), values.end());
-    keys_[ToLower(key)].insert(key);
+  if (entries_.empty()) {
+    entries_ = headers.entries_;
+    return;
   }
+  for (const auto& entry : headers.entries_) Insert(entry);
 }
 
 std::list<std::string> Multimap::ToHttpHeaders() const {
   std::list<std::string> headers;
-  for (auto& [key, values] : map_) {
-    for (auto& value : values) {
-      headers.push_back(key + ": " + value);
-    }
+  for (const auto& entry : entries_) {
+    headers.push_back(entry.key + ": " + entry.value);
   }
   return headers;
 }
 
 bool Multimap::Contains(std::string_view key) const {
-  return keys_.find(ToLower(std::string(key))) != keys_.end();
+  for (const auto& entry : entries_) {
+    if (EqualsLower(entry.lower_key, key)) return true;
+  }
+  return false;
 }
 
 std::list<std::string> Multimap::Get(std::string_view key) const {
   std::list<std::string> result;
-
-  if (const auto i = keys_.find(ToLower(std::string(key))); i != keys_.cend()) {
-    for (auto& k : i->second) {
-      if (const auto j = map_.find(k); j != map_.cend()) {
-        result.insert(result.end(), j->second.begin(), j->second.cend());
-      }
-    }
+  for (const auto& entry : entries_) {
+    if (EqualsLower(entry.lower_key, key)) result.push_back(entry.value);
   }
   return result;
 }
 
 std::string Multimap::GetFront(std::string_view key) const {
-  std::list<std::string> values = Get(key);
-  return (values.size() > 0) ? values.front() : std::string();
+  for (const auto& entry : entries_) {
+    if (EqualsLower(entry.lower_key, key)) return entry.value;
+  }
+  return {};
 }
 
 std::list<std::string> Multimap::Keys() const {
-  std::list<std::string> keys;
-  for (const auto& [key, _] : keys_) keys.push_back(key);
-  return keys;
+  std::vector<std::string_view> lower_keys;
+  lower_keys.reserve(entries_.size());
+  for (const auto& entry : entries_) lower_keys.push_back(entry.lower_key);
+  std::sort(lower_keys.begin(), lower_keys.end());
+  lower_keys.erase(std::unique(lower_keys.begin(), lower_keys.end()),
+                   lower_keys.end());
+  return std::list<std::string>(lower_keys.begin(), lower_keys.end());
 }
 
-std::string removeExtraSpaces(const std::string& s) {
-  std::string result;
-  result.reserve(s.size());
-  bool inSpace = false;
-
-  for (char c : s) {
-    if (c != ' ') {
-      if (inSpace && !result.empty()) result += ' ';
-      result += c;
-      inSpace = false;
+void Multimap::GetCanonicalHeaders(std::string& signed_headers,
+                                   std::string& canonical_headers) const {
+  // SigV4 orders headers by lower-cased name; entries are ordered by the
+  // name as added, so sort views of them. A stable sort keeps values of one
+  // name in order.
+  std::vector<const Entry*> sorted;
+  sorted.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    if (entry.lower_key == "authorization" || entry.lower_key == "user-agent") {
+      continue;
+    }
+    sorted.push_back(&entry);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Entry* a, const Entry* b) {
+                     return a->lower_key < b->lower_key;
+                   });
+
+  const std::string* last_key = nullptr;
+  for (const Entry* entry : sorted) {
+    if (last_key != nullptr && *last_key == entry->lower_key) {
+      canonical_headers += ',';
     } else {
-      inSpace = true;
+      if (!signed_headers.empty()) {
+        signed_headers += ';';
+        canonical_headers += '\n';
+      }
+      signed_headers += entry->lower_key;
+      canonical_headers += entry->lower_key;
+      canonical_headers += ':';
+      last_key = &entry->lower_key;
     }
+    AppendWithoutExtraSpaces(canonical_headers, entry->value);
   }
-  return result;
 }
 
-void Multimap::GetCanonicalHeaders(std::string& signed_headers,
-                                   std::string& canonical_headers) const {
-  for (const auto& [k, values] : map_) {
-    std::string key = ToLower(k);
-    if ("authorization" == key || "user-agent" == key) continue;
-    if (!signed_headers.empty()) {
-      signed_headers += ";";
-      canonical_headers += "\n";
-    }
-    signed_headers += key;
-
-    std::string value;
-    for (const auto& v : values) {
-      if (!value.empty()) value += ",";
-      value += removeExtraSpaces(v);
-    }
-    canonical_headers += key;
-    canonical_headers += ":";
-    canonical_headers += value;
+void Multimap::GetCanonicalQueryString(std::string& buffer) const {
+  bool first = true;
+  for (const auto& entry : entries_) {
+    if (!first) buffer += '&';
+    first = false;
+    buffer += UriEncode(entry.key);
+    buffer += '=';
+    buffer += UriEncode(entry.value);
   }
 }
 
 std::string Multimap::GetCanonicalQueryString() const {
   std::string query_string;
-  query_string.reserve(map_.size() * 30);
-
-  for (auto& [key, values] : map_) {
-    for (auto& value : values) {
-      if (!query_string.empty()) query_string += "&";
-      query_string += UriEncode(key);
-      query_string += '=';
-      query_string += UriEncode(value);
-    }
-  }
+  query_string.reserve(entries_.size() * 30);
+  GetCanonicalQueryString(query_string);
   return query_string;
 }
 
@@ -0,0 +1,307 @@
+// MinIO C++ Library for Amazon S3 Compatible Cloud Storage
+// Copyright 2022-2024 MinIO, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "miniocpp/xml.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace minio::xml {
+
+namespace {
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+// DecodeReference writes the character referenced by the entity name, e.g.
+// "amp" or "#x41", to out and returns the byte count, or 0 if it is unknown.
+// The UTF-8 encoding is never longer than the reference it replaces.
+size_t DecodeReference(std::string_view name, char* out) {
+  static constexpr std::pair<std::string_view, char> kEntities[] = {
+      {"lt", '<'}, {"gt", '>'}, {"amp", '&'}, {"quot", '"'}, {"apos", '\''}};
+  for (const auto& [entity, c] : kEntities) {
+    if (name == entity) {
+      *out = c;
+      return 1;
+    }
+  }
+  if (name.size() < 2 || name[0] != '#') return 0;
+
+  bool hex = name[1] == 'x';
+  std::string_view digits = name.substr(hex ? 2 : 1);
+  if (digits.empty() || digits.size() > 8) return 0;
+  uint32_t cp = 0;
+  for (char c : digits) {
+    uint32_t d;
+    if (c >= '0' && c <= '9') {
+      d = static_cast<uint32_t>(c - '0');
+    } else if (hex && c >= 'a' && c <= 'f') {
+      d = static_cast<uint32_t>(c - 'a' + 10);
+    } else if (hex && c >= 'A' && c <= 'F') {
+      d = static_cast<uint32_t>(c - 'A' + 10);
+    } else {
+      return 0;
+    }
+    cp = cp * (hex ? 16 : 10) + d;
+  }
+  if (cp == 0 || cp > 0x10FFFF) return 0;
+
+  if (cp < 0x80) {
+    out[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  out[0] = static_cast<char>(0xF0 | (cp >> 18));
+  out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+}  // namespace
+
+Reader::Reader(char* data, size_t size)
+    : closed_(true), pos_(data), end_(data + size) {}
+
+Reader::Reader() = default;
+
+void Reader::Feed(std::string_view data) {
+  if (pos_ != nullptr) {
+    buffer_.erase(0, static_cast<size_t>(pos_ - &buffer_[0]));
+  }
+  buffer_.append(data);
+  pos_ = &buffer_[0];
+  end_ = pos_ + buffer_.size();
+}
+
+void Reader::Close() {
+  closed_ = true;
+  if (pos_ == nullptr) Feed({});
+}
+
+std::string_view Reader::Path(size_t depth) const {
+  if (depth >= offsets_.size()) return {};
+  return std::string_view(path_).substr(offsets_[depth]);
+}
+
+Reader::Event Reader::Fail(const char* error) {
+  error_ = error;
+  name_ = text_ = {};
+  return Event::kError;
+}
+
+// Incomplete reports a construct cut off by the end of the bytes fed so far;
+// it is an error only once the document is closed.
+Reader::Event Reader::Incomplete(const char* error) {
+  return closed_ ? Fail(error) : Event::kMore;
+}
+
+// Find returns the position past the next terminator from from, or null.
+char* Reader::Find(char* from, std::string_view terminator) const {
+  std::string_view rest(from, static_cast<size_t>(end_ - from));
+  size_t i = rest.find(terminator);
+  if (i == std::string_view::npos) return nullptr;
+  return from + i + terminator.size();
+}
+
+// Decode replaces references and line breaks in [begin, end) in place and
+// returns the result, which is never longer.
+std::string_view Reader::Decode(char* begin, char* end) {
+  char* r = begin;
+  while (r < end && *r != '&' && *r != '\r') ++r;
+  char* w = r;
+  while (r < end) {
+    char c = *r;
+    if (c == '\r') {
+      *w++ = '\n';  // Both "\r\n" and a lone '\r' end a line.
+      r += (r + 1 < end && r[1] == '\n') ? 2 : 1;
+      continue;
+    }
+    if (c == '&') {
+      size_t limit = std::min<size_t>(static_cast<size_t>(end - r), 12);
+      auto semi = static_cast<char*>(std::memchr(r, ';', limit));
+      if (semi != nullptr) {
+        std::string_view name(r + 1, static_cast<size_t>(semi - r - 1));
+        if (size_t n = DecodeReference(name, w)) {
+          w += n;
+          r = semi + 1;
+          continue;
+        }
+      }
+    }
+    *w++ = c;  // Unknown references are kept as they are.
+    ++r;
+  }
+  return std::string_view(begin, static_cast<size_t>(w - begin));
+}
+
+void Reader::Push(std::string_view name) {
+  if (!offsets_.empty()) path_ += '/';
+  offsets_.push_back(path_.size());
+  path_.append(name);
+}
+
+Reader::Event Reader::Next() {
+  if (error_ != nullptr) return Event::kError;
+
+  if (close_) {
+    close_ = false;
+    pop_ = true;
+    name_ = std::string_view(path_).substr(offsets_.back());
+    return Event::kEnd;
+  }
+  if (pop_) {
+    pop_ = false;
+    size_t offset = offsets_.back();
+    offsets_.pop_back();
+    path_.resize(offset > 0 ? offset - 1 : 0);
+  }
+
+  while (pos_ < end_) {
+    if (*pos_ != '<') {
+      auto lt = static_cast<char*>(
+          std::memchr(pos_, '<', static_cast<size_t>(end_ - pos_)));
+      if (lt == nullptr && !closed_) return Event::kMore;
+      char* begin = pos_;
+      pos_ = lt != nullptr ? lt : end_;
+      if (offsets_.empty()) {
+        for (char* p = begin; p < pos_; ++p) {
+          if (!IsSpace(*p)) return Fail("text outside of document element");
+        }
+        continue;
+      }
+      text_ = Decode(begin, pos_);
+      name_ = std::string_view(path_).substr(offsets_.back());
+      return Event::kText;
+    }
+
+    std::string_view rest(pos_, static_cast<size_t>(end_ - pos_));
+    if (rest.size() < 9 && !closed_) {
+      // Too short to tell a CDATA section or comment from a tag.
+      if (std::string_view("<![CDATA[").substr(0, rest.size()) == rest ||
+          std::string_view("<!--").substr(0, rest.size()) == rest) {
+        return Event::kMore;
+      }
+    }
+    if (rest.compare(0, 4, "<!--") == 0) {
+      char* next = Find(pos_ + 4, "-->");
+      if (next == nullptr) return Incomplete("unterminated comment");
+      pos_ = next;
+      continue;
+    }
+    if (rest.compare(0, 9, "<![CDATA[") == 0) {
+      char* begin = pos_ + 9;
+      char* next = Find(begin, "]]>");
+      if (next == nullptr) return Incomplete("unterminated CDATA section");
+      if (offsets_.empty()) return Fail("CDATA outside of document element");
+      pos_ = next;
+      if (next - 3 == begin) continue;
+      text_ = std::string_view(begin, static_cast<size_t>(next - 3 - begin));
+      name_ = std::string_view(path_).substr(offsets_.back());
+      return Event::kText;
+    }
+    if (rest.compare(0, 2, "<?") == 0) {
+      char* next = Find(pos_ + 2, "?>");
+      if (next == nullptr) {
+        return Incomplete("unterminated processing instruction");
+      }
+      pos_ = next;
+      continue;
+    }
+    if (rest.compare(0, 2, "<!") == 0) {
+      // DOCTYPE, possibly with an internal subset in brackets.
+      int brackets = 0;
+      char* p = pos_ + 2;
+      for (; p < end_; ++p) {
+        if (*p == '[') brackets++;
+        if (*p == ']') brackets--;
+        if (*p == '>' && brackets <= 0) break;
+      }
+      if (p == end_) return Incomplete("unterminated declaration");
+      pos_ = p + 1;
+      continue;
+    }
+
+    if (rest.compare(0, 2, "</") == 0) {
+      char* begin = pos_ + 2;
+      auto gt = static_cast<char*>(
+          std::memchr(begin, '>', static_cast<size_t>(end_ - begin)));
+      if (gt == nullptr) return Incomplete("unterminated end tag");
+      char* last = gt;
+      while (last > begin && IsSpace(last[-1])) --last;
+      std::string_view name(begin, static_cast<size_t>(last - begin));
+      if (offsets_.empty() ||
+          std::string_view(path_).substr(offsets_.back()) != name) {
+        return Fail("mismatched end tag");
+      }
+      pos_ = gt + 1;
+      pop_ = true;
+      name_ = name;
+      return Event::kEnd;
+    }
+
+    char* begin = pos_ + 1;
+    char* p = begin;
+    while (p < end_ && !IsSpace(*p) && *p != '/' && *p != '>') ++p;
+    if (p == end_) return Incomplete("unterminated start tag");
+    if (p == begin) return Fail("invalid start tag");
+    std::string_view name(begin, static_cast<size_t>(p - begin));
+    // Skip attributes; quoted values may contain '>'.
+    char quote = 0;
+    for (; p < end_; ++p) {
+      if (quote != 0) {
+        if (*p == quote) quote = 0;
+      } else if (*p == '"' || *p == '\'') {
+        quote = *p;
+      } else if (*p == '>') {
+        break;
+      }
+    }
+    if (p == end_) return Incomplete("unterminated start tag");
+    if (offsets_.empty() && has_root_) {
+      return Fail("multiple document elements");
+    }
+    has_root_ = true;
+    close_ = p[-1] == '/';
+    pos_ = p + 1;
+    Push(name);
+    name_ = name;
+    return Event::kStart;
+  }
+
+  if (!closed_) return Event::kMore;
+  if (!offsets_.empty()) return Fail("unexpected end of document");
+  if (!has_root_) return Fail("no document element");
+  name_ = text_ = {};
+  return Event::kEof;
+}
+
+}  // namespace minio::xml
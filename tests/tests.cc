@@ -15,14 +15,19 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <httplib.h>
 #include <miniocpp/args.h>
 #include <miniocpp/client.h>
+#include <miniocpp/coro.h>
+#include <miniocpp/executor.h>
 #include <miniocpp/http.h>
 #include <miniocpp/providers.h>
 #include <miniocpp/request.h>
 #include <miniocpp/response.h>
 #include <miniocpp/result.h>
 #include <miniocpp/select.h>
+#include <miniocpp/signer.h>
+#include <miniocpp/statcache.h>
 #include <miniocpp/types.h>
 
 using minio::Result;
@@ -30,6 +35,7 @@ using minio::Result;
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
@@ -40,14 +46,25 @@ using minio::Result;
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <random>
+#include <set>
 #include <sstream>
 #include <stdexcept>
 #include <streambuf>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 thread_local static std::mt19937 rg{std::random_device{}()};
 
@@ -351,6 +368,137 @@ class Tests {
     }
   }
 
+  void StatObjectCache() {
+    std::cout << "StatObjectCache()" << std::endl;
+
+    std::string object_name = RandObjectName();
+    auto put = [&](const std::string& data) {
+      std::stringstream ss(data);
+      minio::s3::PutObjectArgs args(ss, static_cast<uint64_t>(data.length()),
+                                    0);
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      auto resp = client_.PutObject(args);
+      if (!resp) {
+        throw std::runtime_error("PutObject(): " + resp.error().String());
+      }
+    };
+    auto stat = [&]() -> size_t {
+      minio::s3::StatObjectArgs args;
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      auto resp = client_.StatObject(args);
+      if (!resp) {
+        throw std::runtime_error("StatObject(): " + resp.error().String());
+      }
+      return resp->size;
+    };
+
+    auto cache = std::make_shared<minio::s3::StatCache>();
+    client_.SetStatCache(cache);
+    try {
+      put("StatObjectCache()");
+      stat();
+      stat();
+      auto stats = cache->Stats();
+      if (stats.misses != 1 || stats.hits != 1 || stats.entries != 1) {
+        throw std::runtime_error("StatObjectCache(): expected 1 miss, 1 hit");
+      }
+
+      // The client's own write drops the entry.
+      put("StatObjectCache() overwritten");
+      if (stat() != std::string("StatObjectCache() overwritten").size()) {
+        throw std::runtime_error("StatObjectCache(): stale size after write");
+      }
+
+      // Expired entries are revalidated with If-None-Match.
+      cache->SetTtl(std::chrono::seconds(0));
+      stat();
+      stats = cache->Stats();
+      if (stats.revalidations != 1 || stats.not_modified != 1) {
+        throw std::runtime_error("StatObjectCache(): expected a 304");
+      }
+      client_.SetStatCache(nullptr);
+      RemoveObject(bucket_name_, object_name);
+    } catch (const std::runtime_error&) {
+      client_.SetStatCache(nullptr);
+      RemoveObject(bucket_name_, object_name);
+      throw;
+    }
+  }
+
+#ifdef MINIO_CPP_HAS_COROUTINES
+  minio::s3::coro::Task<void> CoroutineRoundTrip(std::string object_name) {
+    namespace coro = minio::s3::coro;
+
+    std::string data = "Coroutines()";
+    std::stringstream ss(data);
+    minio::s3::PutObjectArgs pargs(ss, static_cast<uint64_t>(data.length()),
+                                   0);
+    pargs.bucket = bucket_name_;
+    pargs.object = object_name;
+    auto put_resp = co_await coro::PutObject(client_, std::move(pargs));
+    if (!put_resp) {
+      throw std::runtime_error("PutObject(): " + put_resp.error().String());
+    }
+
+    minio::s3::StatObjectArgs sargs;
+    sargs.bucket = bucket_name_;
+    sargs.object = object_name;
+    auto stat_resp = co_await coro::StatObject(client_, std::move(sargs));
+    if (!stat_resp) {
+      throw std::runtime_error("StatObject(): " + stat_resp.error().String());
+    }
+
+    std::vector<char> buf(data.size());
+    minio::s3::GetObjectArgs gargs;
+    gargs.bucket = bucket_name_;
+    gargs.object = object_name;
+    gargs.buf = buf.data();
+    gargs.size = buf.size();
+    auto get_resp = co_await coro::GetObject(client_, std::move(gargs));
+    if (!get_resp) {
+      throw std::runtime_error("GetObject(): " + get_resp.error().String());
+    }
+    if (std::string(buf.data(), get_resp->size) != data) {
+      throw std::runtime_error("GetObject(): expected: " + data + "; got: " +
+                               std::string(buf.data(), get_resp->size));
+    }
+
+    minio::s3::ListObjectsArgs largs;
+    largs.bucket = bucket_name_;
+    largs.prefix = object_name;
+    auto list_resp = co_await coro::ListObjectsPage(client_, std::move(largs));
+    if (!list_resp) {
+      throw std::runtime_error("ListObjects(): " + list_resp.error().String());
+    }
+    if (list_resp->contents.size() != 1) {
+      throw std::runtime_error("ListObjects(): expected: 1; got: " +
+                               std::to_string(list_resp->contents.size()));
+    }
+
+    minio::s3::RemoveObjectsApiArgs rargs;
+    rargs.bucket = bucket_name_;
+    rargs.objects.push_back(minio::s3::DeleteObject{object_name});
+    auto rm_resp = co_await coro::RemoveObjects(client_, std::move(rargs));
+    if (!rm_resp) {
+      throw std::runtime_error("RemoveObjects(): " + rm_resp.error().String());
+    }
+  }
+
+  void Coroutines() {
+    std::cout << "Coroutines()" << std::endl;
+
+    std::string object_name = RandObjectName();
+    try {
+      minio::s3::coro::Start(CoroutineRoundTrip(object_name)).get();
+    } catch (const std::runtime_error&) {
+      RemoveObject(bucket_name_, object_name);
+      throw;
+    }
+  }
+#endif
+
   void RemoveObject() {
     std::cout << "RemoveObject()" << std::endl;
 
@@ -412,6 +560,25 @@ class Tests {
             " bytes; got " + std::to_string(length) + " bytes");
       }
       std::filesystem::remove(filename);
+
+      // Parallel ranged download written at offsets.
+      args.part_size = 4;
+      args.max_inflight_parts = 3;
+      resp = client_.DownloadObject(args);
+      if (!resp) {
+        throw std::runtime_error("DownloadObject(): " + resp.error().String());
+      }
+      std::ifstream pfile(filename, std::ios::binary);
+      std::string got((std::istreambuf_iterator<char>(pfile)),
+                      std::istreambuf_iterator<char>());
+      pfile.close();
+      std::filesystem::remove(filename);
+      if (data != got) {
+        throw std::runtime_error("DownloadObject(): parallel expected " +
+                                 std::to_string(data.length()) +
+                                 " bytes; got " + std::to_string(got.length()) +
+                                 " bytes");
+      }
       RemoveObject(bucket_name_, object_name);
     } catch (const std::runtime_error&) {
       RemoveObject(bucket_name_, object_name);
@@ -452,6 +619,57 @@ class Tests {
         throw std::runtime_error("GetObject(): expected: " + data +
                                  "; got: " + content);
       }
+
+      // Receive into a caller buffer larger than the object: a short read.
+      std::vector<char> buf(data.size() + 16);
+      minio::s3::GetObjectArgs buf_args;
+      buf_args.bucket = bucket_name_;
+      buf_args.object = object_name;
+      buf_args.buf = buf.data();
+      buf_args.size = buf.size();
+      auto buf_resp = client_.GetObject(buf_args);
+      if (!buf_resp) {
+        throw std::runtime_error("GetObject(): " + buf_resp.error().String());
+      }
+      if (buf_resp->size != data.size() ||
+          data != std::string(buf.data(), buf_resp->size)) {
+        throw std::runtime_error("GetObject(): buffer expected: " + data +
+                                 "; got: " +
+                                 std::string(buf.data(), buf_resp->size));
+      }
+
+      // A buffer smaller than the object must fail rather than truncate.
+      buf_args.size = data.size() - 1;
+      if (client_.GetObject(buf_args)) {
+        throw std::runtime_error("GetObject(): expected buffer overflow error");
+      }
+
+      // Parallel ranged GET, reassembled into the buffer and in order into
+      // the data function.
+      buf_args.size = buf.size();
+      buf_args.part_size = 4;
+      buf_args.max_inflight_parts = 2;
+      std::fill(buf.begin(), buf.end(), '\0');
+      buf_resp = client_.GetObject(buf_args);
+      if (!buf_resp) {
+        throw std::runtime_error("GetObject(): " + buf_resp.error().String());
+      }
+      if (data != std::string(buf.data(), buf_resp->size)) {
+        throw std::runtime_error("GetObject(): parallel buffer expected: " +
+                                 data + "; got: " +
+                                 std::string(buf.data(), buf_resp->size));
+      }
+      content.clear();
+      args.part_size = 4;
+      args.max_inflight_parts = 2;
+      resp = client_.GetObject(args);
+      if (!resp) {
+        throw std::runtime_error("GetObject(): " + resp.error().String());
+      }
+      if (data != content) {
+        throw std::runtime_error("GetObject(): parallel expected: " + data +
+                                 "; got: " + content);
+      }
       RemoveObject(bucket_name_, object_name);
     } catch (const std::runtime_error&) {
       RemoveObject(bucket_name_, object_name);
@@ -497,6 +715,32 @@ class Tests {
             "ListObjects(): expected: " + std::to_string(object_names.size()) +
             "; got: " + std::to_string(c));
       }
+
+      // Partitioned listing, in key order and unordered.
+      for (bool unordered : {false, true}) {
+        args.recursive = true;
+        args.max_inflight_partitions = 4;
+        args.unordered = unordered;
+        std::vector<std::string> names;
+        for (auto result = client_.ListObjects(args); result; result++) {
+          names.emplace_back((*result).name);
+        }
+        if (!unordered && !std::is_sorted(names.begin(), names.end())) {
+          throw std::runtime_error("<Parallel> ListObjects(): out of order");
+        }
+        c = 0;
+        for (auto& name : names) {
+          if (std::find(object_names.begin(), object_names.end(), name) !=
+              object_names.end()) {
+            c++;
+          }
+        }
+        if (c != object_names.size()) {
+          throw std::runtime_error("<Parallel> ListObjects(): expected: " +
+                                   std::to_string(object_names.size()) +
+                                   "; got: " + std::to_string(c));
+        }
+      }
       RemoveObjects(object_names);
     } catch (const std::runtime_error&) {
       RemoveObjects(object_names);
@@ -543,6 +787,72 @@ class Tests {
       }
       RemoveObject(bucket_name_, object_name);
     }
+
+    // Multipart upload carrying a FULL_OBJECT CRC64NVME, read back verified.
+    {
+      std::string object_name = RandObjectName();
+      size_t size = 11534337;  // (11MiB + 1) bytes
+      RandCharStream stream(size);
+      minio::s3::PutObjectArgs args(stream, static_cast<uint64_t>(size),
+                                    5242880);
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      args.checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
+      auto resp = client_.PutObject(args);
+      if (!resp || resp->checksum_crc64nvme.empty()) {
+        RemoveObject(bucket_name_, object_name);
+        throw std::runtime_error("<Checksum> PutObject(): " +
+                                 (resp ? std::string("checksum is missing")
+                                       : resp.error().String()));
+      }
+      minio::s3::GetObjectArgs get_args;
+      get_args.bucket = bucket_name_;
+      get_args.object = object_name;
+      get_args.verify_checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
+      get_args.datafunc = [](minio::http::DataFunctionArgs) { return true; };
+      auto get_resp = client_.GetObject(get_args);
+      RemoveObject(bucket_name_, object_name);
+      if (!get_resp) {
+        throw std::runtime_error("<Checksum> GetObject(): " +
+                                 get_resp.error().String());
+      }
+    }
+
+    // aws-chunked bodies, signed per chunk or with an unsigned trailer.
+    const std::array<std::pair<minio::s3::PayloadSigning,
+                               minio::s3::ChecksumAlgorithm>,
+                     3>
+        modes = {{
+            {minio::s3::PayloadSigning::kStreaming,
+             minio::s3::ChecksumAlgorithm::kNone},
+            {minio::s3::PayloadSigning::kStreaming,
+             minio::s3::ChecksumAlgorithm::kCrc32c},
+            {minio::s3::PayloadSigning::kUnsignedTrailer,
+             minio::s3::ChecksumAlgorithm::kCrc64Nvme},
+        }};
+    for (const auto& [signing, checksum] : modes) {
+      std::string object_name = RandObjectName();
+      size_t size = 200000;
+      RandCharStream stream(size);
+      minio::s3::PutObjectArgs args(stream, static_cast<uint64_t>(size), 0);
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      args.payload_signing = signing;
+      args.checksum = checksum;
+      auto resp = client_.PutObject(args);
+      if (!resp) {
+        throw std::runtime_error("<Chunked> PutObject(): " +
+                                 resp.error().String());
+      }
+      minio::s3::StatObjectArgs stat_args;
+      stat_args.bucket = bucket_name_;
+      stat_args.object = object_name;
+      auto stat = client_.StatObject(stat_args);
+      RemoveObject(bucket_name_, object_name);
+      if (!stat || stat->size != size) {
+        throw std::runtime_error("<Chunked> PutObject(): size mismatch");
+      }
+    }
   }
 
   void CopyObject() {
@@ -581,6 +891,138 @@ class Tests {
     }
   }
 
+  void TransferObject() {
+    std::cout << "TransferObject()" << std::endl;
+
+    std::string object_name = RandObjectName();
+    std::string src_object_name = RandObjectName();
+    std::string data(6 * 1024 * 1024 + 17, 't');
+    std::stringstream ss(data);
+    minio::s3::PutObjectArgs args(ss, static_cast<uint64_t>(data.length()), 0);
+    args.bucket = bucket_name_;
+    args.object = src_object_name;
+    args.content_type = "application/octet-stream";
+    auto resp = client_.PutObject(args);
+    if (!resp) {
+      throw std::runtime_error("PutObject(): " + resp.error().String());
+    }
+
+    try {
+      minio::s3::CopySource source;
+      source.bucket = bucket_name_;
+      source.object = src_object_name;
+      minio::s3::TransferObjectArgs args;
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      args.source = source;
+      args.part_size = 5 * 1024 * 1024;
+      auto resp = client_.TransferObject(client_, args);
+      if (!resp) {
+        throw std::runtime_error("TransferObject(): " + resp.error().String());
+      }
+
+      minio::s3::StatObjectArgs sargs;
+      sargs.bucket = bucket_name_;
+      sargs.object = object_name;
+      auto sresp = client_.StatObject(sargs);
+      if (!sresp) {
+        throw std::runtime_error("StatObject(): " + sresp.error().String());
+      }
+      if (sresp->size != data.length()) {
+        throw std::runtime_error("TransferObject(): expected size " +
+                                 std::to_string(data.length()) + ", got " +
+                                 std::to_string(sresp->size));
+      }
+
+      // Resuming an upload of a source that has changed since aborts it.
+      minio::s3::CreateMultipartUploadArgs cmu_args;
+      cmu_args.bucket = bucket_name_;
+      cmu_args.object = object_name;
+      auto cmu_resp = client_.CreateMultipartUpload(cmu_args);
+      if (!cmu_resp) {
+        throw std::runtime_error("CreateMultipartUpload(): " +
+                                 cmu_resp.error().String());
+      }
+      std::string upload_id = cmu_resp->upload_id;
+      args.source.match_etag = "00000000000000000000000000000000";
+      resp = client_.TransferObject(client_, args, upload_id);
+      if (resp || !upload_id.empty()) {
+        throw std::runtime_error(
+            "TransferObject(): resumed upload of a changed source");
+      }
+      RemoveObject(bucket_name_, src_object_name);
+      RemoveObject(bucket_name_, object_name);
+    } catch (const std::runtime_error&) {
+      RemoveObject(bucket_name_, src_object_name);
+      RemoveObject(bucket_name_, object_name);
+      throw;
+    }
+  }
+
+  void UploadPartStreamed() {
+    std::cout << "UploadPartStreamed()" << std::endl;
+
+    std::string object_name = RandObjectName();
+    std::string data(5 * 1024 * 1024 + 3, 's');
+
+    minio::s3::CreateMultipartUploadArgs cargs;
+    cargs.bucket = bucket_name_;
+    cargs.object = object_name;
+    auto cresp = client_.CreateMultipartUpload(cargs);
+    if (!cresp) {
+      throw std::runtime_error("CreateMultipartUpload(): " +
+                               cresp.error().String());
+    }
+
+    try {
+      std::stringstream ss(data);
+      minio::s3::UploadPartArgs args;
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      args.upload_id = cresp->upload_id;
+      args.part_number = 1;
+      args.bodyfunc = minio::http::StreamBody(ss);
+      args.part_size = data.length();
+      auto resp = client_.UploadPart(args);
+      if (!resp) {
+        throw std::runtime_error("UploadPart(): " + resp.error().String());
+      }
+
+      minio::s3::CompleteMultipartUploadArgs args2;
+      args2.bucket = bucket_name_;
+      args2.object = object_name;
+      args2.upload_id = cresp->upload_id;
+      args2.parts.push_back(minio::s3::Part(1, resp->etag));
+      auto resp2 = client_.CompleteMultipartUpload(args2);
+      if (!resp2) {
+        throw std::runtime_error("CompleteMultipartUpload(): " +
+                                 resp2.error().String());
+      }
+
+      minio::s3::StatObjectArgs sargs;
+      sargs.bucket = bucket_name_;
+      sargs.object = object_name;
+      auto sresp = client_.StatObject(sargs);
+      if (!sresp) {
+        throw std::runtime_error("StatObject(): " + sresp.error().String());
+      }
+      if (sresp->size != data.length()) {
+        throw std::runtime_error("UploadPartStreamed(): expected size " +
+                                 std::to_string(data.length()) + ", got " +
+                                 std::to_string(sresp->size));
+      }
+      RemoveObject(bucket_name_, object_name);
+    } catch (const std::runtime_error&) {
+      minio::s3::AbortMultipartUploadArgs aargs;
+      aargs.bucket = bucket_name_;
+      aargs.object = object_name;
+      aargs.upload_id = cresp->upload_id;
+      (void)client_.AbortMultipartUpload(aargs);
+      RemoveObject(bucket_name_, object_name);
+      throw;
+    }
+  }
+
   void UploadObject() {
     std::cout << "UploadObject()" << std::endl;
 
@@ -601,6 +1043,43 @@ class Tests {
     }
     std::filesystem::remove(filename);
     RemoveObject(bucket_name_, object_name);
+
+    // Multipart upload carrying a FULL_OBJECT CRC64NVME, read back verified.
+    {
+      std::string filename = RandObjectName();
+      size_t size = 11534337;  // (11MiB + 1) bytes
+      RandCharStream stream(size);
+      std::ofstream file(filename, std::ios::binary);
+      file << stream.rdbuf();
+      file.close();
+
+      std::string object_name = RandObjectName();
+      minio::s3::UploadObjectArgs args;
+      args.bucket = bucket_name_;
+      args.object = object_name;
+      args.filename = filename;
+      args.part_size = 5242880;
+      args.checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
+      auto resp = client_.UploadObject(args);
+      std::filesystem::remove(filename);
+      if (!resp || resp->checksum_crc64nvme.empty()) {
+        RemoveObject(bucket_name_, object_name);
+        throw std::runtime_error("<Checksum> UploadObject(): " +
+                                 (resp ? std::string("checksum is missing")
+                                       : resp.error().String()));
+      }
+      minio::s3::GetObjectArgs get_args;
+      get_args.bucket = bucket_name_;
+      get_args.object = object_name;
+      get_args.verify_checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
+      get_args.datafunc = [](minio::http::DataFunctionArgs) { return true; };
+      auto get_resp = client_.GetObject(get_args);
+      RemoveObject(bucket_name_, object_name);
+      if (!get_resp) {
+        throw std::runtime_error("<Checksum> UploadObject(): " +
+                                 get_resp.error().String());
+      }
+    }
   }
 
   void RemoveObjects() {
@@ -625,6 +1104,37 @@ class Tests {
       RemoveObjects(object_names);
       throw;
     }
+
+    // Three batches in flight at once; the key needs XML escaping.
+    std::string object_name = RandObjectName() + "&<a>";
+    std::stringstream ss;
+    minio::s3::PutObjectArgs put_args(ss, 0, 0);
+    put_args.bucket = bucket_name_;
+    put_args.object = object_name;
+    auto put_resp = client_.PutObject(put_args);
+    if (!put_resp) {
+      throw std::runtime_error("PutObject(): " + put_resp.error().String());
+    }
+    size_t count = 0;
+    minio::s3::RemoveObjectsArgs args;
+    args.bucket = bucket_name_;
+    args.max_inflight_batches = 3;
+    args.func = [&](minio::s3::DeleteObject& object) -> bool {
+      if (count == 2500) return false;
+      object.name = (count++ == 1234) ? object_name : RandObjectName();
+      return true;
+    };
+    for (auto result = client_.RemoveObjects(args); result; result++) {
+      throw std::runtime_error("RemoveObjects(): " + (*result).object_name +
+                               ": " + (*result).message);
+    }
+    minio::s3::StatObjectArgs stat_args;
+    stat_args.bucket = bucket_name_;
+    stat_args.object = object_name;
+    if (client_.StatObject(stat_args)) {
+      RemoveObject(bucket_name_, object_name);
+      throw std::runtime_error("RemoveObjects(): object is not removed");
+    }
   }
 
   void SelectObjectContent() {
@@ -1707,10 +2217,1028 @@ void TestUrlParse() noexcept(false) {
   }
 }
 
+// LoopbackServer answers GET and PUT requests with handler, by default "ok",
+// on an ephemeral 127.0.0.1 port and records the client port of each request,
+// i.e. the connection it came on.
+class LoopbackServer {
+ private:
+  std::unique_ptr<httplib::Server> server_;
+  std::thread thread_;
+  int port_ = -1;
+  mutable std::mutex mutex_;
+  std::set<int> client_ports_;
+
+ public:
+  explicit LoopbackServer(std::unique_ptr<httplib::Server> server,
+                          httplib::Server::Handler handler = nullptr)
+      : server_(std::move(server)) {
+    if (!server_->is_valid()) {
+      throw std::runtime_error("LoopbackServer: invalid server");
+    }
+    auto handle = [this, handler](const httplib::Request& req,
+                                  httplib::Response& res) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        client_ports_.insert(req.remote_port);
+      }
+      if (handler) {
+        handler(req, res);
+      } else {
+        res.set_content("ok", "text/plain");
+      }
+    };
+    server_->Get(".*", handle);
+    server_->Put(".*", handle);
+    port_ = server_->bind_to_any_port("127.0.0.1");
+    if (port_ < 0) {
+      throw std::runtime_error("LoopbackServer: unable to bind");
+    }
+    thread_ = std::thread([this]() { server_->listen_after_bind(); });
+    server_->wait_until_ready();
+  }
+
+  ~LoopbackServer() {
+    server_->stop();
+    thread_.join();
+  }
+
+  unsigned int Port() const { return static_cast<unsigned int>(port_); }
+
+  minio::http::Url Url(bool https) const {
+    return minio::http::Url(https, "127.0.0.1",
+                            static_cast<unsigned int>(port_), "/object", "");
+  }
+
+  // Connections returns number of distinct connections requests came on.
+  size_t Connections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return client_ports_.size();
+  }
+};  // class LoopbackServer
+
+// Back-to-back requests through a ConnectionPool share one keep-alive
+// connection; a zero idle limit or an expired idle timeout opens new ones.
+void TestConnectionPool() noexcept(false) {
+  std::cout << "TestConnectionPool()" << std::endl;
+
+  LoopbackServer server(std::make_unique<httplib::Server>());
+  auto pool = std::make_shared<minio::http::ConnectionPool>();
+  auto get = [&]() {
+    minio::http::Request request(minio::http::Method::kGet, server.Url(false));
+    request.pool = pool;
+    minio::http::Response response = request.Execute();
+    if (!response || response.body != "ok") {
+      throw std::runtime_error("TestConnectionPool(): request failed; " +
+                               response.error);
+    }
+  };
+
+  for (int i = 0; i < 5; ++i) get();
+  if (server.Connections() != 1 || pool->IdleCount() != 1) {
+    throw std::runtime_error(
+        "TestConnectionPool(): expected 1 reused connection; got " +
+        std::to_string(server.Connections()) + " connections, " +
+        std::to_string(pool->IdleCount()) + " idle");
+  }
+
+  pool->SetMaxIdlePerHost(0);
+  if (pool->IdleCount() != 0) {
+    throw std::runtime_error("TestConnectionPool(): idle limit not applied");
+  }
+  get();
+  get();
+  if (server.Connections() != 3) {
+    throw std::runtime_error(
+        "TestConnectionPool(): expected 3 connections without reuse; got " +
+        std::to_string(server.Connections()));
+  }
+
+  pool->SetMaxIdlePerHost(minio::http::ConnectionPool::kDefaultMaxIdlePerHost);
+  pool->SetIdleTimeout(std::chrono::seconds(0));
+  get();
+  get();
+  if (server.Connections() != 5) {
+    throw std::runtime_error(
+        "TestConnectionPool(): expected idle connections to expire; got " +
+        std::to_string(server.Connections()) + " connections");
+  }
+}
+
+// New HTTPS connections sharing a TlsContextCache resume the session of the
+// first one; clearing the cache forces a full handshake again.
+void TestTlsSessionResumption() noexcept(false) {
+  std::cout << "TestTlsSessionResumption()" << std::endl;
+
+  const std::string dir = MINIO_CPP_TESTS_DIR;
+  const std::string cert_file = dir + "/public.crt";
+  const std::string key_file = dir + "/private.key";
+  LoopbackServer server(std::make_unique<httplib::SSLServer>(
+      cert_file.c_str(), key_file.c_str()));
+  auto tls_cache = std::make_shared<minio::http::TlsContextCache>();
+  auto get = [&]() {
+    // Without a pool every request connects and handshakes anew.
+    minio::http::Request request(minio::http::Method::kGet, server.Url(true));
+    request.ssl_cert_file = cert_file;
+    request.tls_cache = tls_cache;
+    minio::http::Response response = request.Execute();
+    if (!response || response.body != "ok") {
+      throw std::runtime_error("TestTlsSessionResumption(): request failed; " +
+                               response.error);
+    }
+  };
+
+  for (int i = 0; i < 3; ++i) get();
+  if (server.Connections() != 3 || tls_cache->FullHandshakes() != 1 ||
+      tls_cache->ResumedHandshakes() != 2) {
+    throw std::runtime_error(
+        "TestTlsSessionResumption(): expected 1 full and 2 resumed "
+        "handshakes over 3 connections; got " +
+        std::to_string(tls_cache->FullHandshakes()) + " full, " +
+        std::to_string(tls_cache->ResumedHandshakes()) + " resumed over " +
+        std::to_string(server.Connections()) + " connections");
+  }
+
+  tls_cache->Clear();
+  get();
+  if (tls_cache->FullHandshakes() != 2) {
+    throw std::runtime_error(
+        "TestTlsSessionResumption(): session resumed after Clear()");
+  }
+}
+
+// A whole-object GET with checksum verification is verified when the body
+// is complete, and not when the caller cancels it part way.
+void TestGetObjectChecksumCancel() noexcept(false) {
+  std::cout << "TestGetObjectChecksumCancel()" << std::endl;
+
+  const std::string body(1024 * 1024, 'c');
+  LoopbackServer server(
+      std::make_unique<httplib::Server>(),
+      [&body](const httplib::Request&, httplib::Response& res) {
+        // Deliberately wrong, so a verified body fails.
+        res.set_header("x-amz-checksum-crc64nvme", "AAAAAAAAAAA=");
+        res.set_content(body, "application/octet-stream");
+      });
+  minio::s3::BaseClient client(minio::s3::BaseUrl(
+      "127.0.0.1:" + std::to_string(server.Port()), false));
+
+  auto get = [&](bool cancel) {
+    minio::s3::GetObjectArgs args;
+    args.bucket = "bucket";
+    args.object = "object";
+    args.verify_checksum = minio::s3::ChecksumAlgorithm::kCrc64Nvme;
+    args.datafunc = [cancel](minio::http::DataFunctionArgs) { return !cancel; };
+    return client.GetObject(args);
+  };
+
+  auto resp = get(true);
+  if (!resp) {
+    throw std::runtime_error("TestGetObjectChecksumCancel(): canceled GET: " +
+                             resp.error().String());
+  }
+  resp = get(false);
+  if (resp || resp.error().String().find("mismatch") == std::string::npos) {
+    throw std::runtime_error(
+        "TestGetObjectChecksumCancel(): complete GET not verified");
+  }
+}
+
+#ifdef __linux__
+// A signed aws-chunked upload through EventLoopTransport hashes its chunks
+// on the loop thread, while the executor's only worker is blocked waiting for
+// that very request; the loop thread must not wait for the worker.
+void TestAwsChunkedEventLoop() noexcept(false) {
+  std::cout << "TestAwsChunkedEventLoop()" << std::endl;
+
+  const size_t size = 2 * 1024 * 1024 + 5;
+  std::mutex mutex;
+  std::string decoded_length;
+  size_t received = 0;
+  LoopbackServer server(
+      std::make_unique<httplib::Server>(),
+      [&](const httplib::Request& req, httplib::Response& res) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          decoded_length = req.get_header_value("x-amz-decoded-content-length");
+          received = req.body.size();
+        }
+        res.set_header("ETag", "\"etag\"");
+      });
+
+  minio::creds::StaticProvider provider("minio", "minio123");
+  minio::s3::BaseClient client(
+      minio::s3::BaseUrl("127.0.0.1:" + std::to_string(server.Port()), false,
+                         "us-east-1"),
+      &provider);
+  auto executor = std::make_shared<minio::utils::Executor>(1);
+  client.SetExecutor(executor);
+  client.SetTransport(std::make_shared<minio::http::EventLoopTransport>(1));
+
+  std::string data(size, 'a');
+  std::stringstream ss(data);
+  minio::s3::PutObjectApiArgs args;
+  args.bucket = "bucket";
+  args.object = "object";
+  args.buf = nullptr;
+  args.size = size;
+  args.bodyfunc = minio::http::StreamBody(ss);
+  args.payload_signing = minio::s3::PayloadSigning::kStreaming;
+
+  auto future = executor->Submit([&]() { return client.PutObject(args); });
+  if (future.wait_for(std::chrono::seconds(60)) != std::future_status::ready) {
+    throw std::runtime_error("TestAwsChunkedEventLoop(): upload deadlocked");
+  }
+  auto resp = future.get();
+  if (!resp) {
+    throw std::runtime_error("TestAwsChunkedEventLoop(): " +
+                             resp.error().String());
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  if (decoded_length != std::to_string(size) || received <= size) {
+    throw std::runtime_error(
+        "TestAwsChunkedEventLoop(): expected an aws-chunked body of " +
+        std::to_string(size) + " bytes; got " + std::to_string(received) +
+        " encoded bytes, decoded length '" + decoded_length + "'");
+  }
+}
+
+// BaseClient::ExecuteAsync on an EventLoopTransport completes from the loop,
+// without an executor worker: the only one is busy waiting for the result.
+void TestExecuteAsync() noexcept(false) {
+  std::cout << "TestExecuteAsync()" << std::endl;
+
+  LoopbackServer server(std::make_unique<httplib::Server>());
+  minio::s3::BaseUrl base_url("127.0.0.1:" + std::to_string(server.Port()),
+                              false, "us-east-1");
+  minio::s3::BaseClient client(base_url);
+  auto executor = std::make_shared<minio::utils::Executor>(1);
+  client.SetExecutor(executor);
+  client.SetTransport(std::make_shared<minio::http::EventLoopTransport>(1));
+
+  auto future = executor->Submit([&client, &base_url]() {
+    auto req = std::make_shared<minio::s3::Request>(
+        minio::http::Method::kGet, "us-east-1", base_url,
+        minio::utils::Multimap(), minio::utils::Multimap());
+    req->bucket_name = "bucket";
+    req->object_name = "object";
+    std::promise<minio::Result<minio::s3::Response>> promise;
+    auto result = promise.get_future();
+    client.ExecuteAsync(req, [&promise](auto resp) {
+      promise.set_value(std::move(resp));
+    });
+    if (result.wait_for(std::chrono::seconds(30)) !=
+        std::future_status::ready) {
+      return std::string("request never completed");
+    }
+    auto resp = result.get();
+    return resp ? resp->data : resp.error().String();
+  });
+  if (future.wait_for(std::chrono::seconds(60)) != std::future_status::ready) {
+    throw std::runtime_error("TestExecuteAsync(): deadlocked");
+  }
+  std::string data = future.get();
+  if (data != "ok") {
+    throw std::runtime_error("TestExecuteAsync(): expected ok; got " + data);
+  }
+}
+
+// EarlyReplyServer answers the first request of each connection as soon as
+// its head is in, without reading the body: 403 to a PUT, "ok" otherwise.
+// It keeps the connection open and discards everything else sent on it.
+class EarlyReplyServer {
+ private:
+  int fd_ = -1;
+  unsigned int port_ = 0;
+  std::atomic<int> accepted_{0};
+  std::mutex mutex_;
+  std::vector<int> conns_;
+  std::vector<std::thread> threads_;
+  std::thread accept_thread_;
+
+  static void Serve(int fd) {
+    std::string in;
+    bool replied = false;
+    char buf[64 * 1024];
+    while (true) {
+      ssize_t n = recv(fd, buf, sizeof(buf), 0);
+      if (n <= 0) return;
+      if (replied) continue;
+      in.append(buf, static_cast<size_t>(n));
+      if (in.find("\r\n\r\n") == std::string::npos) continue;
+      replied = true;
+      std::string reply =
+          in.compare(0, 4, "PUT ") == 0
+              ? "HTTP/1.1 403 Forbidden\r\ncontent-length: 0\r\n\r\n"
+              : "HTTP/1.1 200 OK\r\ncontent-length: 2\r\n\r\nok";
+      if (send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0) return;
+    }
+  }
+
+ public:
+  EarlyReplyServer() {
+    fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (fd_ < 0 || bind(fd_, reinterpret_cast<sockaddr*>(&addr), len) != 0 ||
+        listen(fd_, 16) != 0 ||
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+      if (fd_ >= 0) close(fd_);
+      throw std::runtime_error("EarlyReplyServer: unable to listen");
+    }
+    port_ = ntohs(addr.sin_port);
+    accept_thread_ = std::thread([this]() {
+      while (true) {
+        int conn = accept(fd_, nullptr, nullptr);
+        if (conn < 0) return;
+        accepted_++;
+        std::lock_guard<std::mutex> lock(mutex_);
+        conns_.push_back(conn);
+        threads_.emplace_back(Serve, conn);
+      }
+    });
+  }
+
+  ~EarlyReplyServer() {
+    shutdown(fd_, SHUT_RDWR);
+    accept_thread_.join();
+    close(fd_);
+    for (int conn : conns_) shutdown(conn, SHUT_RDWR);
+    for (auto& thread : threads_) thread.join();
+    for (int conn : conns_) close(conn);
+  }
+
+  int Accepted() const { return accepted_; }
+
+  minio::http::Url Url() const {
+    return minio::http::Url(false, "127.0.0.1", port_, "/object", "");
+  }
+};  // class EarlyReplyServer
+
+// A connection whose request the server answered before the body was sent
+// is closed, not reused: the next request would be read as part of the body.
+void TestEventLoopEarlyReply() noexcept(false) {
+  std::cout << "TestEventLoopEarlyReply()" << std::endl;
+
+  EarlyReplyServer server;
+  auto transport = std::make_shared<minio::http::EventLoopTransport>(1);
+  auto run = [&](minio::http::Request request) {
+    std::promise<minio::http::Response> promise;
+    std::future<minio::http::Response> future = promise.get_future();
+    transport->Submit(std::move(request),
+                      [&promise](minio::http::Response response) {
+                        promise.set_value(std::move(response));
+                      });
+    if (future.wait_for(std::chrono::seconds(30)) !=
+        std::future_status::ready) {
+      throw std::runtime_error("TestEventLoopEarlyReply(): request hung");
+    }
+    return future.get();
+  };
+
+  // Far more than the socket buffers hold, so the reply comes mid-body.
+  std::string body(16 * 1024 * 1024, 'a');
+  minio::http::Request put(minio::http::Method::kPut, server.Url());
+  put.body = body;
+  minio::http::Response response = run(std::move(put));
+  if (response.status_code != 403) {
+    throw std::runtime_error(
+        "TestEventLoopEarlyReply(): expected 403 to the PUT; got " +
+        std::to_string(response.status_code) + " " + response.error);
+  }
+
+  response =
+      run(minio::http::Request(minio::http::Method::kGet, server.Url()));
+  if (response.status_code != 200 || response.body != "ok" ||
+      server.Accepted() != 2) {
+    throw std::runtime_error(
+        "TestEventLoopEarlyReply(): expected ok on a new connection; got " +
+        std::to_string(response.status_code) + " '" + response.body +
+        "' after " + std::to_string(server.Accepted()) + " connections");
+  }
+}
+#endif
+
+// A page failing in one key range of a parallel listing ends the listing
+// with an error item, after the items of the ranges before it.
+void TestParallelListingError() noexcept(false) {
+  std::cout << "TestParallelListingError()" << std::endl;
+
+  LoopbackServer server(
+      std::make_unique<httplib::Server>(),
+      [](const httplib::Request& req, httplib::Response& res) {
+        std::string prefix = req.get_param_value("prefix");
+        if (!req.get_param_value("delimiter").empty()) {
+          res.set_content(
+              "<ListBucketResult><Name>bucket</Name>"
+              "<IsTruncated>false</IsTruncated>"
+              "<CommonPrefixes><Prefix>a/</Prefix></CommonPrefixes>"
+              "<CommonPrefixes><Prefix>b/</Prefix></CommonPrefixes>"
+              "<CommonPrefixes><Prefix>c/</Prefix></CommonPrefixes>"
+              "</ListBucketResult>",
+              "application/xml");
+        } else if (prefix == "b/") {
+          res.status = 403;
+          res.set_content(
+              "<Error><Code>AccessDenied</Code>"
+              "<Message>Access Denied.</Message></Error>",
+              "application/xml");
+        } else {
+          res.set_content(
+              "<ListBucketResult><Name>bucket</Name>"
+              "<IsTruncated>false</IsTruncated><Contents><Key>" +
+                  prefix + "1</Key><Size>1</Size></Contents>"
+                  "</ListBucketResult>",
+              "application/xml");
+        }
+      });
+  minio::s3::BaseUrl base_url("127.0.0.1:" + std::to_string(server.Port()),
+                              false);
+  minio::s3::Client client(base_url);
+
+  minio::s3::ListObjectsArgs args;
+  args.bucket = "bucket";
+  args.recursive = true;
+  args.max_inflight_partitions = 4;
+  std::vector<std::string> names;
+  std::string error;
+  for (auto result = client.ListObjects(args); result; result++) {
+    const minio::s3::Item& item = *result;
+    if (!error.empty()) {
+      throw std::runtime_error("TestParallelListingError(): item after error");
+    }
+    if (item.error.empty()) {
+      names.emplace_back(item.name);
+    } else {
+      error = item.error;
+    }
+  }
+  if (names != std::vector<std::string>{"a/1"} ||
+      error.find("AccessDenied") == std::string::npos) {
+    throw std::runtime_error(
+        "TestParallelListingError(): expected a/1 and AccessDenied; got " +
+        std::to_string(names.size()) + " items, error '" + error + "'");
+  }
+}
+
+// StatCache answers repeated stats without a HEAD until the TTL passes, then
+// revalidates or drops the entry, keeps the most recently used entries and
+// drops all versions of an invalidated object. A stat that raced with an
+// invalidation of its object is not cached; one of another object is.
+void TestStatCache() noexcept(false) {
+  std::cout << "TestStatCache()" << std::endl;
+
+  auto cache = std::make_shared<minio::s3::StatCache>(2);
+  std::atomic<int> heads{0};
+  std::atomic<int> conditional{0};
+  LoopbackServer server(
+      std::make_unique<httplib::Server>(),
+      [&](const httplib::Request& req, httplib::Response& res) {
+        if (req.method != "HEAD") return;
+        heads++;
+        // Stats of these objects race with writes of the object "race".
+        if (req.path == "/bucket/race" || req.path == "/bucket/bystander") {
+          cache->Invalidate("bucket", "race");
+        }
+        if (req.get_header_value("If-None-Match") == "\"etag\"") {
+          conditional++;
+          res.status = 304;
+          return;
+        }
+        res.set_header("ETag", "\"etag\"");
+      });
+  minio::s3::BaseUrl base_url("127.0.0.1:" + std::to_string(server.Port()),
+                              false);
+  minio::s3::Client client(base_url);
+  client.SetStatCache(cache);
+
+  auto stat = [&](const std::string& object,
+                  const std::string& version_id = "") {
+    minio::s3::StatObjectArgs args;
+    args.bucket = "bucket";
+    args.object = object;
+    args.version_id = version_id;
+    auto resp = client.StatObject(args);
+    if (!resp) {
+      throw std::runtime_error("TestStatCache(): stat " + object +
+                               " failed; " + resp.error().String());
+    }
+    if (resp->etag != "etag") {
+      throw std::runtime_error("TestStatCache(): stat " + object +
+                               " returned ETag " + resp->etag);
+    }
+  };
+  auto expect = [&](const std::string& step, int want_heads,
+                    size_t want_entries) {
+    minio::s3::StatCacheStats stats = cache->Stats();
+    if (heads != want_heads || stats.entries != want_entries) {
+      throw std::runtime_error(
+          "TestStatCache(): " + step + ": expected " +
+          std::to_string(want_heads) + " HEADs, " +
+          std::to_string(want_entries) + " entries; got " +
+          std::to_string(heads) + ", " + std::to_string(stats.entries));
+    }
+  };
+
+  // LRU eviction order: a is used after b, so c evicts b.
+  stat("a");
+  stat("b");
+  stat("a");
+  expect("hit", 2, 2);
+  stat("c");
+  stat("a");
+  expect("evict least recently used", 3, 2);
+  stat("b");
+  expect("evicted entry", 4, 2);
+  if (cache->Stats().evictions != 2) {
+    throw std::runtime_error("TestStatCache(): expected 2 evictions");
+  }
+
+  // SetMaxEntries trims down to the most recently used entry.
+  cache->SetMaxEntries(1);
+  expect("trim", 4, 1);
+  stat("b");
+  stat("a");
+  expect("trimmed entries", 5, 1);
+
+  // Invalidate drops every version of the object only.
+  cache->SetMaxEntries(4);
+  stat("a", "v1");
+  stat("a", "v2");
+  stat("b");
+  expect("versions", 8, 4);
+  cache->Invalidate("bucket", "a");
+  expect("invalidate", 8, 1);
+  stat("b");
+  stat("a", "v1");
+  expect("invalidated versions", 9, 2);
+
+  // A stat whose own object is invalidated while it is in flight is not
+  // stored; one of another object is.
+  cache->Clear();
+  stat("race");
+  stat("race");
+  expect("invalidated in flight", 11, 0);
+  stat("bystander");
+  stat("bystander");
+  expect("other object invalidated in flight", 12, 1);
+
+  // An expired entry is revalidated with If-None-Match; a 304 restarts its
+  // TTL.
+  cache->Clear();
+  cache->SetTtl(std::chrono::seconds(1));
+  stat("a");
+  stat("a");
+  expect("unexpired", 13, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  stat("a");
+  stat("a");
+  expect("revalidated", 14, 1);
+  minio::s3::StatCacheStats stats = cache->Stats();
+  if (conditional != 1 || stats.revalidations != 1 ||
+      stats.not_modified != 1) {
+    throw std::runtime_error(
+        "TestStatCache(): expected 1 revalidation answered with 304; got " +
+        std::to_string(stats.revalidations) + " revalidations, " +
+        std::to_string(stats.not_modified) + " not modified");
+  }
+
+  // Without revalidation an expired entry is dropped and fetched anew.
+  cache->SetTtl(std::chrono::seconds(0));
+  cache->SetRevalidate(false);
+  stat("a");
+  expect("dropped", 15, 1);
+  if (conditional != 1) {
+    throw std::runtime_error(
+        "TestStatCache(): expected no conditional stat without revalidation");
+  }
+}
+
+std::string HexEncode(const std::string& data) {
+  static const char* kHex = "0123456789abcdef";
+  std::string out;
+  for (unsigned char c : data) {
+    out += kHex[c >> 4];
+    out += kHex[c & 0xF];
+  }
+  return out;
+}
+
+// Regression test for the per-thread signing key cache in
+// signer::GetSigningKey(): a cached key must match the AWS SigV4 reference
+// derivation, and a different date/region/service/secret must not hit it.
+void TestSigningKey() noexcept(false) {
+  std::cout << "TestSigningKey()" << std::endl;
+
+  // Reference values from the AWS SigV4 signing key derivation example.
+  const std::string secret_key = "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY";
+  const std::string expected =
+      "c4afb1cc5771d871763a393e44b703571b55cc28424d1a5e86da6ed3c154a4b9";
+  minio::utils::UtcTime date =
+      minio::utils::UtcTime::FromISO8601UTC("2015-08-30T12:36:00.000Z");
+
+  for (int i = 0; i < 2; ++i) {
+    std::string key = HexEncode(
+        minio::signer::GetSigningKey(secret_key, date, "us-east-1", "iam"));
+    if (key != expected) {
+      throw std::runtime_error("TestSigningKey(): expected " + expected +
+                               "; got " + key);
+    }
+  }
+
+  minio::utils::UtcTime next_day = date;
+  next_day.Add(24 * 60 * 60);
+  const std::array<std::string, 4> others = {
+      HexEncode(minio::signer::GetSigningKey(secret_key, next_day, "us-east-1",
+                                             "iam")),
+      HexEncode(minio::signer::GetSigningKey(secret_key, date, "us-west-2",
+                                             "iam")),
+      HexEncode(
+          minio::signer::GetSigningKey(secret_key, date, "us-east-1", "s3")),
+      HexEncode(minio::signer::GetSigningKey(secret_key + "2", date,
+                                             "us-east-1", "iam")),
+  };
+  for (const auto& key : others) {
+    if (key == expected) {
+      throw std::runtime_error("TestSigningKey(): stale cached key returned");
+    }
+  }
+}
+
+// Regression test for SigV4 header canonicalization in utils::Multimap and
+// signer::SignV4(): signs the AWS SigV4 test suite "get-vanilla" request, with
+// headers added in mixed case, and checks the reference Authorization value.
+void TestSignV4() noexcept(false) {
+  std::cout << "TestSignV4()" << std::endl;
+
+  const std::string expected =
+      "AWS4-HMAC-SHA256 "
+      "Credential=AKIDEXAMPLE/20150830/us-east-1/service/aws4_request, "
+      "SignedHeaders=host;x-amz-date, "
+      "Signature="
+      "5fa00fa31553b73ebf1942676e86291e8372ff2a2260956d9b8aae1d763fbf31";
+
+  minio::utils::Multimap headers;
+  headers.Add("X-Amz-Date", "20150830T123600Z");
+  headers.Add("Host", "example.amazonaws.com");
+  minio::signer::SignV4(
+      "service", minio::http::Method::kGet, "/", "us-east-1", headers,
+      minio::utils::Multimap(), "AKIDEXAMPLE",
+      "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY",
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+      minio::utils::UtcTime::FromISO8601UTC("2015-08-30T12:36:00.000Z"));
+
+  std::string authorization = headers.GetFront("authorization");
+  if (authorization != expected) {
+    throw std::runtime_error("TestSignV4(): expected " + expected + "; got " +
+                             authorization);
+  }
+}
+
+// Checks signer::ChunkSigner against the chained chunk signatures of the AWS
+// STREAMING-AWS4-HMAC-SHA256-PAYLOAD example: a 64 KiB chunk, a 1 KiB chunk
+// and the final empty chunk of "a" bytes.
+void TestChunkSigner() noexcept(false) {
+  std::cout << "TestChunkSigner()" << std::endl;
+
+  minio::signer::ChunkSigner signer(
+      "wJalrXUtnFEMI/K7MDENG/bPxRfiCYEXAMPLEKEY",
+      minio::utils::UtcTime::FromISO8601UTC("2013-05-24T00:00:00.000Z"),
+      "us-east-1",
+      "4f232c4386841ef735655705268965c44a0e4690baa4adea153f7db9fa80a0a9");
+  const std::array<std::pair<std::string, std::string>, 3> chunks = {{
+      {std::string(65536, 'a'),
+       "ad80c730a21e5b8d04586a2213dd63b9a0e99e0e2307b0ade35a65485a288648"},
+      {std::string(1024, 'a'),
+       "0055627c9e194cb4542bae2aa5492e3c1575bbb81b612b7d234b86a503ef5497"},
+      {"", "b6c6ea8a5354eaf15b3cb7646744f4275b71ea724fed81ceb9323e279d449df9"},
+  }};
+  for (const auto& [chunk, expected] : chunks) {
+    std::string signature = signer.Sign(chunk);
+    if (signature != expected) {
+      throw std::runtime_error("TestChunkSigner(): expected " + expected +
+                               "; got " + signature);
+    }
+  }
+}
+
+// Checks SHA-256 against the FIPS 180-2 vectors, and Sha256HashAll on an
+// executor against hashing each buffer in turn.
+void TestSha256() noexcept(false) {
+  std::cout << "TestSha256()" << std::endl;
+
+  if (minio::utils::Sha256Hash("") !=
+          "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" ||
+      minio::utils::Sha256Hash("abc") !=
+          "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad") {
+    throw std::runtime_error("TestSha256(): wrong digest");
+  }
+
+  std::vector<std::string> buffers;
+  std::mt19937_64 rng(1);
+  for (size_t i = 0; i < 37; i++) {
+    std::string buf(i * 997, '\0');
+    for (auto& c : buf) c = static_cast<char>(rng());
+    buffers.push_back(std::move(buf));
+  }
+  std::vector<std::string_view> views(buffers.begin(), buffers.end());
+  minio::utils::Executor executor(4);
+  std::vector<std::string> hashes =
+      minio::utils::Sha256HashAll(views, &executor);
+  for (size_t i = 0; i < buffers.size(); i++) {
+    if (hashes[i] != minio::utils::Sha256Hash(buffers[i])) {
+      throw std::runtime_error("TestSha256(): mismatch at buffer " +
+                               std::to_string(i));
+    }
+  }
+}
+
+// Cross-checks the dispatched and slice-by-8 CRC-64/NVME against a bit-at-a-
+// time reference over lengths and alignments around the 16 and 64 byte
+// blocks of the carry-less multiply kernels, and checks Crc64NvmeCombine.
+void TestCrc64Nvme() noexcept(false) {
+  std::cout << "TestCrc64Nvme() " << minio::utils::Crc64NvmeKernel()
+            << std::endl;
+
+  auto reference = [](const char* data, size_t len) {
+    uint64_t crc = ~0ULL;
+    for (size_t i = 0; i < len; ++i) {
+      crc ^= static_cast<unsigned char>(data[i]);
+      for (int j = 0; j < 8; ++j) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0x9a6c9329ac4bc9b5ULL : crc >> 1;
+      }
+    }
+    return ~crc;
+  };
+
+  if (minio::utils::Crc64Nvme("123456789", 9) != 0xae8b14860a799888ULL) {
+    throw std::runtime_error("TestCrc64Nvme(): wrong check value");
+  }
+
+  uint64_t parsed = 0;
+  if (!minio::utils::ParseCrc64NvmeBase64(
+          minio::utils::Crc64NvmeBase64(0xae8b14860a799888ULL), parsed) ||
+      parsed != 0xae8b14860a799888ULL ||
+      minio::utils::ParseCrc64NvmeBase64("AAAA", parsed)) {
+    throw std::runtime_error("TestCrc64Nvme(): base64 round trip failed");
+  }
+
+  std::string buf(4096 + 8, '\0');
+  std::mt19937_64 rng(1);
+  for (auto& c : buf) c = static_cast<char>(rng());
+  for (size_t offset = 0; offset < 8; offset += 3) {
+    for (size_t len = 0; len <= 4096; len += (len < 300 ? 1 : 61)) {
+      const char* data = buf.data() + offset;
+      uint64_t expected = reference(data, len);
+      size_t split = len / 3;
+      uint64_t head = minio::utils::Crc64Nvme(data, split);
+      uint64_t tail = minio::utils::Crc64Nvme(data + split, len - split);
+      if (minio::utils::Crc64Nvme(data, len) != expected ||
+          minio::utils::Crc64NvmePortable(data, len) != expected ||
+          minio::utils::Crc64Nvme(data + split, len - split, head) !=
+              expected ||
+          minio::utils::Crc64NvmeCombine(head, tail, len - split) !=
+              expected) {
+        throw std::runtime_error("TestCrc64Nvme(): mismatch at length " +
+                                 std::to_string(len) + ", offset " +
+                                 std::to_string(offset));
+      }
+    }
+  }
+}
+
+// Nested stages wait on an executor smaller than their fan-out; a worker
+// that waits has to run queued tasks or this deadlocks.
+void TestExecutor() noexcept(false) {
+  std::cout << "TestExecutor()" << std::endl;
+
+  minio::utils::Executor executor(2);
+  std::vector<std::future<size_t>> outer;
+  for (size_t i = 0; i < 8; i++) {
+    outer.push_back(executor.Submit([&executor, i]() {
+      std::vector<std::future<size_t>> inner;
+      for (size_t j = 0; j < 8; j++) {
+        inner.push_back(executor.Submit([i, j]() { return i * 8 + j; }));
+      }
+      size_t sum = 0;
+      for (auto& f : inner) sum += executor.Get(f);
+      return sum;
+    }));
+  }
+
+  size_t sum = 0;
+  for (auto& f : outer) sum += executor.Get(f);
+  if (sum != 63 * 64 / 2) {
+    throw std::runtime_error("TestExecutor(): expected sum " +
+                             std::to_string(63 * 64 / 2) + "; got " +
+                             std::to_string(sum));
+  }
+
+  minio::utils::ExecutorStats stats = executor.Stats();
+  if (stats.threads > 2 || stats.submitted != 72 || stats.queued != 0 ||
+      stats.max_queued == 0) {
+    throw std::runtime_error(
+        "TestExecutor(): unexpected stats; threads=" +
+        std::to_string(stats.threads) +
+        " submitted=" + std::to_string(stats.submitted) +
+        " queued=" + std::to_string(stats.queued));
+  }
+}
+
+#ifdef MINIO_CPP_HAS_COROUTINES
+// An operation whose call throws resumes its awaiter with the exception
+// instead of leaving it suspended.
+void TestCoroutineException() noexcept(false) {
+  std::cout << "TestCoroutineException()" << std::endl;
+
+  auto executor = std::make_shared<minio::utils::Executor>(1);
+  auto task = [](std::shared_ptr<minio::utils::Executor> executor)
+      -> minio::s3::coro::Task<Result<int>> {
+    co_return co_await minio::s3::coro::Operation<Result<int>>(
+        executor,
+        []() -> Result<int> { throw std::runtime_error("callback failed"); });
+  }(executor);
+
+  std::future<Result<int>> future = minio::s3::coro::Start(std::move(task));
+  if (future.wait_for(std::chrono::seconds(30)) != std::future_status::ready) {
+    throw std::runtime_error("TestCoroutineException(): awaiter not resumed");
+  }
+  try {
+    (void)future.get();
+  } catch (const std::runtime_error& e) {
+    if (std::string(e.what()) == "callback failed") return;
+    throw;
+  }
+  throw std::runtime_error("TestCoroutineException(): exception lost");
+}
+
+#ifdef __linux__
+// Over an EventLoopTransport a coroutine StatObject completes from the
+// response, so it needs no executor worker: the only one is busy throughout.
+void TestCoroutineEventLoop() noexcept(false) {
+  std::cout << "TestCoroutineEventLoop()" << std::endl;
+
+  LoopbackServer server(std::make_unique<httplib::Server>());
+  minio::s3::BaseUrl base_url("127.0.0.1:" + std::to_string(server.Port()),
+                              false, "us-east-1");
+  minio::s3::Client client(base_url);
+  auto executor = std::make_shared<minio::utils::Executor>(1);
+  client.SetExecutor(executor);
+  client.SetTransport(std::make_shared<minio::http::EventLoopTransport>(1));
+
+  std::promise<void> release;
+  auto busy = executor->Submit(
+      [gate = release.get_future().share()]() { gate.wait(); });
+
+  auto task = [](minio::s3::Client& client)
+      -> minio::s3::coro::Task<Result<minio::s3::StatObjectResponse>> {
+    minio::s3::StatObjectArgs args;
+    args.bucket = "bucket";
+    args.object = "object";
+    co_return co_await minio::s3::coro::StatObject(client, std::move(args));
+  }(client);
+
+  auto future = minio::s3::coro::Start(std::move(task));
+  bool ready =
+      future.wait_for(std::chrono::seconds(30)) == std::future_status::ready;
+  release.set_value();
+  busy.wait();
+  if (!ready) {
+    throw std::runtime_error("TestCoroutineEventLoop(): waited for a worker");
+  }
+  auto resp = future.get();
+  if (!resp) {
+    throw std::runtime_error("TestCoroutineEventLoop(): " +
+                             resp.error().String());
+  }
+}
+#endif  // __linux__
+#endif
+
+// Parses a page with URL-encoded keys, references, CDATA, user metadata and
+// a common prefix, where EncodingType follows the keys it applies to.
+void TestListObjectsParseXML() noexcept(false) {
+  std::cout << "TestListObjectsParseXML()" << std::endl;
+
+  std::string data =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<ListBucketResult><Name>bucket</Name><Prefix>a%2F</Prefix>"
+      "<MaxKeys>1000</MaxKeys><IsTruncated>true</IsTruncated>"
+      "<Contents><Key>a%2Fb%26c</Key>"
+      "<LastModified>2024-01-02T03:04:05.678Z</LastModified>"
+      "<ETag>&quot;d41d8cd98f00b204e9800998ecf8427e&quot;</ETag>"
+      "<Size>1234</Size><Owner><ID>id</ID><DisplayName>minio</DisplayName>"
+      "</Owner><StorageClass>STANDARD</StorageClass><UserMetadata>"
+      "<X-Amz-Meta-A>1 &lt; 2</X-Amz-Meta-A><X-Amz-Meta-B/></UserMetadata>"
+      "</Contents>"
+      "<CommonPrefixes><Prefix>a%2Fp%2F</Prefix></CommonPrefixes>"
+      "<Contents><Key><![CDATA[a/<d>]]></Key><Size>0</Size></Contents>"
+      "<EncodingType>url</EncodingType></ListBucketResult>";
+  auto resp = minio::s3::ListObjectsResponse::ParseXML(data, false);
+  if (!resp) {
+    throw std::runtime_error("TestListObjectsParseXML(): " +
+                             resp.error().String());
+  }
+
+  const auto& items = resp->contents;
+  bool ok =
+      resp->name == "bucket" && resp->prefix == "a/" && resp->is_truncated &&
+      resp->max_keys == 1000 && resp->next_marker == "a/<d>" &&
+      items.size() == 3 && items[0].name == "a/b&c" &&
+      items[0].etag == "d41d8cd98f00b204e9800998ecf8427e" &&
+      items[0].size == 1234 && items[0].owner_id == "id" &&
+      items[0].owner_name == "minio" && items[0].storage_class == "STANDARD" &&
+      items[0].last_modified == minio::utils::UtcTime::FromISO8601UTC(
+                                    "2024-01-02T03:04:05.678Z") &&
+      items[0].user_metadata.size() == 2 &&
+      items[0].user_metadata[0].first == "X-Amz-Meta-A" &&
+      items[0].user_metadata[0].second == "1 < 2" &&
+      items[0].user_metadata[1].second.empty() && items[1].name == "a/<d>" &&
+      items[2].is_prefix && items[2].name == "a/p/";
+  if (!ok) throw std::runtime_error("TestListObjectsParseXML(): wrong fields");
+
+  if (minio::s3::ListObjectsResponse::ParseXML(
+          "<ListBucketResult><Name></ListBucketResult>", false)) {
+    throw std::runtime_error(
+        "TestListObjectsParseXML(): mismatched tags accepted");
+  }
+}
+
+// Feeds a DeleteResult a few bytes at a time, splitting tags, references and
+// CDATA sections, as it arrives from the server.
+void TestRemoveObjectsDecoder() noexcept(false) {
+  std::cout << "TestRemoveObjectsDecoder()" << std::endl;
+
+  std::string data =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<DeleteResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+      "<Deleted><Key>a</Key><DeleteMarker>true</DeleteMarker>"
+      "<DeleteMarkerVersionId>v1</DeleteMarkerVersionId></Deleted>";
+  for (int i = 0; i < 100; ++i) {
+    data += "<Error><Key>k&amp;" + std::to_string(i) +
+            "</Key><Code>AccessDenied</Code>"
+            "<Message><![CDATA[Access <denied>]]></Message></Error>";
+  }
+  data += "</DeleteResult>";
+
+  minio::s3::RemoveObjectsResponse resp;
+  auto decoder = minio::s3::RemoveObjectsResponse::NewDecoder(resp);
+  for (size_t i = 0; i < data.size(); i += 5) {
+    if (!decoder->Feed(std::string_view(data).substr(i, 5))) {
+      throw std::runtime_error("TestRemoveObjectsDecoder(): feed failed");
+    }
+  }
+  if (minio::error::Error err = decoder->Finish()) {
+    throw std::runtime_error("TestRemoveObjectsDecoder(): " + err.String());
+  }
+
+  bool ok = resp.objects.size() == 1 && resp.objects.front().name == "a" &&
+            resp.objects.front().delete_marker &&
+            resp.objects.front().delete_marker_version_id == "v1" &&
+            resp.errors.size() == 100 &&
+            resp.errors.back().object_name == "k&99" &&
+            resp.errors.back().code == "AccessDenied" &&
+            resp.errors.back().message == "Access <denied>";
+  if (!ok) throw std::runtime_error("TestRemoveObjectsDecoder(): wrong fields");
+
+  minio::s3::RemoveObjectsResponse truncated;
+  decoder = minio::s3::RemoveObjectsResponse::NewDecoder(truncated);
+  decoder->Feed(std::string_view(data).substr(0, data.size() / 2));
+  if (!decoder->Finish()) {
+    throw std::runtime_error(
+        "TestRemoveObjectsDecoder(): truncated document accepted");
+  }
+}
+
 int main(int /*argc*/, char* /*argv*/[]) {
   // Unit check first so a parsing regression fails fast without a server.
   try {
     TestUrlParse();
+    TestConnectionPool();
+    TestTlsSessionResumption();
+    TestGetObjectChecksumCancel();
+#ifdef __linux__
+    TestAwsChunkedEventLoop();
+    TestEventLoopEarlyReply();
+    TestExecuteAsync();
+#endif
+    TestParallelListingError();
+    TestStatCache();
+    TestSigningKey();
+    TestSignV4();
+    TestChunkSigner();
+    TestSha256();
+    TestCrc64Nvme();
+    TestExecutor();
+#ifdef MINIO_CPP_HAS_COROUTINES
+    TestCoroutineException();
+#ifdef __linux__
+    TestCoroutineEventLoop();
+#endif
+#endif
+    TestListObjectsParseXML();
+    TestRemoveObjectsDecoder();
   } catch (const std::runtime_error& e) {
     std::cerr << e.what() << std::endl;
     return EXIT_FAILURE;
@@ -1759,6 +3287,10 @@ int main(int /*argc*/, char* /*argv*/[]) {
   tests.BucketExists();
   tests.ListBuckets();
   tests.StatObject();
+  tests.StatObjectCache();
+#ifdef MINIO_CPP_HAS_COROUTINES
+  tests.Coroutines();
+#endif
   tests.RemoveObject();
   tests.DownloadObject();
   tests.GetObject();
@@ -1767,6 +3299,8 @@ int main(int /*argc*/, char* /*argv*/[]) {
   tests.PutObject();
   tests.PutObjectWithInflight();
   tests.CopyObject();
+  tests.TransferObject();
+  tests.UploadPartStreamed();
   tests.UploadObject();
   tests.RemoveObjects();
   tests.SelectObjectContent();